@@ -0,0 +1,461 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-core-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-core-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-core-benchmark.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Microbenchmarks for the 3N core data structures. For every table size
+ *  between --minSize and --maxSize (in powers of 10) each benchmark prints
+ *  one CSV line with the operations done, the wall clock time taken, the
+ *  resulting operations per second and the heap allocations per operation.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+#include <ns3-dev/ns3/mac48-address.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/nnst/nnn-nnst.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/addr-aggr/nnn-addr-aggregator.h"
+#include "nnnSIM/model/buffers/nnn-pdu-buffer.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+// Heap allocation counters, fed by the replacement operator new below
+static uint64_t g_allocs = 0;
+static uint64_t g_allocBytes = 0;
+
+void *
+operator new (size_t size)
+{
+  g_allocs++;
+  g_allocBytes += size;
+
+  void *p = std::malloc (size ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p) throw ()
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) throw ()
+{
+  std::free (p);
+}
+
+/**
+ * @brief Measures one benchmark run and writes its result line
+ */
+class Measurement
+{
+public:
+  Measurement (std::ostream &os, const std::string &name, uint32_t size)
+  : m_os (os)
+  , m_name (name)
+  , m_size (size)
+  , m_allocs (g_allocs)
+  , m_allocBytes (g_allocBytes)
+  , m_start (std::chrono::steady_clock::now ())
+  {
+  }
+
+  void
+  Done (uint64_t ops)
+  {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - m_start;
+    uint64_t allocs = g_allocs - m_allocs;
+    uint64_t allocBytes = g_allocBytes - m_allocBytes;
+
+    double secs = elapsed.count ();
+    double perOp = (ops == 0) ? 0 : 1.0 / ops;
+
+    m_os << m_name << "," << m_size << "," << ops << "," << secs << ","
+	<< ((secs > 0) ? ops / secs : 0) << ","
+	<< allocs * perOp << "," << allocBytes * perOp << std::endl;
+  }
+
+private:
+  std::ostream &m_os;
+  std::string m_name;
+  uint32_t m_size;
+  uint64_t m_allocs;
+  uint64_t m_allocBytes;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+// Produce a 3N name for index i, spreading names over a tree of sectors
+// with a fan out of 256
+std::string
+MakeName (uint32_t i)
+{
+  std::ostringstream os;
+  os << std::hex << "1";
+  do
+    {
+      os << "." << (i & 0xff);
+      i >>= 8;
+    }
+  while (i != 0);
+
+  return os.str ();
+}
+
+std::vector<Ptr<const NNNAddress> >
+MakeAddresses (uint32_t size)
+{
+  std::vector<Ptr<const NNNAddress> > addrs;
+  addrs.reserve (size);
+
+  for (uint32_t i = 0; i < size; i++)
+    addrs.push_back (Create<const NNNAddress> (MakeName (i)));
+
+  return addrs;
+}
+
+void
+BenchAddress (std::ostream &os, uint32_t size)
+{
+  std::vector<std::string> names;
+  for (uint32_t i = 0; i < size; i++)
+    names.push_back (MakeName (i));
+
+  {
+    Measurement m (os, "address_parse", size);
+    for (uint32_t i = 0; i < size; i++)
+      NNNAddress tmp (names[i]);
+    m.Done (size);
+  }
+
+  std::vector<Ptr<const NNNAddress> > addrs = MakeAddresses (size);
+  int sink = 0;
+
+  {
+    Measurement m (os, "address_compare", size);
+    for (uint32_t i = 0; i < size; i++)
+      sink += addrs[i]->compare (*addrs[(i * 7 + 1) % size]);
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "address_distance", size);
+    for (uint32_t i = 0; i < size; i++)
+      sink += addrs[i]->distance (*addrs[(i * 7 + 1) % size]);
+    m.Done (size);
+  }
+
+  if (sink == 0x7fffffff)
+    os << "#" << sink << std::endl;
+}
+
+void
+BenchNNST (std::ostream &os, uint32_t size, Ptr<Node> node)
+{
+  std::vector<Ptr<const NNNAddress> > addrs = MakeAddresses (size);
+  Ptr<Face> face0 = Create<Face> (node);
+  Ptr<Face> face1 = Create<Face> (node);
+  Address poa = Mac48Address ("01:B2:03:04:05:06").operator ns3::Address ();
+  Time lease = Seconds (1000);
+
+  Ptr<NNST> nnst = CreateObject<NNST> ();
+
+  {
+    Measurement m (os, "nnst_add", size);
+    for (uint32_t i = 0; i < size; i++)
+      nnst->Add (addrs[i], (i % 2) ? face1 : face0, poa, lease, 5);
+    m.Done (size);
+  }
+
+  // Look for names one label under the inserted ones
+  std::vector<NNNAddress> lookups;
+  for (uint32_t i = 0; i < size; i++)
+    lookups.push_back (NNNAddress (MakeName (i) + ".f"));
+
+  {
+    Measurement m (os, "nnst_closest_sector", size);
+    for (uint32_t i = 0; i < size; i++)
+      nnst->ClosestSector (lookups[i]);
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "nnst_remove_from_all", size);
+    nnst->RemoveFromAll (face0);
+    m.Done (size);
+  }
+
+  nnst->Dispose ();
+}
+
+void
+BenchNNPT (std::ostream &os, uint32_t size)
+{
+  std::vector<Ptr<const NNNAddress> > addrs = MakeAddresses (size + 1);
+  Ptr<NNPT> nnpt = CreateObject<NNPT> ();
+
+  {
+    Measurement m (os, "nnpt_insert", size);
+    for (uint32_t i = 0; i < size; i++)
+      nnpt->addEntry (addrs[i], addrs[i + 1], Simulator::Now () + Seconds (1));
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "nnpt_lookup", size);
+    for (uint32_t i = 0; i < size; i++)
+      nnpt->findPairedName (addrs[(i * 7 + 1) % size]);
+    m.Done (size);
+  }
+
+  // All the leases run out at the same time, let the simulator expire them
+  {
+    Measurement m (os, "nnpt_expire", size);
+    Simulator::Stop (Seconds (2));
+    Simulator::Run ();
+    m.Done (size);
+  }
+
+  nnpt->Dispose ();
+}
+
+void
+BenchAggregator (std::ostream &os, uint32_t size)
+{
+  std::vector<Ptr<const NNNAddress> > addrs = MakeAddresses (size);
+  Ptr<NNNAddrAggregator> aggr = Create<NNNAddrAggregator> ();
+
+  {
+    Measurement m (os, "aggregator_add", size);
+    for (uint32_t i = 0; i < size; i++)
+      aggr->AddDestination (addrs[i]);
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "aggregator_remove", size);
+    for (uint32_t i = 0; i < size; i++)
+      aggr->RemoveDestination (addrs[i]);
+    m.Done (size);
+  }
+}
+
+void
+BenchPDUBuffer (std::ostream &os, uint32_t size)
+{
+  const uint32_t dests = 16;
+  std::vector<Ptr<const NNNAddress> > addrs = MakeAddresses (dests);
+
+  Ptr<PDUBuffer> buf = CreateObject<PDUBuffer> ();
+  buf->SetReTX (Seconds (1000));
+
+  Ptr<DO> do_p = Create<DO> ();
+  do_p->SetName (*addrs[0]);
+  do_p->SetLifetime (Seconds (20));
+  do_p->SetPayload (Create<Packet> (1024));
+  do_p->SetPDUPayloadType (NNN_NNN);
+
+  for (uint32_t i = 0; i < dests; i++)
+    buf->AddDestination (*addrs[i]);
+
+  {
+    Measurement m (os, "pdubuffer_push", size);
+    for (uint32_t i = 0; i < size; i++)
+      buf->PushDO (*addrs[i % dests], do_p);
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "pdubuffer_pop", size);
+    std::vector<Ptr<Packet> > pdus;
+    for (uint32_t i = 0; i < dests; i++)
+      buf->PopQueue (*addrs[i], pdus);
+    m.Done (pdus.size ());
+  }
+
+  buf->Dispose ();
+}
+
+/**
+ * @brief Encode the PDU without the cached wire, then decode the result
+ */
+template<class WIRE, class PDU>
+void
+BenchWire (std::ostream &os, const std::string &name, uint32_t size, Ptr<PDU> pdu)
+{
+  Ptr<Packet> packet;
+
+  {
+    Measurement m (os, "wire_encode_" + name, size);
+    for (uint32_t i = 0; i < size; i++)
+      {
+	pdu->SetWire (0);
+	packet = WIRE::ToWire (pdu);
+      }
+    m.Done (size);
+  }
+
+  {
+    Measurement m (os, "wire_decode_" + name, size);
+    for (uint32_t i = 0; i < size; i++)
+      WIRE::FromWire (packet->Copy ());
+    m.Done (size);
+  }
+}
+
+void
+BenchWireAll (std::ostream &os, uint32_t size)
+{
+  Ptr<NNNAddress> addr = Create<NNNAddress> ("ae.34.24");
+  Ptr<NNNAddress> addr2 = Create<NNNAddress> ("45.34.76");
+  Address poa = Mac48Address ("01:B2:03:04:05:06").operator ns3::Address ();
+  Address poa2 = Mac48Address ("01:02:03:04:05:06").operator ns3::Address ();
+  Ptr<Packet> payload = Create<Packet> (1024);
+  Time ttl = Seconds (20);
+  Time lease = Seconds (120);
+
+  Ptr<nnn::NULLp> nullp = Create<nnn::NULLp> ();
+  nullp->SetLifetime (ttl);
+  nullp->SetPayload (payload);
+  nullp->SetPDUPayloadType (NNN_NNN);
+  BenchWire<wire::nnnSIM::NULLp> (os, "nullp", size, nullp);
+
+  Ptr<nnn::SO> so = Create<nnn::SO> ();
+  so->SetName (addr);
+  so->SetLifetime (ttl);
+  so->SetPayload (payload);
+  so->SetPDUPayloadType (NNN_NNN);
+  BenchWire<wire::nnnSIM::SO> (os, "so", size, so);
+
+  Ptr<nnn::DO> do_p = Create<nnn::DO> ();
+  do_p->SetName (addr);
+  do_p->SetLifetime (ttl);
+  do_p->SetPayload (payload);
+  do_p->SetPDUPayloadType (NNN_NNN);
+  BenchWire<wire::nnnSIM::DO> (os, "do", size, do_p);
+
+  Ptr<nnn::DU> du = Create<nnn::DU> ();
+  du->SetLifetime (ttl);
+  du->SetPayload (payload);
+  du->SetPDUPayloadType (NNN_NNN);
+  du->SetSrcName (addr);
+  du->SetDstName (addr2);
+  BenchWire<wire::nnnSIM::DU> (os, "du", size, du);
+
+  Ptr<nnn::EN> en = Create<nnn::EN> ();
+  en->SetLifetime (ttl);
+  en->AddPoa (poa);
+  BenchWire<wire::nnnSIM::EN> (os, "en", size, en);
+
+  Ptr<nnn::AEN> aen = Create<nnn::AEN> ();
+  aen->SetName (addr);
+  aen->SetLifetime (ttl);
+  aen->SetLeasetime (lease);
+  aen->AddPoa (poa);
+  BenchWire<wire::nnnSIM::AEN> (os, "aen", size, aen);
+
+  Ptr<nnn::REN> ren = Create<nnn::REN> ();
+  ren->SetName (addr);
+  ren->SetLifetime (ttl);
+  ren->SetRemainLease (lease);
+  ren->AddPoa (poa);
+  ren->AddPoa (poa2);
+  BenchWire<wire::nnnSIM::REN> (os, "ren", size, ren);
+
+  Ptr<nnn::DEN> den = Create<nnn::DEN> ();
+  den->SetName (addr);
+  den->SetLifetime (ttl);
+  den->AddPoa (poa);
+  den->AddPoa (poa2);
+  BenchWire<wire::nnnSIM::DEN> (os, "den", size, den);
+
+  Ptr<nnn::OEN> oen = Create<nnn::OEN> ();
+  oen->SetName (addr);
+  oen->SetLifetime (ttl);
+  oen->SetLeasetime (lease);
+  oen->AddPoa (poa);
+  oen->SetSrcName (addr2);
+  oen->AddPersonalPoa (poa2);
+  BenchWire<wire::nnnSIM::OEN> (os, "oen", size, oen);
+
+  Ptr<nnn::INF> inf = Create<nnn::INF> ();
+  inf->SetLifetime (ttl);
+  inf->SetOldName (addr);
+  inf->SetNewName (addr2);
+  inf->SetRemainLease (lease);
+  BenchWire<wire::nnnSIM::INF> (os, "inf", size, inf);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minSize = 10;
+  uint32_t maxSize = 1000000;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("minSize", "Smallest table size to measure", minSize);
+  cmd.AddValue ("maxSize", "Largest table size to measure", maxSize);
+  cmd.AddValue ("output", "File to write the CSV results to (standard output if empty)", output);
+  cmd.Parse (argc, argv);
+
+  std::ofstream file;
+  if (!output.empty ())
+    file.open (output.c_str ());
+  std::ostream &os = output.empty () ? std::cout : file;
+
+  // Create a Node, required for Face
+  NodeContainer tmpNodes;
+  tmpNodes.Create (1);
+
+  os << "benchmark,size,ops,seconds,ops_per_sec,allocs_per_op,alloc_bytes_per_op" << std::endl;
+
+  for (uint64_t size = minSize; size <= maxSize; size *= 10)
+    {
+      BenchAddress (os, size);
+      BenchNNST (os, size, tmpNodes.Get (0));
+      BenchNNPT (os, size);
+      BenchAggregator (os, size);
+      BenchPDUBuffer (os, size);
+      BenchWireAll (os, size);
+    }
+
+  Simulator::Destroy ();
+
+  return 0;
+}
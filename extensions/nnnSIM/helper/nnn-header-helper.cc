@@ -25,6 +25,8 @@
 
 #include <iomanip>
 #include "nnn-header-helper.h"
+#include "../model/wire/nnn-wire.h"
+#include "../model/wire/wire-compact.h"
 
 NS_LOG_COMPONENT_DEFINE ("nnn.HeaderHelper");
 
@@ -32,24 +34,47 @@ namespace ns3
 {
   namespace nnn
   {
+    int8_t
+    HeaderHelper::GetWireFormat (Ptr<const Packet> packet)
+    {
+      uint8_t type;
+      uint32_t read = packet->CopyData (&type, 1);
+
+      if (read != 1) throw UnknownHeaderException();
+
+      if (type & wire::Compact::TypeFlag)
+	return Wire::WIRE_FORMAT_COMPACT;
+      else
+	return Wire::WIRE_FORMAT_NNNSIM;
+    }
+
     NNN_PDU_TYPE
     HeaderHelper::GetNNNHeaderType (Ptr<const Packet> packet)
     {
-      // Our header ID is of 32 bits
+      // nnnSIM header ID is of 32 bits, compact of 8 bits
       uint8_t type[4];
       uint32_t read = packet->CopyData (type, 4);
 
-      if (read != 4) throw UnknownHeaderException();
+      if (read == 0) throw UnknownHeaderException();
 
-      // Convert the bytes to a 32 bit unsigned integer
       uint32_t retval = 0;
-      retval |= type[3];
-      retval <<= 8;
-      retval |= type[2];
-      retval <<= 8;
-      retval |= type[1];
-      retval <<= 8;
-      retval |= type[0];
+      if (type[0] & wire::Compact::TypeFlag)
+	{
+	  retval = type[0] & ~wire::Compact::TypeFlag;
+	}
+      else
+	{
+	  if (read != 4) throw UnknownHeaderException();
+
+	  // Convert the bytes to a 32 bit unsigned integer
+	  retval |= type[3];
+	  retval <<= 8;
+	  retval |= type[2];
+	  retval <<= 8;
+	  retval |= type[1];
+	  retval <<= 8;
+	  retval |= type[0];
+	}
 
       NS_LOG_DEBUG (*packet);
 
@@ -47,8 +47,21 @@ namespace ns3
     class HeaderHelper
     {
     public:
+      /**
+       * @brief Get the type of the PDU in packet, in any wire format
+       */
       static NNN_PDU_TYPE
       GetNNNHeaderType (Ptr<const Packet> packet);
+
+      /**
+       * @brief Detect the wire format packet is encoded in
+       *
+       * Compact PDUs start with a type byte with Compact::TypeFlag set,
+       * which the 32 bit little endian type of nnnSIM PDUs never has.
+       * Returns one of the Wire::WIRE_FORMAT_* values
+       */
+      static int8_t
+      GetWireFormat (Ptr<const Packet> packet);
     };
 
     /**
@@ -31,11 +31,16 @@ namespace ns3
     : renewName (MakeNullCallback <void> ())
     , hasNoName (MakeNullCallback <void> ())
     , defaultRenewal (Seconds(30))
+    , m_wheelClient (0)
+    , m_expireTimer (LeaseWheel::INVALID_TIMER)
+    , m_renewTimer (LeaseWheel::INVALID_TIMER)
+    , m_version (0)
     {
     }
 
     NamesContainer::~NamesContainer ()
     {
+      CancelTimers ();
     }
 
     void
@@ -63,7 +68,7 @@ namespace ns3
       NS_LOG_FUNCTION (this << *name << lease_expire);
 
       // We assume that the lease time gives us the absolute expiry time
-      // We need to calculate the relative time for the Schedule function
+      // We need the relative time to check the lease is still valid
       Time now = Simulator::Now ();
       Time relativeExpireTime = lease_expire - now;
 
@@ -76,12 +81,9 @@ namespace ns3
 
 	  // We need to save the lease and renewal time in absolute time
 	  container.insert(NamesContainerEntry(name, lease_expire, lease_expire - defaultRenewal, fixed));
+	  m_version++;
 	  if (!fixed)
-	    {
-	      // The Schedulers are in relative time
-	      Simulator::Schedule((relativeExpireTime - defaultRenewal), &NamesContainer::willAttemptRenew, this);
-	      Simulator::Schedule(relativeExpireTime, &NamesContainer::cleanExpired, this);
-	    }
+	    ScheduleTimers ();
 	}
     }
 
@@ -90,6 +92,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
       container.erase(nameEntry);
+      m_version++;
     }
 
     void
@@ -102,6 +105,7 @@ namespace ns3
 	  NamesContainerEntry tmp = findEntry (name);
 
 	  container.erase(tmp);
+	  m_version++;
 	}
     }
 
@@ -164,8 +168,6 @@ namespace ns3
       names_set_by_name& names_index = container.get<address> ();
       names_set_by_name::iterator it = names_index.find(name);
 
-      Time absoluteLeaseTime = Simulator::Now () + lease_expire;
-      bool change = false;
 
       if (it != names_index.end())
 	{
@@ -176,13 +178,8 @@ namespace ns3
 
 	  if (names_index.replace(it, tmp))
 	    {
-	      Time relativeExpireTime = lease_expire - Simulator::Now ();
-
-	      if (relativeExpireTime.IsStrictlyPositive())
-		{
-		  // Remember the scheduler is expressed in relative time
-		  Simulator::Schedule(lease_expire, &NamesContainer::cleanExpired, this);
-		}
+	      m_version++;
+	      ScheduleTimers ();
 	    }
 	}
     }
@@ -199,6 +196,12 @@ namespace ns3
       return (container.size() == 0);
     }
 
+    uint32_t
+    NamesContainer::GetVersion () const
+    {
+      return m_version;
+    }
+
     bool
     NamesContainer::isFixed (Ptr<const NNNAddress> name)
     {
@@ -236,15 +239,15 @@ namespace ns3
 
       names_set_by_lease::iterator it = lease_index.begin();
 
-      while (! isEmpty() && it != lease_index.end ())
+      while (it != lease_index.end ())
 	{
 	  if (it->m_lease_expire <= now &&  !it->m_fixed)
 	    {
-	      deleteEntry(*it);
-	      break;
+	      it = lease_index.erase (it);
+	      m_version++;
 	    }
-
-	  ++it;
+	  else
+	    ++it;
 	}
 
       // The container is actually empty, callback
@@ -279,6 +282,147 @@ namespace ns3
 	  renewName ();
     }
 
+    void
+    NamesContainer::SetLeaseWheel (Ptr<LeaseWheel> wheel)
+    {
+      NS_LOG_FUNCTION (this << wheel);
+
+      if (m_wheel == wheel)
+	return;
+
+      CancelTimers ();
+
+      m_wheel = wheel;
+      if (m_wheel != 0)
+	{
+	  m_wheelClient = m_wheel->RegisterClient (MakeCallback (&NamesContainer::LeasesExpired, this));
+	  ScheduleTimers ();
+	}
+    }
+
+    Ptr<LeaseWheel>
+    NamesContainer::GetLeaseWheel ()
+    {
+      if (m_wheel == 0)
+	SetLeaseWheel (CreateObject<LeaseWheel> ());
+
+      return m_wheel;
+    }
+
+    void
+    NamesContainer::ScheduleTimers ()
+    {
+      NS_LOG_FUNCTION (this);
+      names_set_by_lease& lease_index = container.get<lease> ();
+      Time now = Simulator::Now ();
+
+      Time expire;
+      Time renew;
+      bool foundExpire = false;
+      bool foundRenew = false;
+
+      // The lease index goes from the newest to the oldest lease, and the
+      // renewal time follows the lease, so walk it backwards
+      names_set_by_lease::reverse_iterator it = lease_index.rbegin ();
+      for (; it != lease_index.rend () && !foundRenew; ++it)
+	{
+	  if (it->m_fixed)
+	    continue;
+
+	  if (!foundExpire)
+	    {
+	      expire = it->m_lease_expire;
+	      foundExpire = true;
+	    }
+
+	  if (it->m_renew_time > now)
+	    {
+	      renew = it->m_renew_time;
+	      foundRenew = true;
+	    }
+	}
+
+      // A stale expiry timer is harmless, it only runs cleanExpired, so
+      // it is moved but never cancelled here
+      if (foundExpire)
+	ScheduleTimer (m_expireTimer, expire, EXPIRE_TIMER);
+
+      if (foundRenew)
+	ScheduleTimer (m_renewTimer, renew, RENEW_TIMER);
+      else if (m_wheel != 0)
+	{
+	  m_wheel->Cancel (m_renewTimer);
+	  m_renewTimer = LeaseWheel::INVALID_TIMER;
+	}
+    }
+
+    void
+    NamesContainer::ScheduleTimer (LeaseWheel::TimerId &timer, Time when, uint64_t cookie)
+    {
+      Ptr<LeaseWheel> wheel = GetLeaseWheel ();
+
+      if (wheel->IsPending (timer))
+	wheel->Reschedule (timer, when);
+      else
+	timer = wheel->Schedule (m_wheelClient, when, cookie);
+    }
+
+    void
+    NamesContainer::CancelTimers ()
+    {
+      if (m_wheel != 0)
+	{
+	  m_wheel->Cancel (m_expireTimer);
+	  m_wheel->Cancel (m_renewTimer);
+	}
+
+      m_expireTimer = LeaseWheel::INVALID_TIMER;
+      m_renewTimer = LeaseWheel::INVALID_TIMER;
+    }
+
+    void
+    NamesContainer::LeasesExpired (const std::vector<uint64_t> &cookies)
+    {
+      NS_LOG_FUNCTION (this << cookies.size ());
+
+      bool expired = false;
+      bool renew = false;
+
+      for (std::vector<uint64_t>::const_iterator i = cookies.begin (); i != cookies.end (); ++i)
+	{
+	  if (*i == EXPIRE_TIMER)
+	    {
+	      m_expireTimer = LeaseWheel::INVALID_TIMER;
+	      expired = true;
+	    }
+	  else
+	    {
+	      m_renewTimer = LeaseWheel::INVALID_TIMER;
+	      renew = true;
+	    }
+	}
+
+      if (renew)
+	willAttemptRenew ();
+
+      if (expired)
+	cleanExpired ();
+
+      ScheduleTimers ();
+    }
+
+    void
+    NamesContainer::DoDispose ()
+    {
+      CancelTimers ();
+      m_wheel = 0;
+
+      renewName = MakeNullCallback <void> ();
+      hasNoName = MakeNullCallback <void> ();
+
+      Object::DoDispose ();
+    }
+
     void
     NamesContainer::Print (std::ostream &os) const
     {
@@ -35,6 +35,7 @@
 
 #include "nnn-names-container-entry.h"
 #include "../model/nnn-naming.h"
+#include "../utils/nnn-lease-wheel.h"
 
 using boost::multi_index_container;
 using namespace ::boost::multi_index;
@@ -116,6 +117,15 @@ namespace ns3
       bool
       isEmpty ();
 
+      /**
+       * @brief Counter increased every time a 3N name is added, removed or
+       * has its lease changed
+       *
+       * Lets users cache the result of findNewestName until it changes
+       */
+      uint32_t
+      GetVersion () const;
+
       bool
       isFixed (Ptr<const NNNAddress> name);
 
@@ -143,12 +153,55 @@ namespace ns3
       void
       printByLease ();
 
+      /**
+       * @brief Set the wheel used for the lease expiry and renewal timers
+       *
+       * If never called, a private LeaseWheel is created on first use
+       */
+      void
+      SetLeaseWheel (Ptr<LeaseWheel> wheel);
+
+    protected:
+      virtual void
+      DoDispose ();
+
     private:
+      Ptr<LeaseWheel>
+      GetLeaseWheel ();
+
+      /**
+       * @brief Move the expiry timer to the earliest lease and the renewal
+       * timer to the next renewal time of the non fixed names
+       */
+      void
+      ScheduleTimers ();
+
+      void
+      ScheduleTimer (LeaseWheel::TimerId &timer, Time when, uint64_t cookie);
+
+      void
+      CancelTimers ();
+
+      void
+      LeasesExpired (const std::vector<uint64_t> &cookies);
+
+      enum TimerCookie
+      {
+	EXPIRE_TIMER = 0,
+	RENEW_TIMER = 1
+      };
+
       names_set container;         ///< \brief Internal structure holding the 3N names
       Time defaultRenewal;         ///< \brief Default negative default time to fire renewal callback
 
       Callback<void> renewName;    ///< \brief Renewal callback
       Callback<void> hasNoName;    ///< \brief Enroll callback - done when container is empty
+
+      Ptr<LeaseWheel> m_wheel;           ///< \brief Wheel holding the expiry and renewal timers
+      uint32_t m_wheelClient;
+      LeaseWheel::TimerId m_expireTimer;  ///< \brief Timer for the earliest lease
+      LeaseWheel::TimerId m_renewTimer;   ///< \brief Timer for the next renewal
+      uint32_t m_version;                 ///< \brief Modification counter, see GetVersion
     };
 
     std::ostream& operator<< (std::ostream& os, const NamesContainer &names);
@@ -0,0 +1,470 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-partition-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-partition-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-partition-helper.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-partition-helper.h"
+#include "nnn-point2point-helper.h"
+
+#include <ns3-dev/ns3/abort.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/mpi-interface.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_LOG_COMPONENT_DEFINE ("nnn.PartitionHelper");
+
+    // Refinement passes over all the clusters, it usually settles in 2 or 3
+    static const uint32_t g_maxPasses = 10;
+
+    typedef std::vector<std::vector<std::pair<uint32_t, double> > > Adjacency;
+
+    // Appends to order the clusters reachable from start, breadth first
+    static uint32_t
+    BreadthFirst (uint32_t start, const Adjacency &adj, std::vector<bool> &visited,
+                  std::vector<uint32_t> &order)
+    {
+      std::deque<uint32_t> queue;
+      queue.push_back (start);
+      visited[start] = true;
+
+      uint32_t last = start;
+      while (!queue.empty ())
+	{
+	  uint32_t c = queue.front ();
+	  queue.pop_front ();
+	  order.push_back (c);
+	  last = c;
+
+	  for (uint32_t i = 0; i < adj[c].size (); i++)
+	    {
+	      uint32_t n = adj[c][i].first;
+	      if (!visited[n])
+		{
+		  visited[n] = true;
+		  queue.push_back (n);
+		}
+	    }
+	}
+      return last;
+    }
+
+    PartitionHelper::PartitionHelper ()
+    : m_imbalance (0.05)
+    , m_ranks (0)
+    {
+    }
+
+    uint32_t
+    PartitionHelper::AddNode (double weight)
+    {
+      return AddNodes (1, weight);
+    }
+
+    uint32_t
+    PartitionHelper::AddNodes (uint32_t n, double weight)
+    {
+      NS_ABORT_MSG_IF (weight <= 0, "Node weights must be positive");
+
+      uint32_t first = m_weights.size ();
+      for (uint32_t i = 0; i < n; i++)
+	{
+	  m_weights.push_back (weight);
+	  m_parent.push_back (first + i);
+	}
+      return first;
+    }
+
+    void
+    PartitionHelper::AddLink (uint32_t a, uint32_t b, Time delay)
+    {
+      NS_ABORT_MSG_IF (a >= m_weights.size () || b >= m_weights.size (),
+                       "Link between unknown nodes " << a << " and " << b);
+
+      Link link;
+      link.a = a;
+      link.b = b;
+      link.delay = delay;
+      m_links.push_back (link);
+
+      // Nothing can be sent across ranks without lookahead
+      if (delay.IsZero ())
+	Union (a, b);
+    }
+
+    void
+    PartitionHelper::Group (uint32_t a, uint32_t b)
+    {
+      NS_ABORT_MSG_IF (a >= m_weights.size () || b >= m_weights.size (),
+                       "Group of unknown nodes " << a << " and " << b);
+      Union (a, b);
+    }
+
+    void
+    PartitionHelper::Group (const std::vector<uint32_t> &nodes)
+    {
+      for (uint32_t i = 1; i < nodes.size (); i++)
+	Group (nodes[0], nodes[i]);
+    }
+
+    void
+    PartitionHelper::SetImbalance (double imbalance)
+    {
+      m_imbalance = std::max (imbalance, 0.0);
+    }
+
+    uint32_t
+    PartitionHelper::Find (uint32_t node) const
+    {
+      uint32_t root = node;
+      while (m_parent[root] != root)
+	root = m_parent[root];
+
+      while (m_parent[node] != root)
+	{
+	  uint32_t next = m_parent[node];
+	  m_parent[node] = root;
+	  node = next;
+	}
+      return root;
+    }
+
+    void
+    PartitionHelper::Union (uint32_t a, uint32_t b)
+    {
+      uint32_t ra = Find (a);
+      uint32_t rb = Find (b);
+      // Lowest index as root, so the clusters do not depend on the call order
+      if (ra < rb)
+	m_parent[rb] = ra;
+      else if (rb < ra)
+	m_parent[ra] = rb;
+    }
+
+    uint32_t
+    PartitionHelper::BuildClusters (std::vector<uint32_t> &cluster, std::vector<double> &weight,
+                                    Adjacency &adj) const
+    {
+      uint32_t nNodes = m_weights.size ();
+      std::vector<uint32_t> index (nNodes, nNodes);
+
+      cluster.assign (nNodes, 0);
+      weight.clear ();
+      for (uint32_t i = 0; i < nNodes; i++)
+	{
+	  uint32_t root = Find (i);
+	  if (index[root] == nNodes)
+	    {
+	      index[root] = weight.size ();
+	      weight.push_back (0);
+	    }
+	  cluster[i] = index[root];
+	  weight[cluster[i]] += m_weights[i];
+	}
+
+      uint32_t nClusters = weight.size ();
+      std::vector<std::map<uint32_t, double> > edges (nClusters);
+      for (uint32_t i = 0; i < m_links.size (); i++)
+	{
+	  uint32_t ca = cluster[m_links[i].a];
+	  uint32_t cb = cluster[m_links[i].b];
+	  if (ca == cb)
+	    continue;
+
+	  double cost = 1.0 / m_links[i].delay.GetSeconds ();
+	  edges[ca][cb] += cost;
+	  edges[cb][ca] += cost;
+	}
+
+      adj.assign (nClusters, std::vector<std::pair<uint32_t, double> > ());
+      for (uint32_t c = 0; c < nClusters; c++)
+	adj[c].assign (edges[c].begin (), edges[c].end ());
+
+      return nClusters;
+    }
+
+    void
+    PartitionHelper::SeedPartition (uint32_t ranks, const std::vector<double> &weight,
+                                    const Adjacency &adj, std::vector<uint32_t> &part) const
+    {
+      uint32_t nClusters = weight.size ();
+
+      // Start from a pseudo peripheral cluster, the last reached by two
+      // breadth first searches, so the ranks grow across the topology
+      std::vector<bool> visited (nClusters, false);
+      std::vector<uint32_t> order;
+      uint32_t start = BreadthFirst (0, adj, visited, order);
+
+      visited.assign (nClusters, false);
+      order.clear ();
+      start = BreadthFirst (start, adj, visited, order);
+
+      visited.assign (nClusters, false);
+      order.clear ();
+      BreadthFirst (start, adj, visited, order);
+      for (uint32_t c = 0; c < nClusters; c++)
+	{
+	  if (!visited[c])
+	    BreadthFirst (c, adj, visited, order);
+	}
+
+      double total = 0;
+      for (uint32_t c = 0; c < nClusters; c++)
+	total += weight[c];
+      double target = total / ranks;
+
+      // Fill the ranks in order, a cluster goes to the rank its middle falls in
+      part.assign (nClusters, 0);
+      double filled = 0;
+      for (uint32_t i = 0; i < order.size (); i++)
+	{
+	  uint32_t c = order[i];
+	  uint32_t rank = static_cast<uint32_t> ((filled + weight[c] / 2) / target);
+	  part[c] = std::min (rank, ranks - 1);
+	  filled += weight[c];
+	}
+    }
+
+    void
+    PartitionHelper::RefinePartition (uint32_t ranks, double maxLoad, const std::vector<double> &weight,
+                                      const Adjacency &adj, std::vector<uint32_t> &part) const
+    {
+      uint32_t nClusters = weight.size ();
+
+      std::vector<double> load (ranks, 0);
+      double total = 0;
+      for (uint32_t c = 0; c < nClusters; c++)
+	{
+	  load[part[c]] += weight[c];
+	  total += weight[c];
+	}
+      double minLoad = 2 * total / ranks - maxLoad;
+
+      std::vector<double> conn (ranks, 0);
+      std::vector<uint32_t> touched;
+
+      // Greedy boundary moves: a cluster moves to the neighbouring rank it is
+      // most connected to when that lowers the cut and keeps the balance
+      for (uint32_t pass = 0; pass < g_maxPasses; pass++)
+	{
+	  uint32_t moves = 0;
+	  for (uint32_t c = 0; c < nClusters; c++)
+	    {
+	      uint32_t from = part[c];
+
+	      touched.clear ();
+	      for (uint32_t i = 0; i < adj[c].size (); i++)
+		{
+		  uint32_t p = part[adj[c][i].first];
+		  if (conn[p] == 0)
+		    touched.push_back (p);
+		  conn[p] += adj[c][i].second;
+		}
+
+	      uint32_t best = from;
+	      double bestGain = 0;
+	      if (load[from] - weight[c] >= minLoad)
+		{
+		  for (uint32_t i = 0; i < touched.size (); i++)
+		    {
+		      uint32_t p = touched[i];
+		      double gain = conn[p] - conn[from];
+		      if (p != from && gain > bestGain && load[p] + weight[c] <= maxLoad)
+			{
+			  best = p;
+			  bestGain = gain;
+			}
+		    }
+		}
+
+	      for (uint32_t i = 0; i < touched.size (); i++)
+		conn[touched[i]] = 0;
+
+	      if (best != from)
+		{
+		  load[from] -= weight[c];
+		  load[best] += weight[c];
+		  part[c] = best;
+		  moves++;
+		}
+	    }
+
+	  NS_LOG_DEBUG ("Refinement pass " << pass << " moved " << moves << " clusters");
+	  if (moves == 0)
+	    break;
+	}
+    }
+
+    void
+    PartitionHelper::Partition ()
+    {
+      Partition (MpiInterface::IsEnabled () ? MpiInterface::GetSize () : 1);
+    }
+
+    void
+    PartitionHelper::Partition (uint32_t ranks)
+    {
+      NS_ABORT_MSG_IF (ranks == 0, "Can not partition across 0 ranks");
+
+      m_ranks = ranks;
+      m_systemId.assign (m_weights.size (), 0);
+      if (ranks == 1 || m_weights.empty ())
+	return;
+
+      std::vector<uint32_t> cluster;
+      std::vector<double> weight;
+      Adjacency adj;
+      uint32_t nClusters = BuildClusters (cluster, weight, adj);
+
+      double total = 0;
+      double heaviest = 0;
+      for (uint32_t c = 0; c < nClusters; c++)
+	{
+	  total += weight[c];
+	  heaviest = std::max (heaviest, weight[c]);
+	}
+      double target = total / ranks;
+
+      // Clusters can not be split, so allow a rank to be off by the heaviest
+      double slack = std::max (target * m_imbalance, heaviest);
+
+      std::vector<uint32_t> part;
+      SeedPartition (ranks, weight, adj, part);
+      RefinePartition (ranks, target + slack, weight, adj, part);
+
+      for (uint32_t i = 0; i < m_weights.size (); i++)
+	m_systemId[i] = part[cluster[i]];
+
+      NS_LOG_INFO ("Partitioned " << m_weights.size () << " nodes in " << nClusters
+                   << " clusters across " << ranks << " ranks, " << GetNCutLinks ()
+                   << " links cut, lookahead " << GetLookahead ());
+    }
+
+    uint32_t
+    PartitionHelper::GetNNodes () const
+    {
+      return m_weights.size ();
+    }
+
+    uint32_t
+    PartitionHelper::GetNLinks () const
+    {
+      return m_links.size ();
+    }
+
+    uint32_t
+    PartitionHelper::GetSystemId (uint32_t node) const
+    {
+      NS_ABORT_MSG_IF (node >= m_systemId.size (), "Node " << node << " has not been partitioned");
+      return m_systemId[node];
+    }
+
+    double
+    PartitionHelper::GetLoad (uint32_t rank) const
+    {
+      double load = 0;
+      for (uint32_t i = 0; i < m_systemId.size (); i++)
+	{
+	  if (m_systemId[i] == rank)
+	    load += m_weights[i];
+	}
+      return load;
+    }
+
+    uint32_t
+    PartitionHelper::GetNCutLinks () const
+    {
+      uint32_t cut = 0;
+      for (uint32_t i = 0; i < m_links.size (); i++)
+	{
+	  if (GetSystemId (m_links[i].a) != GetSystemId (m_links[i].b))
+	    cut++;
+	}
+      return cut;
+    }
+
+    Time
+    PartitionHelper::GetLookahead () const
+    {
+      Time lookahead;
+      bool found = false;
+      for (uint32_t i = 0; i < m_links.size (); i++)
+	{
+	  if (GetSystemId (m_links[i].a) == GetSystemId (m_links[i].b))
+	    continue;
+
+	  if (!found || m_links[i].delay < lookahead)
+	    lookahead = m_links[i].delay;
+	  found = true;
+	}
+      return lookahead;
+    }
+
+    NodeContainer
+    PartitionHelper::Create () const
+    {
+      NS_ABORT_MSG_IF (m_systemId.size () != m_weights.size (),
+                       "Partition must be called before creating the nodes");
+
+      NodeContainer nodes;
+      for (uint32_t i = 0; i < m_systemId.size (); i++)
+	nodes.Create (1, m_systemId[i]);
+
+      return nodes;
+    }
+
+    NetDeviceContainer
+    PartitionHelper::InstallLinks (FlexPointToPointHelper &p2p, const NodeContainer &nodes) const
+    {
+      NS_ABORT_MSG_IF (nodes.GetN () != m_weights.size (),
+                       "Links must be installed on the nodes returned by Create");
+
+      NetDeviceContainer devices;
+      for (uint32_t i = 0; i < m_links.size (); i++)
+	{
+	  p2p.SetChannelAttribute ("Delay", TimeValue (m_links[i].delay));
+	  devices.Add (p2p.Install (nodes.Get (m_links[i].a), nodes.Get (m_links[i].b)));
+	}
+      return devices;
+    }
+
+    void
+    PartitionHelper::Print (std::ostream &os) const
+    {
+      os << "Nodes: " << GetNNodes () << " Links: " << GetNLinks () << " Ranks: " << m_ranks << std::endl;
+      for (uint32_t r = 0; r < m_ranks; r++)
+	{
+	  uint32_t n = std::count (m_systemId.begin (), m_systemId.end (), r);
+	  os << "Rank " << r << ": " << n << " nodes, load " << GetLoad (r) << std::endl;
+	}
+      os << "Cut links: " << GetNCutLinks () << " Lookahead: " << GetLookahead ().GetSeconds () << "s" << std::endl;
+    }
+
+    std::ostream&
+    operator << (std::ostream &os, const PartitionHelper &partition)
+    {
+      partition.Print (os);
+      return os;
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-partition-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-partition-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-partition-helper.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_PARTITION_HELPER_H_
+#define NNN_PARTITION_HELPER_H_
+
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/net-device-container.h>
+#include <ns3-dev/ns3/node-container.h>
+
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    class FlexPointToPointHelper;
+
+    /**
+     * @brief Splits a topology across the ranks of a distributed (MPI) run
+     *
+     * ns-3 fixes the system id of a node when the node is created, so the
+     * topology is described to the helper first, partitioned, and only then
+     * created, once MPI runs with the distributed simulator:
+     *
+     *     GlobalValue::Bind ("SimulatorImplementationType",
+     *                        StringValue ("ns3::DistributedSimulatorImpl"));
+     *     MpiInterface::Enable (&argc, &argv);
+     *
+     *     nnn::PartitionHelper partition;
+     *     uint32_t first = partition.AddNodes (100);
+     *     partition.AddLink (first, first + 1, MilliSeconds (5));
+     *     ...
+     *     partition.Group (ap, mobiles);   // Wi-Fi sector stays on one rank
+     *     partition.Partition ();
+     *
+     *     NodeContainer nodes = partition.Create ();
+     *     nnn::FlexPointToPointHelper p2p;
+     *     partition.InstallLinks (p2p, nodes);
+     *
+     * The partition keeps the load of every rank within the allowed
+     * imbalance while minimizing the links cut between ranks, weighted by
+     * the inverse of their delay: a cut link with a short delay shrinks the
+     * lookahead of the conservative synchronization and costs more than one
+     * with a long delay. Links without delay can not be cut and are always
+     * kept on one rank, as are the nodes of a Group. Nodes sharing a
+     * WifiChannel must be grouped, as wireless channels are rank local.
+     *
+     * The result only depends on the nodes, links and groups added, so all
+     * the ranks of a run compute the same partition independently.
+     */
+    class PartitionHelper
+    {
+    public:
+      PartitionHelper ();
+
+      /**
+       * @brief Add a node to the topology
+       * @param weight relative amount of work expected from the node
+       * @return index of the node, which is also its index in Create
+       */
+      uint32_t
+      AddNode (double weight = 1.0);
+
+      /**
+       * @brief Add n nodes to the topology
+       * @return index of the first node added
+       */
+      uint32_t
+      AddNodes (uint32_t n, double weight = 1.0);
+
+      /**
+       * @brief Add a point to point link between nodes a and b
+       */
+      void
+      AddLink (uint32_t a, uint32_t b, Time delay);
+
+      /**
+       * @brief Keep nodes a and b on the same rank
+       */
+      void
+      Group (uint32_t a, uint32_t b);
+
+      /**
+       * @brief Keep all the nodes on the same rank
+       */
+      void
+      Group (const std::vector<uint32_t> &nodes);
+
+      /**
+       * @brief Allowed load of a rank above the average, 0.05 for 5%
+       */
+      void
+      SetImbalance (double imbalance);
+
+      /**
+       * @brief Partition the topology for the ranks of the current run,
+       * a single one if MPI is not enabled
+       */
+      void
+      Partition ();
+
+      /**
+       * @brief Partition the topology across ranks
+       */
+      void
+      Partition (uint32_t ranks);
+
+      uint32_t
+      GetNNodes () const;
+
+      uint32_t
+      GetNLinks () const;
+
+      /**
+       * @brief Rank assigned to the node by the last Partition
+       */
+      uint32_t
+      GetSystemId (uint32_t node) const;
+
+      /**
+       * @brief Sum of the weights of the nodes assigned to rank
+       */
+      double
+      GetLoad (uint32_t rank) const;
+
+      /**
+       * @brief Number of links between nodes on different ranks
+       */
+      uint32_t
+      GetNCutLinks () const;
+
+      /**
+       * @brief Smallest delay of a cut link, zero if no link is cut
+       */
+      Time
+      GetLookahead () const;
+
+      /**
+       * @brief Create the nodes, each with the system id it was assigned
+       */
+      NodeContainer
+      Create () const;
+
+      /**
+       * @brief Install the links added on nodes, as returned by Create
+       *
+       * The channel Delay attribute of p2p is set to the delay of each link
+       * before installing it. FlexPointToPointHelper uses remote channels
+       * for the cut links on its own.
+       *
+       * @return devices of the links in the order they were added, two per link
+       */
+      NetDeviceContainer
+      InstallLinks (FlexPointToPointHelper &p2p, const NodeContainer &nodes) const;
+
+      /**
+       * @brief Print the load of each rank and the cut statistics
+       */
+      void
+      Print (std::ostream &os) const;
+
+    private:
+      struct Link
+      {
+	uint32_t a;
+	uint32_t b;
+	Time delay;
+      };
+
+      uint32_t
+      Find (uint32_t node) const;
+
+      void
+      Union (uint32_t a, uint32_t b);
+
+      uint32_t
+      BuildClusters (std::vector<uint32_t> &cluster, std::vector<double> &weight,
+                     std::vector<std::vector<std::pair<uint32_t, double> > > &adj) const;
+
+      void
+      SeedPartition (uint32_t ranks, const std::vector<double> &weight,
+                     const std::vector<std::vector<std::pair<uint32_t, double> > > &adj,
+                     std::vector<uint32_t> &part) const;
+
+      void
+      RefinePartition (uint32_t ranks, double maxLoad, const std::vector<double> &weight,
+                       const std::vector<std::vector<std::pair<uint32_t, double> > > &adj,
+                       std::vector<uint32_t> &part) const;
+
+    private:
+      std::vector<double> m_weights;
+      std::vector<Link> m_links;
+      mutable std::vector<uint32_t> m_parent;   ///< @brief Union-find of the nodes kept together
+      double m_imbalance;
+
+      uint32_t m_ranks;
+      std::vector<uint32_t> m_systemId;
+    };
+
+    std::ostream&
+    operator << (std::ostream &os, const PartitionHelper &partition);
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_PARTITION_HELPER_H_ */
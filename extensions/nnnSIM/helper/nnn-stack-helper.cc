@@ -56,6 +56,7 @@
 #include "../model/fib/nnn-fib.h"
 #include "../model/pit/nnn-pit.h"
 
+#include "../utils/nnn-lease-wheel.h"
 #include "../utils/nnn-limits.h"
 
 #include "../model/fw/nnn-forwarding-strategy.h"
@@ -270,6 +271,10 @@ namespace ns3
       // Create and aggregate FIB
       nnn->AggregateObject (m_fibFactory.Create<Fib> ());
 
+      // Create and aggregate the lease wheel shared by NNPT, NNST and the
+      // forwarding strategy
+      nnn->AggregateObject (CreateObject<LeaseWheel> ());
+
       // Create and aggregate NNPT
       nnn->AggregateObject (m_nnptFactory.Create<NNPT> ());
 
@@ -0,0 +1,676 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-wifi-association-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-wifi-association-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-wifi-association-helper.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ns3-dev/ns3/assert.h>
+#include <ns3-dev/ns3/double.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/string.h>
+#include <ns3-dev/ns3/trace-source-accessor.h>
+#include <ns3-dev/ns3/wifi-net-device.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#include "nnn-wifi-association-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.WifiAssociationHelper");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (WifiAssociationHelper);
+
+    namespace
+    {
+      // $ns_ at command of an ns-2 movement trace
+      struct Ns2Command
+      {
+	double time;
+	char attr;            // X, Y or Z for a set, 'd' for a setdest
+	Vector dest;
+	double speed;
+      };
+
+      bool
+      Ns2CommandEarlier (const Ns2Command &a, const Ns2Command &b)
+      {
+	return a.time < b.time;
+      }
+    }
+
+    TypeId
+    WifiAssociationHelper::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::WifiAssociationHelper")
+	.SetGroupName ("Nnn")
+	.SetParent<Object> ()
+	.AddConstructor<WifiAssociationHelper> ()
+	.AddAttribute ("Hysteresis", "Distance in meters a new AP has to be closer than the current one before switching",
+	               StringValue ("0"),
+	               MakeDoubleAccessor (&WifiAssociationHelper::m_hysteresis),
+	               MakeDoubleChecker<double> (0.0))
+	.AddAttribute ("MinCheckInterval", "Shortest time between two checks of the same station",
+	               StringValue ("10ms"),
+	               MakeTimeAccessor (&WifiAssociationHelper::m_minCheck),
+	               MakeTimeChecker ())
+	.AddAttribute ("MaxCheckInterval", "Longest time between two checks of the same station",
+	               StringValue ("1s"),
+	               MakeTimeAccessor (&WifiAssociationHelper::m_maxCheck),
+	               MakeTimeChecker ())
+	.AddAttribute ("CellSize", "Side in meters of the AP grid cells, 0 to size them from the AP density",
+	               StringValue ("0"),
+	               MakeDoubleAccessor (&WifiAssociationHelper::m_cellSize),
+	               MakeDoubleChecker<double> (0.0))
+	.AddTraceSource ("Association", "Association", MakeTraceSourceAccessor (&WifiAssociationHelper::m_association))
+	;
+      return tid;
+    }
+
+    WifiAssociationHelper::WifiAssociationHelper ()
+    : m_cellSize (0)
+    , m_minX (0)
+    , m_minY (0)
+    , m_cellsX (0)
+    , m_cellsY (0)
+    , m_hysteresis (0)
+    , m_started (false)
+    {
+    }
+
+    WifiAssociationHelper::~WifiAssociationHelper ()
+    {
+    }
+
+    void
+    WifiAssociationHelper::DoDispose ()
+    {
+      for (std::vector<Station>::iterator it = m_stations.begin (); it != m_stations.end (); ++it)
+	{
+	  Simulator::Cancel (it->check);
+	}
+
+      for (std::vector<EventId>::iterator it = m_handoffs.begin (); it != m_handoffs.end (); ++it)
+	{
+	  Simulator::Cancel (*it);
+	}
+
+      m_handoffs.clear ();
+      m_stations.clear ();
+      m_aps.clear ();
+      m_cells.clear ();
+      m_byMobility.clear ();
+
+      Object::DoDispose ();
+    }
+
+    void
+    WifiAssociationHelper::AddAp (Ptr<NetDevice> device)
+    {
+      Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice> (device);
+      NS_ASSERT_MSG (wifi != 0, "AP device is not a WifiNetDevice");
+
+      AddAp (wifi->GetMac ()->GetSsid (), device->GetNode ()->GetObject<MobilityModel> ());
+    }
+
+    void
+    WifiAssociationHelper::AddAp (const Ssid &ssid, Ptr<MobilityModel> mobility)
+    {
+      NS_LOG_FUNCTION (this << ssid);
+      NS_ASSERT_MSG (mobility != 0, "AP has no MobilityModel");
+      NS_ASSERT_MSG (!m_started, "APs have to be added before Start");
+
+      Ap ap;
+      ap.ssid = ssid;
+      ap.mobility = mobility;
+      m_aps.push_back (ap);
+    }
+
+    void
+    WifiAssociationHelper::AddAps (const NetDeviceContainer &devices)
+    {
+      for (NetDeviceContainer::Iterator it = devices.Begin (); it != devices.End (); ++it)
+	{
+	  AddAp (*it);
+	}
+    }
+
+    void
+    WifiAssociationHelper::AddStation (Ptr<NetDevice> device)
+    {
+      NS_LOG_FUNCTION (this << device);
+
+      Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice> (device);
+      NS_ASSERT_MSG (wifi != 0, "Station device is not a WifiNetDevice");
+
+      Station st;
+      st.node = device->GetNode ();
+      st.mobility = st.node->GetObject<MobilityModel> ();
+      st.mac = wifi->GetMac ();
+      st.ap = -1;
+      st.traced = false;
+
+      NS_ASSERT_MSG (st.mobility != 0, "Station has no MobilityModel");
+
+      m_byMobility[PeekPointer (st.mobility)] = m_stations.size ();
+      m_stations.push_back (st);
+
+      st.mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&WifiAssociationHelper::CourseChanged, this));
+
+      if (m_started)
+	{
+	  uint32_t i = m_stations.size () - 1;
+	  m_stations[i].check = Simulator::ScheduleNow (&WifiAssociationHelper::Check, this, i);
+	}
+    }
+
+    void
+    WifiAssociationHelper::AddStations (const NetDeviceContainer &devices)
+    {
+      for (NetDeviceContainer::Iterator it = devices.Begin (); it != devices.End (); ++it)
+	{
+	  AddStation (*it);
+	}
+    }
+
+    void
+    WifiAssociationHelper::Start (Time start)
+    {
+      NS_LOG_FUNCTION (this << start);
+
+      BuildIndex ();
+      m_started = true;
+
+      for (uint32_t i = 0; i < m_stations.size (); i++)
+	{
+	  Simulator::Cancel (m_stations[i].check);
+	  if (!m_stations[i].traced)
+	    m_stations[i].check = Simulator::Schedule (start, &WifiAssociationHelper::Check, this, i);
+	}
+    }
+
+    void
+    WifiAssociationHelper::StartFromNs2Trace (const std::string &file, Time start, Time stop)
+    {
+      NS_LOG_FUNCTION (this << file << start << stop);
+
+      Trajectories trajectories;
+      ReadNs2Trace (file, trajectories);
+
+      for (std::vector<Station>::iterator it = m_stations.begin (); it != m_stations.end (); ++it)
+	{
+	  it->traced = (trajectories.find (it->node->GetId ()) != trajectories.end ());
+	}
+
+      Start (start);
+
+      for (uint32_t i = 0; i < m_stations.size (); i++)
+	{
+	  if (m_stations[i].traced)
+	    ScheduleHandoffs (i, trajectories[m_stations[i].node->GetId ()], start.GetSeconds (), stop.GetSeconds ());
+	}
+
+      NS_LOG_INFO ("Scheduled " << m_handoffs.size () << " associations from " << file);
+    }
+
+    Ssid
+    WifiAssociationHelper::GetSsid (Ptr<Node> node) const
+    {
+      for (std::vector<Station>::const_iterator it = m_stations.begin (); it != m_stations.end (); ++it)
+	{
+	  if (it->node == node && it->ap >= 0)
+	    return m_aps[it->ap].ssid;
+	}
+      return Ssid ();
+    }
+
+    void
+    WifiAssociationHelper::BuildIndex ()
+    {
+      m_cells.clear ();
+      if (m_aps.empty ())
+	{
+	  m_cellsX = m_cellsY = 0;
+	  return;
+	}
+
+      double maxX, maxY;
+      m_minX = maxX = m_aps[0].mobility->GetPosition ().x;
+      m_minY = maxY = m_aps[0].mobility->GetPosition ().y;
+
+      for (std::vector<Ap>::iterator it = m_aps.begin (); it != m_aps.end (); ++it)
+	{
+	  it->position = it->mobility->GetPosition ();
+	  m_minX = std::min (m_minX, it->position.x);
+	  m_minY = std::min (m_minY, it->position.y);
+	  maxX = std::max (maxX, it->position.x);
+	  maxY = std::max (maxY, it->position.y);
+	}
+
+      double width = maxX - m_minX;
+      double height = maxY - m_minY;
+
+      // Aim for about one AP per cell
+      double cell = m_cellSize;
+      if (cell <= 0)
+	cell = std::sqrt (width * height / m_aps.size ());
+      if (cell <= 0)
+	cell = std::max (std::max (width, height) / m_aps.size (), 1.0);
+
+      m_cellSize = cell;
+      m_cellsX = static_cast<int32_t> (width / cell) + 1;
+      m_cellsY = static_cast<int32_t> (height / cell) + 1;
+      m_cells.assign (m_cellsX * m_cellsY, std::vector<uint32_t> ());
+
+      for (uint32_t i = 0; i < m_aps.size (); i++)
+	{
+	  int32_t cx = std::min (static_cast<int32_t> ((m_aps[i].position.x - m_minX) / cell), m_cellsX - 1);
+	  int32_t cy = std::min (static_cast<int32_t> ((m_aps[i].position.y - m_minY) / cell), m_cellsY - 1);
+	  m_cells[cy * m_cellsX + cx].push_back (i);
+	}
+
+      NS_LOG_INFO ("Indexed " << m_aps.size () << " APs in a " << m_cellsX << "x" << m_cellsY
+                   << " grid of " << cell << "m cells");
+    }
+
+    void
+    WifiAssociationHelper::Closest (const Vector &pos, int32_t &first, double &firstDist,
+                                    int32_t &second, double &secondDist) const
+    {
+      const double inf = std::numeric_limits<double>::infinity ();
+      first = second = -1;
+      firstDist = secondDist = inf;
+
+      if (m_cells.empty ())
+	return;
+
+      int32_t cx = static_cast<int32_t> (std::floor ((pos.x - m_minX) / m_cellSize));
+      int32_t cy = static_cast<int32_t> (std::floor ((pos.y - m_minY) / m_cellSize));
+      cx = std::max (0, std::min (cx, m_cellsX - 1));
+      cy = std::max (0, std::min (cy, m_cellsY - 1));
+
+      int32_t rings = std::max (m_cellsX, m_cellsY);
+      for (int32_t r = 0; r < rings; r++)
+	{
+	  // Visit the cells at Chebyshev distance r from (cx, cy)
+	  for (int32_t y = cy - r; y <= cy + r; y++)
+	    {
+	      if (y < 0 || y >= m_cellsY)
+		continue;
+
+	      int32_t step = (y == cy - r || y == cy + r) ? 1 : 2 * r;
+	      for (int32_t x = cx - r; x <= cx + r; x += std::max (step, 1))
+		{
+		  if (x < 0 || x >= m_cellsX)
+		    continue;
+
+		  const std::vector<uint32_t> &cell = m_cells[y * m_cellsX + x];
+		  for (std::vector<uint32_t>::const_iterator it = cell.begin (); it != cell.end (); ++it)
+		    {
+		      double d = CalculateDistance (pos, m_aps[*it].position);
+		      if (d < firstDist)
+			{
+			  second = first;
+			  secondDist = firstDist;
+			  first = *it;
+			  firstDist = d;
+			}
+		      else if (d < secondDist)
+			{
+			  second = *it;
+			  secondDist = d;
+			}
+		    }
+		}
+	    }
+
+	  // Any AP not seen yet lies outside the visited square, so it is at
+	  // least as far as the nearest side of the square that has cells beyond
+	  double bound = inf;
+	  if (cx - r > 0)
+	    bound = std::min (bound, pos.x - (m_minX + (cx - r) * m_cellSize));
+	  if (cx + r < m_cellsX - 1)
+	    bound = std::min (bound, m_minX + (cx + r + 1) * m_cellSize - pos.x);
+	  if (cy - r > 0)
+	    bound = std::min (bound, pos.y - (m_minY + (cy - r) * m_cellSize));
+	  if (cy + r < m_cellsY - 1)
+	    bound = std::min (bound, m_minY + (cy + r + 1) * m_cellSize - pos.y);
+
+	  if (secondDist <= bound)
+	    break;
+	}
+    }
+
+    void
+    WifiAssociationHelper::Check (uint32_t i)
+    {
+      Station &st = m_stations[i];
+      Vector pos = st.mobility->GetPosition ();
+
+      int32_t first, second;
+      double firstDist, secondDist;
+      Closest (pos, first, firstDist, second, secondDist);
+
+      if (first < 0)
+	return;
+
+      int32_t current = st.ap;
+      double currentDist = (current < 0) ? 0 : CalculateDistance (pos, m_aps[current].position);
+
+      if (current < 0 || (first != current && currentDist - firstDist > m_hysteresis))
+	{
+	  NS_LOG_INFO ("Node " << st.node->GetId () << " at " << pos << " is " << firstDist
+                       << "m from " << m_aps[first].ssid);
+
+	  Associate (i, first);
+	  current = first;
+	  currentDist = firstDist;
+	}
+
+      // Closest AP competing with the current one
+      int32_t rival = (first == current) ? second : first;
+      double rivalDist = (first == current) ? secondDist : firstDist;
+
+      // The distance gap to the rival closes at most twice as fast as the
+      // station moves, so nothing can change before it has been used up
+      Time next = m_maxCheck;
+      Vector vel = st.mobility->GetVelocity ();
+      double speed = std::sqrt (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
+      if (rival >= 0 && speed > 0)
+	{
+	  double margin = m_hysteresis - (currentDist - rivalDist);
+	  next = Seconds (std::max (margin, 0.0) / (2 * speed));
+	}
+
+      next = std::max (m_minCheck, std::min (next, m_maxCheck));
+      st.check = Simulator::Schedule (next, &WifiAssociationHelper::Check, this, i);
+    }
+
+    void
+    WifiAssociationHelper::Associate (uint32_t i, int32_t ap)
+    {
+      Station &st = m_stations[i];
+      if (st.ap == ap)
+	return;
+
+      Ssid old = (st.ap < 0) ? Ssid () : m_aps[st.ap].ssid;
+
+      NS_LOG_INFO ("Node " << st.node->GetId () << " associating to " << m_aps[ap].ssid);
+
+      st.ap = ap;
+      st.mac->SetSsid (m_aps[ap].ssid);
+      m_association (st.node, old, m_aps[ap].ssid);
+    }
+
+    void
+    WifiAssociationHelper::CourseChanged (Ptr<const MobilityModel> mobility)
+    {
+      if (!m_started)
+	return;
+
+      std::map<const MobilityModel *, uint32_t>::iterator it = m_byMobility.find (PeekPointer (mobility));
+      if (it == m_byMobility.end () || m_stations[it->second].traced)
+	return;
+
+      Station &st = m_stations[it->second];
+      Simulator::Cancel (st.check);
+      st.check = Simulator::ScheduleNow (&WifiAssociationHelper::Check, this, it->second);
+    }
+
+    void
+    WifiAssociationHelper::ReadNs2Trace (const std::string &file, Trajectories &trajectories)
+    {
+      std::ifstream trace (file.c_str ());
+      if (!trace.is_open ())
+	NS_FATAL_ERROR ("Could not open ns-2 movement trace " << file);
+
+      std::map<uint32_t, Vector> initial;
+      std::map<uint32_t, std::vector<Ns2Command> > commands;
+
+      std::string line;
+      while (std::getline (trace, line))
+	{
+	  Ns2Command cmd;
+	  uint32_t id;
+	  double value;
+	  cmd.speed = 0;
+
+	  if (std::sscanf (line.c_str (), " $ns_ at %lf \"$node_(%u) setdest %lf %lf %lf\"",
+	                   &cmd.time, &id, &cmd.dest.x, &cmd.dest.y, &cmd.speed) == 5)
+	    {
+	      cmd.attr = 'd';
+	      commands[id].push_back (cmd);
+	    }
+	  else if (std::sscanf (line.c_str (), " $ns_ at %lf \"$node_(%u) set %c_ %lf\"",
+	                        &cmd.time, &id, &cmd.attr, &value) == 4)
+	    {
+	      cmd.dest = Vector (value, value, value);
+	      commands[id].push_back (cmd);
+	    }
+	  else if (std::sscanf (line.c_str (), " $node_(%u) set %c_ %lf", &id, &cmd.attr, &value) == 3)
+	    {
+	      Vector &pos = initial[id];
+	      if (cmd.attr == 'X') pos.x = value;
+	      else if (cmd.attr == 'Y') pos.y = value;
+	      else if (cmd.attr == 'Z') pos.z = value;
+	    }
+	}
+
+      const double inf = std::numeric_limits<double>::infinity ();
+
+      for (std::map<uint32_t, Vector>::iterator n = initial.begin (); n != initial.end (); ++n)
+	{
+	  std::vector<Ns2Command> &cmds = commands[n->first];
+	  std::vector<Segment> &segments = trajectories[n->first];
+
+	  // Same order as Ns2MobilityHelper runs them, by time then file order
+	  std::stable_sort (cmds.begin (), cmds.end (), Ns2CommandEarlier);
+
+	  Segment seg;
+	  seg.start = 0;
+	  seg.position = n->second;
+	  seg.velocity = Vector (0, 0, 0);
+	  double arrival = inf;
+
+	  for (std::vector<Ns2Command>::iterator c = cmds.begin (); c != cmds.end (); ++c)
+	    {
+	      // Reached the destination of the previous setdest and stopped there
+	      if (arrival < c->time)
+		{
+		  seg.end = arrival;
+		  segments.push_back (seg);
+		  seg.position = seg.position + Vector (seg.velocity.x * (arrival - seg.start),
+		                                        seg.velocity.y * (arrival - seg.start),
+		                                        seg.velocity.z * (arrival - seg.start));
+		  seg.start = arrival;
+		  seg.velocity = Vector (0, 0, 0);
+		  arrival = inf;
+		}
+
+	      double dt = c->time - seg.start;
+	      seg.end = c->time;
+	      segments.push_back (seg);
+	      seg.position = seg.position + Vector (seg.velocity.x * dt, seg.velocity.y * dt, seg.velocity.z * dt);
+	      seg.start = c->time;
+	      seg.velocity = Vector (0, 0, 0);
+	      arrival = inf;
+
+	      if (c->attr == 'd')
+		{
+		  Vector dest (c->dest.x, c->dest.y, seg.position.z);
+		  double dist = CalculateDistance (seg.position, dest);
+		  if (c->speed > 0 && dist > 0)
+		    {
+		      seg.velocity = Vector ((dest.x - seg.position.x) * c->speed / dist,
+		                             (dest.y - seg.position.y) * c->speed / dist, 0);
+		      arrival = c->time + dist / c->speed;
+		    }
+		}
+	      else if (c->attr == 'X') seg.position.x = c->dest.x;
+	      else if (c->attr == 'Y') seg.position.y = c->dest.y;
+	      else if (c->attr == 'Z') seg.position.z = c->dest.z;
+	    }
+
+	  if (arrival < inf)
+	    {
+	      seg.end = arrival;
+	      segments.push_back (seg);
+	      seg.position = seg.position + Vector (seg.velocity.x * (arrival - seg.start),
+	                                            seg.velocity.y * (arrival - seg.start),
+	                                            seg.velocity.z * (arrival - seg.start));
+	      seg.start = arrival;
+	      seg.velocity = Vector (0, 0, 0);
+	    }
+
+	  seg.end = inf;
+	  segments.push_back (seg);
+	}
+    }
+
+    double
+    WifiAssociationHelper::NextHandoff (const Segment &seg, double lo, double hi, int32_t current, int32_t &ap) const
+    {
+      const Vector &p = seg.position;
+      const Vector &v = seg.velocity;
+      double h = m_hysteresis;
+      double vv = v.x * v.x + v.y * v.y + v.z * v.z;
+
+      double best = -1;
+      if (vv == 0)
+	return best;
+
+      const Vector &c = m_aps[current].position;
+      for (uint32_t i = 0; i < m_aps.size (); i++)
+	{
+	  if (static_cast<int32_t> (i) == current)
+	    continue;
+
+	  const Vector &a = m_aps[i].position;
+
+	  // With p(t) = p + v t, L(t) = |p(t) - c|^2 - |p(t) - a|^2 = A + B t.
+	  // The station moves once |p(t) - c| - |p(t) - a| = h, that is once
+	  // L(t) - h^2 = 2 h |p(t) - a| with the left side non negative
+	  Vector dc (p.x - c.x, p.y - c.y, p.z - c.z);
+	  Vector da (p.x - a.x, p.y - a.y, p.z - a.z);
+	  double dada = da.x * da.x + da.y * da.y + da.z * da.z;
+	  double dav = da.x * v.x + da.y * v.y + da.z * v.z;
+	  double A = dc.x * dc.x + dc.y * dc.y + dc.z * dc.z - dada;
+	  double B = 2 * ((a.x - c.x) * v.x + (a.y - c.y) * v.y + (a.z - c.z) * v.z);
+
+	  double roots[2];
+	  int nroots = 0;
+
+	  if (h == 0)
+	    {
+	      if (B > 0)
+		roots[nroots++] = -A / B;
+	    }
+	  else
+	    {
+	      // Squaring both sides leaves a quadratic in t
+	      double k = A - h * h;
+	      double qa = B * B - 4 * h * h * vv;
+	      double qb = 2 * B * k - 8 * h * h * dav;
+	      double qc = k * k - 4 * h * h * dada;
+
+	      if (std::fabs (qa) < 1e-12 * std::max (1.0, std::fabs (qb)))
+		{
+		  if (qb != 0)
+		    roots[nroots++] = -qc / qb;
+		}
+	      else
+		{
+		  double disc = qb * qb - 4 * qa * qc;
+		  if (disc >= 0)
+		    {
+		      double sq = std::sqrt (disc);
+		      roots[nroots++] = (-qb - sq) / (2 * qa);
+		      roots[nroots++] = (-qb + sq) / (2 * qa);
+		    }
+		}
+
+	      // Drop the roots brought in by squaring
+	      int valid = 0;
+	      for (int r = 0; r < nroots; r++)
+		if (k + B * roots[r] >= 0)
+		  roots[valid++] = roots[r];
+	      nroots = valid;
+	    }
+
+	  for (int r = 0; r < nroots; r++)
+	    {
+	      if (roots[r] > lo && roots[r] <= hi && (best < 0 || roots[r] < best))
+		{
+		  best = roots[r];
+		  ap = i;
+		}
+	    }
+	}
+
+      return best;
+    }
+
+    void
+    WifiAssociationHelper::ScheduleHandoffs (uint32_t i, const std::vector<Segment> &trajectory, double start, double stop)
+    {
+      int32_t current = -1;
+      double now = Simulator::Now ().GetSeconds ();
+
+      for (std::vector<Segment>::const_iterator seg = trajectory.begin (); seg != trajectory.end (); ++seg)
+	{
+	  if (seg->end < start)
+	    continue;
+	  if (seg->start > stop)
+	    break;
+
+	  double lo = std::max (seg->start, start) - seg->start;
+	  double hi = std::min (seg->end, stop) - seg->start;
+
+	  if (current < 0)
+	    {
+	      // First association, to the closest AP at start
+	      Vector pos (seg->position.x + seg->velocity.x * lo,
+	                  seg->position.y + seg->velocity.y * lo,
+	                  seg->position.z + seg->velocity.z * lo);
+	      int32_t second;
+	      double firstDist, secondDist;
+	      Closest (pos, current, firstDist, second, secondDist);
+	      if (current < 0)
+		return;
+
+	      m_handoffs.push_back (Simulator::Schedule (Seconds (start - now), &WifiAssociationHelper::Associate, this, i, current));
+	    }
+
+	  int32_t ap;
+	  double t;
+	  while ((t = NextHandoff (*seg, lo, hi, current, ap)) >= 0)
+	    {
+	      m_handoffs.push_back (Simulator::Schedule (Seconds (seg->start + t - now), &WifiAssociationHelper::Associate, this, i, ap));
+	      current = ap;
+	      lo = t;
+	    }
+	}
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
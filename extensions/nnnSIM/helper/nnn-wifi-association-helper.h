@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-wifi-association-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-wifi-association-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-wifi-association-helper.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_WIFI_ASSOCIATION_HELPER_H_
+#define NNN_WIFI_ASSOCIATION_HELPER_H_
+
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/mobility-model.h>
+#include <ns3-dev/ns3/net-device-container.h>
+#include <ns3-dev/ns3/node.h>
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/object.h>
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/ssid.h>
+#include <ns3-dev/ns3/traced-callback.h>
+#include <ns3-dev/ns3/vector.h>
+#include <ns3-dev/ns3/wifi-mac.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Associates Wi-Fi stations to their closest AP as they move
+     *
+     * Replaces the periodic SetSSIDviaDistance polling of the mobility
+     * scenarios. The AP positions are kept in a uniform grid, so finding
+     * the closest AP only looks at the cells around the station. Each
+     * station is checked again at the earliest time its closest AP could
+     * change given its current speed, and right away when its mobility
+     * model reports a course change. The SSID is set directly on the
+     * station MAC.
+     *
+     * A station only moves to a new AP once it is Hysteresis meters closer
+     * than the current one. The APs are assumed not to move after Start.
+     *
+     * Usage:
+     *
+     *     Ptr<nnn::WifiAssociationHelper> assoc = CreateObject<nnn::WifiAssociationHelper> ();
+     *     assoc->AddAps (wifiAPNetDevices);
+     *     assoc->AddStations (wifiMTNetDevices);
+     *     assoc->TraceConnectWithoutContext ("Association", MakeCallback (&OnAssociation));
+     *     assoc->Start (Seconds (0));
+     */
+    class WifiAssociationHelper : public Object
+    {
+    public:
+      static TypeId
+      GetTypeId ();
+
+      WifiAssociationHelper ();
+
+      virtual
+      ~WifiAssociationHelper ();
+
+      /**
+       * @brief Add an AP, using the SSID of its MAC and the position of its node
+       */
+      void
+      AddAp (Ptr<NetDevice> device);
+
+      /**
+       * @brief Add an AP known by its SSID and mobility model
+       */
+      void
+      AddAp (const Ssid &ssid, Ptr<MobilityModel> mobility);
+
+      void
+      AddAps (const NetDeviceContainer &devices);
+
+      /**
+       * @brief Add a station, device must be a WifiNetDevice
+       */
+      void
+      AddStation (Ptr<NetDevice> device);
+
+      void
+      AddStations (const NetDeviceContainer &devices);
+
+      /**
+       * @brief Build the AP index and schedule the first check of every station
+       */
+      void
+      Start (Time start);
+
+      /**
+       * @brief Start, precomputing the handoffs of the stations in an ns-2 movement trace
+       *
+       * Reads the setdest commands of the trace (as installed by
+       * Ns2MobilityHelper) and solves for the exact times each station
+       * crosses into the coverage of a new AP, scheduling one association
+       * event per handoff between start and stop. Stations that do not
+       * appear in the trace are checked as with Start.
+       */
+      void
+      StartFromNs2Trace (const std::string &file, Time start, Time stop);
+
+      /**
+       * @brief SSID the station of node is associated to, empty if none
+       */
+      Ssid
+      GetSsid (Ptr<Node> node) const;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      struct Ap
+      {
+	Ssid ssid;
+	Ptr<MobilityModel> mobility;
+	Vector position;
+      };
+
+      struct Station
+      {
+	Ptr<Node> node;
+	Ptr<MobilityModel> mobility;
+	Ptr<WifiMac> mac;
+	int32_t ap;           ///< @brief Index of the AP associated to, -1 if none
+	bool traced;          ///< @brief Handoffs are precomputed from a movement trace
+	EventId check;
+      };
+
+      /**
+       * @brief Stretch of a trace where a node moves at constant velocity
+       */
+      struct Segment
+      {
+	double start;         ///< @brief Seconds
+	double end;
+	Vector position;      ///< @brief Position at start
+	Vector velocity;
+      };
+
+      typedef std::map<uint32_t, std::vector<Segment> > Trajectories;
+
+      /**
+       * @brief Read an ns-2 movement trace into the trajectory of each node id
+       */
+      static void
+      ReadNs2Trace (const std::string &file, Trajectories &trajectories);
+
+      /**
+       * @brief Earliest offset in (lo, hi] of seg at which a station associated
+       * to current should move to another AP, -1 if none
+       */
+      double
+      NextHandoff (const Segment &seg, double lo, double hi, int32_t current, int32_t &ap) const;
+
+      void
+      ScheduleHandoffs (uint32_t station, const std::vector<Segment> &trajectory, double start, double stop);
+
+      /**
+       * @brief Place the APs in the grid
+       */
+      void
+      BuildIndex ();
+
+      /**
+       * @brief Find the two APs closest to pos, -1 when there are not enough APs
+       */
+      void
+      Closest (const Vector &pos, int32_t &first, double &firstDist,
+               int32_t &second, double &secondDist) const;
+
+      void
+      Associate (uint32_t station, int32_t ap);
+
+      void
+      Check (uint32_t station);
+
+      void
+      CourseChanged (Ptr<const MobilityModel> mobility);
+
+    private:
+      std::vector<Ap> m_aps;
+      std::vector<Station> m_stations;
+      std::map<const MobilityModel *, uint32_t> m_byMobility;  ///< @brief Station index by mobility model
+
+      // Grid over the AP positions
+      double m_cellSize;
+      double m_minX;
+      double m_minY;
+      int32_t m_cellsX;
+      int32_t m_cellsY;
+      std::vector<std::vector<uint32_t> > m_cells;
+
+      std::vector<EventId> m_handoffs;  ///< @brief Precomputed association events
+
+      double m_hysteresis;
+      Time m_minCheck;
+      Time m_maxCheck;
+      bool m_started;
+
+      TracedCallback<Ptr<Node>, Ssid /*old*/, Ssid /*new*/> m_association;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_WIFI_ASSOCIATION_HELPER_H_ */
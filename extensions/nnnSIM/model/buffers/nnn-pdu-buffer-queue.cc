@@ -27,6 +27,7 @@ namespace ns3
   {
 
     PDUQueue::PDUQueue ()
+    : m_bytes (0)
     {
     }
 
@@ -43,47 +44,67 @@ namespace ns3
     void
     PDUQueue::clear ()
     {
-      std::queue<std::pair<Time, Ptr<Packet> > > empty;
+      pdu_deque empty;
 
       std::swap(buffer, empty);
+      m_bytes = 0;
     }
 
     Ptr<Packet>
     PDUQueue::pop ()
     {
       Ptr<Packet> tmp = buffer.front ().second;
-      buffer.pop();
+      buffer.pop_front ();
+      m_bytes -= tmp->GetSize ();
       return tmp;
     }
 
     void
     PDUQueue::push (Ptr<Packet> pdu, Time retx)
     {
-      buffer.push (std::make_pair((Simulator::Now () + retx), pdu));
+      buffer.push_back (std::make_pair((Simulator::Now () + retx), pdu));
+      m_bytes += pdu->GetSize ();
     }
 
     void
     PDUQueue::pushSO (Ptr<const SO> so_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDO (Ptr<const DO> do_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDU (Ptr<const DU> du_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM), retx);
+    }
+
+    Time
+    PDUQueue::frontExpiry () const
+    {
+      return buffer.front ().first;
+    }
+
+    void
+    PDUQueue::popQueue (pdu_deque &out)
+    {
+      out.clear ();
+      std::swap (buffer, out);
+      m_bytes = 0;
     }
 
     std::queue<std::pair<Time, Ptr<Packet> > >
     PDUQueue::popQueue ()
     {
-      return buffer;
+      pdu_deque tmp;
+      popQueue (tmp);
+
+      return std::queue<std::pair<Time, Ptr<Packet> > > (tmp);
     }
 
     uint
@@ -92,5 +113,11 @@ namespace ns3
       return buffer.size();
     }
 
+    uint32_t
+    PDUQueue::bytes () const
+    {
+      return m_bytes;
+    }
+
   } /* namespace nnn */
 } /* namespace ns3 */
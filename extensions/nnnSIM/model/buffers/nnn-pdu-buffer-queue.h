@@ -20,6 +20,7 @@
 #ifndef PDU_QUEUE_H_
 #define PDU_QUEUE_H_
 
+#include <deque>
 #include <queue>
 
 #include "../nnn-nnnsim-wire.h"
@@ -33,6 +34,8 @@ namespace ns3
     class PDUQueue : public SimpleRefCount<PDUQueue>
     {
     public:
+      typedef std::deque<std::pair<Time, Ptr<Packet> > > pdu_deque;
+
       PDUQueue ();
       virtual
       ~PDUQueue ();
@@ -58,14 +61,34 @@ namespace ns3
       void
       pushDU (Ptr<const DU> du_p, Time retx);
 
+      /**
+       * @brief Expiry time of the PDU at the head of the queue
+       */
+      Time
+      frontExpiry () const;
+
+      /**
+       * @brief Move all the PDUs, with their expiry time, into out,
+       * leaving the queue empty
+       */
+      void
+      popQueue (pdu_deque &out);
+
       std::queue<std::pair<Time, Ptr<Packet> > >
       popQueue ();
 
       uint
       size ();
 
+      /**
+       * @brief Total size in bytes of the PDUs in the queue
+       */
+      uint32_t
+      bytes () const;
+
     private:
-      std::queue<std::pair<Time,Ptr<Packet> > > buffer;
+      pdu_deque buffer;
+      uint32_t m_bytes;
     };
 
   } /* namespace nnn */
@@ -18,7 +18,11 @@
  */
 #include <algorithm>
 
+#include <ns3-dev/ns3/enum.h>
 #include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/string.h>
+#include <ns3-dev/ns3/uinteger.h>
 
 #include "nnn-pdu-buffer.h"
 
@@ -34,22 +38,83 @@ namespace ns3
       static TypeId tid = TypeId ("ns3::nnn::PacketBuffer")
         	.SetParent<Object> ()
 		.AddConstructor<PDUBuffer> ()
+		.AddAttribute ("MaxPackets",
+		               "Maximum number of PDUs buffered per destination (0 means no limit)",
+		               StringValue ("0"),
+		               MakeUintegerAccessor (&PDUBuffer::m_maxPackets),
+		               MakeUintegerChecker<uint32_t> ())
+		.AddAttribute ("MaxBytes",
+		               "Maximum number of bytes buffered per destination (0 means no limit)",
+		               StringValue ("0"),
+		               MakeUintegerAccessor (&PDUBuffer::m_maxBytes),
+		               MakeUintegerChecker<uint32_t> ())
+		.AddAttribute ("MaxTotalPackets",
+		               "Maximum number of PDUs buffered for all destinations (0 means no limit)",
+		               StringValue ("0"),
+		               MakeUintegerAccessor (&PDUBuffer::m_maxTotalPackets),
+		               MakeUintegerChecker<uint32_t> ())
+		.AddAttribute ("MaxTotalBytes",
+		               "Maximum number of bytes buffered for all destinations (0 means no limit)",
+		               StringValue ("0"),
+		               MakeUintegerAccessor (&PDUBuffer::m_maxTotalBytes),
+		               MakeUintegerChecker<uint32_t> ())
+		.AddAttribute ("DropPolicy",
+		               "What to discard when a PDU does not fit in the buffer",
+		               EnumValue (PDUBuffer::DROP_TAIL),
+		               MakeEnumAccessor (&PDUBuffer::m_policy),
+		               MakeEnumChecker (PDUBuffer::DROP_TAIL, "DropTail",
+		                                PDUBuffer::DROP_HEAD, "DropHead",
+		                                PDUBuffer::DROP_OLDEST_EXPIRED, "DropOldestExpired"))
+		.AddTraceSource ("OccupancyPackets", "OccupancyPackets",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_totalPackets))
+		.AddTraceSource ("OccupancyBytes", "OccupancyBytes",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_totalBytes))
+		.AddTraceSource ("Drop", "Drop",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_dropTrace))
+		.AddTraceSource ("Expire", "Expire",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_expireTrace))
 		;
       return tid;
     }
 
     PDUBuffer::PDUBuffer ()
-    : m_retx (MilliSeconds (50))
+    : m_retx            (MilliSeconds (50))
+    , m_maxPackets      (0)
+    , m_maxBytes        (0)
+    , m_maxTotalPackets (0)
+    , m_maxTotalBytes   (0)
+    , m_policy          (DROP_TAIL)
+    , m_totalPackets    (0)
+    , m_totalBytes      (0)
     {
     }
 
     PDUBuffer::PDUBuffer (Time retx)
-    : m_retx (retx)
+    : m_retx            (retx)
+    , m_maxPackets      (0)
+    , m_maxBytes        (0)
+    , m_maxTotalPackets (0)
+    , m_maxTotalBytes   (0)
+    , m_policy          (DROP_TAIL)
+    , m_totalPackets    (0)
+    , m_totalBytes      (0)
     {
     }
 
     PDUBuffer::~PDUBuffer ()
     {
+      Simulator::Cancel (m_purgeEvent);
+    }
+
+    void
+    PDUBuffer::DoDispose ()
+    {
+      Simulator::Cancel (m_purgeEvent);
+      super::clear ();
+      m_totalPackets = 0;
+      m_totalBytes = 0;
+
+      Object::DoDispose ();
     }
 
     void
@@ -89,6 +154,13 @@ namespace ns3
 
       if (item != super::end ())
 	{
+	  Ptr<PDUQueue> queue = item->payload ();
+	  if (queue != 0)
+	    {
+	      m_totalPackets -= queue->size ();
+	      m_totalBytes -= queue->bytes ();
+	    }
+
 	  super::erase(item);
 	}
     }
@@ -111,49 +183,244 @@ namespace ns3
     bool
     PDUBuffer::DestinationExists (Ptr<NNNAddress> addr)
     {
-      DestinationExists (*addr);
+      return DestinationExists (*addr);
     }
 
     void
-    PDUBuffer::PushSO (const NNNAddress &addr, Ptr<const SO> so_p)
+    PDUBuffer::Push (const NNNAddress &addr, Ptr<Packet> pdu)
     {
       NS_LOG_FUNCTION(this << addr);
 
-      NS_LOG_INFO ("PushPDU SO Looking for " << addr);
-
       super::iterator item = super::find_exact(addr);
 
-      if (item != super::end ())
+      if (item == super::end () || item->payload () == 0)
 	{
-	  NS_LOG_INFO("PushPDU SO, found " << addr << " inserting");
-	  Ptr<PDUQueue> tmp = item->payload();
+	  NS_LOG_INFO("No buffer for " << addr << ", ignoring PDU");
+	  return;
+	}
 
-	  tmp->pushSO(so_p, m_retx);
+      Ptr<PDUQueue> queue = item->payload ();
+      uint32_t size = pdu->GetSize ();
+
+      if (!Fits (queue, size))
+	{
+	  switch (m_policy)
+	  {
+	    case DROP_HEAD:
+	      while (!queue->isEmpty () && !Fits (queue, size))
+		{
+		  Ptr<Packet> head = PopFront (queue);
+		  NS_LOG_DEBUG ("Buffer for " << addr << " full, dropping head PDU");
+		  m_dropTrace (head, addr);
+		}
+	      break;
+	    case DROP_OLDEST_EXPIRED:
+	      PurgeAll ();
+	      while (!Fits (queue, size))
+		{
+		  if (!DropOldest (addr, queue, size))
+		    break;
+		}
+	      break;
+	    case DROP_TAIL:
+	    default:
+	      break;
+	  }
+
+	  // Per destination dropping cannot always make room in the whole
+	  // buffer, in which case the arriving PDU is the one discarded
+	  if (!Fits (queue, size))
+	    {
+	      NS_LOG_DEBUG ("Buffer for " << addr << " full, dropping arriving PDU");
+	      m_dropTrace (pdu, addr);
+	      return;
+	    }
 	}
+
+      NS_LOG_INFO("Buffering PDU for " << addr);
+      queue->push (pdu, m_retx);
+      m_totalPackets += 1;
+      m_totalBytes += size;
+
+      SchedulePurge (Simulator::Now () + m_retx);
+    }
+
+    bool
+    PDUBuffer::Fits (Ptr<PDUQueue> queue, uint32_t size) const
+    {
+      if (m_maxPackets != 0 && queue->size () + 1 > m_maxPackets)
+	return false;
+      if (m_maxBytes != 0 && queue->bytes () + size > m_maxBytes)
+	return false;
+      if (m_maxTotalPackets != 0 && m_totalPackets + 1 > m_maxTotalPackets)
+	return false;
+      if (m_maxTotalBytes != 0 && m_totalBytes + size > m_maxTotalBytes)
+	return false;
+
+      return true;
+    }
+
+    Ptr<Packet>
+    PDUBuffer::PopFront (Ptr<PDUQueue> queue)
+    {
+      Ptr<Packet> pdu = queue->pop ();
+      m_totalPackets -= 1;
+      m_totalBytes -= pdu->GetSize ();
+      return pdu;
     }
 
     void
-    PDUBuffer::PushSO (Ptr<NNNAddress> addr, Ptr<const SO> so_p)
+    PDUBuffer::PurgeExpired (const NNNAddress &addr, Ptr<PDUQueue> queue)
     {
-      PushSO (*addr, so_p);
+      Time now = Simulator::Now ();
+
+      // PDUs are queued in order of arrival, so the expired ones are at the head
+      while (!queue->isEmpty () && queue->frontExpiry () < now)
+	{
+	  Ptr<Packet> pdu = PopFront (queue);
+	  NS_LOG_DEBUG ("PDU for " << addr << " expired");
+	  m_expireTrace (pdu, addr);
+	}
+    }
+
+    Time
+    PDUBuffer::PurgeAll ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      Time now = Simulator::Now ();
+      Time earliest = Time::Max ();
+
+      super::parent_trie::recursive_iterator item (super::getTrie ());
+      super::parent_trie::recursive_iterator end (0);
+      for (; item != end; item++)
+	{
+	  Ptr<PDUQueue> queue = item->payload ();
+	  if (queue == 0 || queue->isEmpty ()) continue;
+
+	  if (queue->frontExpiry () < now)
+	    PurgeExpired (AddressOf (&(*item)), queue);
+
+	  if (!queue->isEmpty ())
+	    earliest = std::min (earliest, queue->frontExpiry ());
+	}
+
+      return earliest;
+    }
+
+    bool
+    PDUBuffer::DropOldest (const NNNAddress &addr, Ptr<PDUQueue> queue, uint32_t size)
+    {
+      Ptr<PDUQueue> victim = 0;
+      NNNAddress victimAddr;
+
+      if ((m_maxPackets != 0 && queue->size () + 1 > m_maxPackets) ||
+	  (m_maxBytes != 0 && queue->bytes () + size > m_maxBytes))
+	{
+	  // Only the PDUs of the destination can make room within its limits
+	  if (queue->isEmpty ())
+	    return false;
+
+	  victim = queue;
+	  victimAddr = addr;
+	}
+      else
+	{
+	  // The whole buffer is full, so look for the head expiring first
+	  Time earliest = Time::Max ();
+
+	  super::parent_trie::recursive_iterator item (super::getTrie ());
+	  super::parent_trie::recursive_iterator end (0);
+	  for (; item != end; item++)
+	    {
+	      Ptr<PDUQueue> candidate = item->payload ();
+	      if (candidate == 0 || candidate->isEmpty ()) continue;
+
+	      if (candidate->frontExpiry () < earliest)
+		{
+		  earliest = candidate->frontExpiry ();
+		  victim = candidate;
+		  victimAddr = AddressOf (&(*item));
+		}
+	    }
+
+	  if (victim == 0)
+	    return false;
+	}
+
+      Ptr<Packet> pdu = PopFront (victim);
+      NS_LOG_DEBUG ("Buffer full, dropping oldest PDU for " << victimAddr);
+      m_dropTrace (pdu, victimAddr);
+      return true;
     }
 
     void
-    PDUBuffer::PushDO (const NNNAddress& addr, Ptr<const DO> do_p)
+    PDUBuffer::PurgeTimeout ()
     {
-      NS_LOG_FUNCTION(this << addr);
+      NS_LOG_FUNCTION (this);
 
-      NS_LOG_INFO ("PushPDU DO Looking for " << addr);
+      Time earliest = PurgeAll ();
 
-      super::iterator item = super::find_exact(addr);
+      if (earliest != Time::Max ())
+	SchedulePurge (earliest);
+    }
 
-      if (item != super::end ())
+    void
+    PDUBuffer::SchedulePurge (Time expiry)
+    {
+      // A PDU is only stale once its expiry time has passed
+      Time delay = expiry - Simulator::Now () + NanoSeconds (1);
+
+      if (m_purgeEvent.IsRunning ())
 	{
-	  NS_LOG_INFO("PushPDU DO, found " << addr << " inserting");
-	  Ptr<PDUQueue> tmp = item->payload();
+	  if (Simulator::GetDelayLeft (m_purgeEvent) <= delay)
+	    return;
 
-	  tmp->pushDO(do_p, m_retx);
+	  Simulator::Cancel (m_purgeEvent);
 	}
+
+      m_purgeEvent = Simulator::Schedule (delay, &PDUBuffer::PurgeTimeout, this);
+    }
+
+    NNNAddress
+    PDUBuffer::AddressOf (super::parent_trie::const_iterator node)
+    {
+      std::vector<name::Component> comps;
+
+      // The root of the trie carries no component
+      for (; node != 0 && node->parent () != 0; node = node->parent ())
+	comps.push_back (node->key ());
+
+      std::reverse (comps.begin (), comps.end ());
+      return NNNAddress (comps);
+    }
+
+    void
+    PDUBuffer::PushSO (const NNNAddress &addr, Ptr<const SO> so_p)
+    {
+      NS_LOG_FUNCTION(this << addr);
+
+      NS_LOG_INFO ("PushPDU SO for " << addr);
+
+      if (DestinationExists (addr))
+	Push (addr, Wire::FromSO (so_p, Wire::WIRE_FORMAT_NNNSIM));
+    }
+
+    void
+    PDUBuffer::PushSO (Ptr<NNNAddress> addr, Ptr<const SO> so_p)
+    {
+      PushSO (*addr, so_p);
+    }
+
+    void
+    PDUBuffer::PushDO (const NNNAddress& addr, Ptr<const DO> do_p)
+    {
+      NS_LOG_FUNCTION(this << addr);
+
+      NS_LOG_INFO ("PushPDU DO for " << addr);
+
+      if (DestinationExists (addr))
+	Push (addr, Wire::FromDO (do_p, Wire::WIRE_FORMAT_NNNSIM));
     }
 
     void
@@ -167,17 +434,10 @@ namespace ns3
     {
       NS_LOG_FUNCTION(this << addr);
 
-      NS_LOG_INFO ("PushPDU DU Looking for " << addr);
-
-      super::iterator item = super::find_exact(addr);
-
-      if (item != super::end ())
-	{
-	  NS_LOG_INFO("PushPDU DU, found " << addr << " inserting");
-	  Ptr<PDUQueue> tmp = item->payload();
+      NS_LOG_INFO ("PushPDU DU for " << addr);
 
-	  tmp->pushDU(du_p, m_retx);
-	}
+      if (DestinationExists (addr))
+	Push (addr, Wire::FromDU (du_p, Wire::WIRE_FORMAT_NNNSIM));
     }
 
     void
@@ -186,8 +446,8 @@ namespace ns3
       PushDU (*addr, du_p);
     }
 
-    std::queue<Ptr<Packet> >
-    PDUBuffer::PopQueue (const NNNAddress &addr)
+    uint32_t
+    PDUBuffer::PopQueue (const NNNAddress &addr, std::vector<Ptr<Packet> > &pdus)
     {
       NS_LOG_FUNCTION(this << addr);
 
@@ -195,55 +455,61 @@ namespace ns3
 
       super::iterator item = super::find_exact(addr);
 
-      std::queue<Ptr<Packet> > pdu_queue;
       uint32_t pushed = 0;
       uint32_t discarded = 0;
 
-      if (item != super::end ())
+      if (item == super::end () || item->payload () == 0)
 	{
-	  NS_LOG_INFO("Found 3N name (" << addr << ")");
-	  if (item->payload() == 0)
-	    {
-	      NS_LOG_INFO("No info found");
-	    }
-	  else
-	    {
-	      NS_LOG_INFO("Found info, obtaining queue");
-	      std::queue<std::pair<Time, Ptr<Packet> > > queue_with_time = item->payload()->popQueue();
+	  NS_LOG_INFO("No info found for (" << addr << ")");
+	  return 0;
+	}
 
-	      Time now = Simulator::Now ();
+      NS_LOG_INFO("Found info, obtaining queue");
+      Ptr<PDUQueue> queue = item->payload ();
 
-	      // Go through the queue and get those PDUs that haven't yet hit the retransmission time
-	      while (!queue_with_time.empty ())
-		{
-		  // Get the PDU at the front of the queue
-		  std::pair<Time,Ptr<Packet> > queue_pair = queue_with_time.front ();
+      m_totalPackets -= queue->size ();
+      m_totalBytes -= queue->bytes ();
 
-		  Time expiry = queue_pair.first;
+      PDUQueue::pdu_deque queue_with_time;
+      queue->popQueue (queue_with_time);
 
-		  // If the expiry time has not been reached, add it to the returning queue
-		  if (now <= expiry)
-		    {
-		      NS_LOG_DEBUG ("Now is " << now << " PDU has expiry of " << expiry << " inserting PDU");
+      pdus.reserve (pdus.size () + queue_with_time.size ());
 
-		      pdu_queue.push (queue_pair.second);
+      Time now = Simulator::Now ();
 
-		      pushed++;
-		    }
-		  else
-		    {
-		      NS_LOG_DEBUG ("Now is " << now << " PDU has expiry of " << expiry << " discarding PDU");
-		      discarded++;
-		    }
-
-		  // Pop the queue and continue
-		  queue_with_time.pop ();
-		}
+      // Keep those PDUs that haven't yet hit the retransmission time
+      for (PDUQueue::pdu_deque::const_iterator it = queue_with_time.begin ();
+	  it != queue_with_time.end (); ++it)
+	{
+	  if (now <= it->first)
+	    {
+	      NS_LOG_DEBUG ("Now is " << now << " PDU has expiry of " << it->first << " inserting PDU");
+	      pdus.push_back (it->second);
+	      pushed++;
+	    }
+	  else
+	    {
+	      NS_LOG_DEBUG ("Now is " << now << " PDU has expiry of " << it->first << " discarding PDU");
+	      m_expireTrace (it->second, addr);
+	      discarded++;
 	    }
 	}
 
       NS_LOG_INFO ("Buffer for (" << addr << ") being returned with " << std::dec << pushed << " PDUs having discarded " << discarded);
 
+      return pushed;
+    }
+
+    std::queue<Ptr<Packet> >
+    PDUBuffer::PopQueue (const NNNAddress &addr)
+    {
+      std::vector<Ptr<Packet> > pdus;
+      PopQueue (addr, pdus);
+
+      std::queue<Ptr<Packet> > pdu_queue;
+      for (std::vector<Ptr<Packet> >::const_iterator it = pdus.begin (); it != pdus.end (); ++it)
+	pdu_queue.push (*it);
+
       return pdu_queue;
     }
 
@@ -253,6 +519,18 @@ namespace ns3
       return PopQueue (*addr);
     }
 
+    uint32_t
+    PDUBuffer::GetTotalPackets () const
+    {
+      return m_totalPackets;
+    }
+
+    uint32_t
+    PDUBuffer::GetTotalBytes () const
+    {
+      return m_totalBytes;
+    }
+
     uint
     PDUBuffer::QueueSize (const NNNAddress &addr)
     {
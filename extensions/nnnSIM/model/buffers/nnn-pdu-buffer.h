@@ -20,6 +20,10 @@
 #ifndef PDU_BUFFER_H_
 #define PDU_BUFFER_H_
 
+#include <vector>
+
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/traced-callback.h>
 #include <ns3-dev/ns3/traced-value.h>
 #include <ns3-dev/ns3/trace-source-accessor.h>
 #include <ns3-dev/ns3/object.h>
@@ -37,6 +41,15 @@ namespace ns3
 {
   namespace nnn
   {
+    /**
+     * @ingroup nnn
+     * @brief Per destination buffer of 3N PDUs for nodes that are moving
+     *
+     * PDUs are kept for at most the retransmission time, after which they
+     * are purged. Optionally the buffer is bounded per destination and in
+     * total, both in PDUs and in bytes (a limit of 0 means no limit). When
+     * a limit is reached the DropPolicy decides what is discarded.
+     */
     class PDUBuffer : public Object,
     protected ns3::nnn::nnnSIM::trie_with_policy<
       NNNAddress,
@@ -51,6 +64,16 @@ namespace ns3
 	  ns3::nnn::nnnSIM::counting_policy_traits
       > super;
 
+      /**
+       * @brief What to discard when a PDU does not fit
+       */
+      enum DropPolicy
+      {
+	DROP_TAIL,            ///< @brief Discard the arriving PDU
+	DROP_HEAD,            ///< @brief Discard the oldest PDUs of the destination
+	DROP_OLDEST_EXPIRED   ///< @brief Purge expired PDUs, then discard the PDUs expiring first
+      };
+
       static TypeId GetTypeId (void);
 
       PDUBuffer ();
@@ -102,6 +125,15 @@ namespace ns3
       std::queue<Ptr<Packet> >
       PopQueue (Ptr<NNNAddress> addr);
 
+      /**
+       * @brief Move the PDUs buffered for addr which have not expired into
+       * pdus, leaving the destination with an empty queue
+       *
+       * @returns number of PDUs placed in pdus
+       */
+      uint32_t
+      PopQueue (const NNNAddress &addr, std::vector<Ptr<Packet> > &pdus);
+
       uint
       QueueSize (const NNNAddress &addr);
 
@@ -114,8 +146,91 @@ namespace ns3
       Time
       GetReTX () const;
 
+      /**
+       * @brief Number of PDUs held for all destinations
+       */
+      uint32_t
+      GetTotalPackets () const;
+
+      /**
+       * @brief Number of bytes held for all destinations
+       */
+      uint32_t
+      GetTotalBytes () const;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      void
+      Push (const NNNAddress &addr, Ptr<Packet> pdu);
+
+      /**
+       * @brief Check if a PDU of size bytes fits in queue and in the buffer
+       */
+      bool
+      Fits (Ptr<PDUQueue> queue, uint32_t size) const;
+
+      Ptr<Packet>
+      PopFront (Ptr<PDUQueue> queue);
+
+      /**
+       * @brief Discard the expired PDUs at the head of queue
+       */
+      void
+      PurgeExpired (const NNNAddress &addr, Ptr<PDUQueue> queue);
+
+      /**
+       * @brief Discard the expired PDUs of all destinations
+       *
+       * @returns earliest expiry of the PDUs left, Time::Max () if none
+       */
+      Time
+      PurgeAll ();
+
+      /**
+       * @brief Discard the PDU expiring first to make room for size bytes in queue
+       *
+       * Looks in queue alone when it is over its per destination limits,
+       * otherwise in every destination of the buffer
+       *
+       * @returns false if there was no PDU left to discard
+       */
+      bool
+      DropOldest (const NNNAddress &addr, Ptr<PDUQueue> queue, uint32_t size);
+
+      /**
+       * @brief Rebuild the 3N name of a trie node from its components
+       */
+      static NNNAddress
+      AddressOf (super::parent_trie::const_iterator node);
+
+      /**
+       * @brief Periodic purge, rescheduled while PDUs are held
+       */
+      void
+      PurgeTimeout ();
+
+      void
+      SchedulePurge (Time expiry);
+
     private:
       Time m_retx;
+
+      uint32_t m_maxPackets;       ///< @brief Per destination PDU limit
+      uint32_t m_maxBytes;         ///< @brief Per destination byte limit
+      uint32_t m_maxTotalPackets;  ///< @brief Whole buffer PDU limit
+      uint32_t m_maxTotalBytes;    ///< @brief Whole buffer byte limit
+      DropPolicy m_policy;
+
+      TracedValue<uint32_t> m_totalPackets;
+      TracedValue<uint32_t> m_totalBytes;
+
+      EventId m_purgeEvent;
+
+      TracedCallback<Ptr<const Packet>, const NNNAddress &> m_dropTrace;    ///< @brief PDU discarded by a limit
+      TracedCallback<Ptr<const Packet>, const NNNAddress &> m_expireTrace;  ///< @brief PDU discarded on expiry
     };
 
     std::ostream& operator<< (std::ostream& os, const PDUBuffer &buffer);
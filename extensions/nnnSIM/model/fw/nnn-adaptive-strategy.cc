@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-adaptive-strategy.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-adaptive-strategy.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-adaptive-strategy.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-adaptive-strategy.h"
+#include "nnn-fw-tag.h"
+
+#include "../nnst/nnn-nnst.h"
+#include "../nnst/nnn-nnst-entry.h"
+#include "../nnst/nnn-nnst-entry-facemetric.h"
+#include "../pit/nnn-pit-entry.h"
+#include "../pit/nnn-pit-entry-outgoing-face.h"
+
+#include <ns3-dev/ns3/double.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/string.h>
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (AdaptiveStrategy);
+
+    NS_LOG_COMPONENT_DEFINE (AdaptiveStrategy::GetLogName ().c_str ());
+
+    namespace fw
+    {
+      /**
+       * @brief NNST entry used for each Face an Interest was sent through,
+       * and the candidate order of the Interest being propagated
+       */
+      class NNSTRouteTag : public Tag
+      {
+      public:
+	std::map<Ptr<Face>, Ptr<const NNNAddress> > m_routes;
+
+	/// @brief Ranked (and possibly rotated for a probe) candidates, built on skip 0
+	std::vector<std::pair<Ptr<Face>, Address> > m_order;
+	/// @brief NNST entry the candidates in m_order come from
+	Ptr<const NNNAddress> m_orderEntry;
+      };
+    }
+
+    namespace
+    {
+      /**
+       * Order of the NNST candidates: status first, then the measured
+       * Faces by smoothed RTT and last the Faces without measurements
+       */
+      bool
+      CompareByRtt (const nnst::FaceMetric *a, const nnst::FaceMetric *b)
+      {
+	if (a->GetStatus () != b->GetStatus ())
+	  return a->GetStatus () < b->GetStatus ();
+
+	if (a->GetSRtt ().IsZero () || b->GetSRtt ().IsZero ())
+	  return !a->GetSRtt ().IsZero () && b->GetSRtt ().IsZero ();
+
+	return a->GetSRtt () < b->GetSRtt ();
+      }
+
+      bool
+      IsProbeCandidate (const nnst::FaceMetric *m)
+      {
+	return m->GetStatus () == nnst::FaceMetric::NNN_NNST_YELLOW ||
+	    (m->GetStatus () == nnst::FaceMetric::NNN_NNST_GREEN && m->GetSRtt ().IsZero ());
+      }
+    }
+
+    TypeId
+    AdaptiveStrategy::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::AdaptiveStrategy")
+	  .SetGroupName ("Nnn")
+	  .SetParent<ForwardingStrategy> ()
+	  .AddConstructor<AdaptiveStrategy> ()
+	  .AddAttribute ("ProbeProbability", "Probability of sending a DO or DU Interest through a YELLOW or unmeasured Face first",
+	                 StringValue ("0.05"),
+	                 MakeDoubleAccessor (&AdaptiveStrategy::m_probeProbability),
+	                 MakeDoubleChecker<double> (0.0, 1.0))
+	  ;
+      return tid;
+    }
+
+    std::string
+    AdaptiveStrategy::GetLogName ()
+    {
+      return super::GetLogName () + ".Adaptive";
+    }
+
+    AdaptiveStrategy::AdaptiveStrategy ()
+    : m_probeProbability (0.05)
+    , m_rand             (0.0, 1.0)
+    {
+    }
+
+    AdaptiveStrategy::~AdaptiveStrategy ()
+    {
+    }
+
+    void
+    AdaptiveStrategy::RankCandidates (const NNNAddress &dst, Ptr<nnst::Entry> entry, bool probe,
+                                      std::vector<std::pair<Ptr<Face>, Address> > &order)
+    {
+      // Start from the (status, routing cost) order so that equal RTTs
+      // keep preferring the cheaper route
+      std::vector<const nnst::FaceMetric *> ranked;
+      ranked.reserve (entry->m_faces.size ());
+      for (nnst::fmtr_set_by_metric::const_iterator i = entry->m_faces.get<nnst::i_metric> ().begin ();
+	  i != entry->m_faces.get<nnst::i_metric> ().end (); ++i)
+	{
+	  ranked.push_back (&*i);
+	}
+
+      std::stable_sort (ranked.begin (), ranked.end (), CompareByRtt);
+
+      // Once in a while give the first attempt to a Face we know little
+      // about. The rest keep their order, so the best Face is next
+      if (probe && ranked.size () > 1 && m_rand.GetValue () < m_probeProbability)
+	{
+	  std::vector<const nnst::FaceMetric *>::iterator candidate =
+	      std::find_if (ranked.begin () + 1, ranked.end (), IsProbeCandidate);
+
+	  if (candidate != ranked.end ())
+	    {
+	      NS_LOG_DEBUG ("Probing " << **candidate << " towards (" << dst << ")");
+	      std::rotate (ranked.begin (), candidate, candidate + 1);
+	    }
+	}
+
+      order.clear ();
+      order.reserve (ranked.size ());
+      for (std::vector<const nnst::FaceMetric *>::const_iterator i = ranked.begin ();
+	  i != ranked.end (); ++i)
+	{
+	  order.push_back (std::make_pair ((*i)->GetFace (), (*i)->GetAddress ()));
+	}
+    }
+
+    std::pair<Ptr<Face>, Address>
+    AdaptiveStrategy::SelectNextHop (const NNNAddress &dst, uint32_t skip, Ptr<pit::Entry> pitEntry)
+    {
+      NS_LOG_FUNCTION (this << dst << skip);
+
+      Ptr<nnst::Entry> entry = m_nnst->ClosestSector (dst);
+
+      if (entry == 0 || entry->m_faces.empty ())
+	return std::make_pair (Ptr<Face> (), Address ());
+
+      // Without a PIT entry there is nowhere to keep the order between
+      // attempts, so it has to be the same every time
+      if (pitEntry == 0)
+	{
+	  std::vector<std::pair<Ptr<Face>, Address> > order;
+	  RankCandidates (dst, entry, false, order);
+	  if (skip >= order.size ())
+	    return std::make_pair (Ptr<Face> (), Address ());
+	  return order[skip];
+	}
+
+      boost::shared_ptr<fw::NNSTRouteTag> tag = pitEntry->GetFwTag<fw::NNSTRouteTag> ();
+      if (!tag)
+	{
+	  tag = boost::make_shared<fw::NNSTRouteTag> ();
+	  pitEntry->AddFwTag (tag);
+	}
+
+      // Every Interest is propagated starting from skip 0. The order is
+      // computed once then, so that the later attempts of the same
+      // Interest go through each of the remaining candidates once
+      if (skip == 0 || tag->m_orderEntry == 0)
+	{
+	  RankCandidates (dst, entry, skip == 0, tag->m_order);
+	  tag->m_orderEntry = entry->GetAddressPtr ();
+	}
+
+      if (skip >= tag->m_order.size ())
+	return std::make_pair (Ptr<Face> (), Address ());
+
+      const std::pair<Ptr<Face>, Address> &chosen = tag->m_order[skip];
+
+      // Remember which NNST entry routed the Interest through this Face
+      tag->m_routes[chosen.first] = tag->m_orderEntry;
+
+      return chosen;
+    }
+
+    void
+    AdaptiveStrategy::WillSatisfyPendingInterest (Ptr<Face> inFace,
+                                                  Ptr<pit::Entry> pitEntry)
+    {
+      NS_LOG_FUNCTION (this);
+
+      boost::shared_ptr<fw::NNSTRouteTag> tag = pitEntry->GetFwTag<fw::NNSTRouteTag> ();
+
+      if (inFace != 0 && tag)
+	{
+	  std::map<Ptr<Face>, Ptr<const NNNAddress> >::iterator route = tag->m_routes.find (inFace);
+	  pit::Entry::out_iterator out = pitEntry->GetOutgoing ().find (inFace);
+
+	  if (route != tag->m_routes.end () && out != pitEntry->GetOutgoing ().end ())
+	    {
+	      // Retransmitted Interests give ambiguous samples, skip them
+	      if (out->m_retxCount == 0)
+		{
+		  Time sample = Simulator::Now () - out->m_sendTime;
+		  NS_LOG_DEBUG ("RTT sample " << sample.GetSeconds () << "s for (" << *route->second << ") via " << *inFace);
+		  m_nnst->UpdateFaceRtt (*route->second, inFace, sample);
+		}
+
+	      m_nnst->UpdateStatus (*route->second, inFace, nnst::FaceMetric::NNN_NNST_GREEN);
+	    }
+	}
+
+      super::WillSatisfyPendingInterest (inFace, pitEntry);
+    }
+
+    void
+    AdaptiveStrategy::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
+    {
+      NS_LOG_FUNCTION (this);
+
+      boost::shared_ptr<fw::NNSTRouteTag> tag = pitEntry->GetFwTag<fw::NNSTRouteTag> ();
+
+      if (tag)
+	{
+	  for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
+	      face != pitEntry->GetOutgoing ().end ();
+	      face++)
+	    {
+	      std::map<Ptr<Face>, Ptr<const NNNAddress> >::iterator route = tag->m_routes.find (face->m_face);
+
+	      if (route != tag->m_routes.end ())
+		m_nnst->UpdateStatus (*route->second, face->m_face, nnst::FaceMetric::NNN_NNST_YELLOW);
+	    }
+	}
+
+      super::WillEraseTimedOutPendingInterest (pitEntry);
+    }
+  } // namespace nnn
+} // namespace ns3
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-adaptive-strategy.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-adaptive-strategy.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-adaptive-strategy.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_ADAPTIVE_STRATEGY_H_
+#define NNN_ADAPTIVE_STRATEGY_H_
+
+#include <ns3-dev/ns3/random-variable.h>
+
+#include "nnn-forwarding-strategy.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-fw
+     * @brief Forwarding strategy choosing DO and DU next hops by measured RTT
+     *
+     * Every DO or DU Interest remembers the NNST entry that routed it. When
+     * the Data comes back, the round trip time is fed to the NNST FaceMetric
+     * of that entry and the Face is marked GREEN, when the PIT entry times
+     * out the Faces used are marked YELLOW.
+     *
+     * Next hops are ranked by status, then by smoothed RTT, with the Faces
+     * not yet measured after the measured ones. With probability
+     * ProbeProbability a YELLOW or unmeasured Face is tried first, so that
+     * a recovered or new path gets the chance to prove itself faster. The
+     * order is decided once per Interest, so a failed probe falls back to
+     * the best Face and every candidate is attempted at most once.
+     *
+     * Select it with
+     * NNNStackHelper::SetForwardingStrategy ("ns3::nnn::AdaptiveStrategy")
+     */
+    class AdaptiveStrategy : public ForwardingStrategy
+    {
+    private:
+      typedef ForwardingStrategy super;
+
+    public:
+      static TypeId
+      GetTypeId ();
+
+      /**
+       * @brief Helper function to retrieve logging name for the forwarding strategy
+       */
+      static std::string
+      GetLogName ();
+
+      AdaptiveStrategy ();
+
+      virtual
+      ~AdaptiveStrategy ();
+
+      virtual void
+      WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry);
+
+    protected:
+      virtual void
+      WillSatisfyPendingInterest (Ptr<Face> inFace,
+                                  Ptr<pit::Entry> pitEntry);
+
+      virtual std::pair<Ptr<Face>, Address>
+      SelectNextHop (const NNNAddress &dst,
+                     uint32_t skip,
+                     Ptr<pit::Entry> pitEntry);
+
+    private:
+      /**
+       * @brief Fill order with the candidates of entry, best first
+       * @param probe whether a YELLOW or unmeasured Face may be put first
+       */
+      void
+      RankCandidates (const NNNAddress &dst, Ptr<nnst::Entry> entry, bool probe,
+                      std::vector<std::pair<Ptr<Face>, Address> > &order);
+
+    private:
+      double m_probeProbability;   ///< @brief Probability of trying a YELLOW or unmeasured Face first
+      UniformVariable m_rand;      ///< @brief Random numbers for probing
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* NNN_ADAPTIVE_STRATEGY_H_ */
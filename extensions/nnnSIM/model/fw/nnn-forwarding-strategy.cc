@@ -27,6 +27,8 @@
 
 #include "../nnn-pdus.h"
 #include "../nnn-nnnsim-wire.h"
+#include "../nnn-net-device-face.h"
+#include "nnn-pdu-traits.h"
 
 #include "../pit/nnn-pit.h"
 #include "../pit/nnn-pit-entry.h"
@@ -44,6 +46,7 @@
 #include "../buffers/nnn-pdu-buffer.h"
 #include "../addr-aggr/nnn-addr-aggregator.h"
 #include "../../helper/nnn-header-helper.h"
+#include "../../utils/nnn-lease-wheel.h"
 
 #include "../../helper/nnn-face-container.h"
 
@@ -63,20 +66,25 @@
 
 #include <ns3-dev/ns3/assert.h>
 #include <ns3-dev/ns3/boolean.h>
+#include <ns3-dev/ns3/data-rate.h>
+#include <ns3-dev/ns3/double.h>
 #include <ns3-dev/ns3/integer.h>
 #include <ns3-dev/ns3/log.h>
 #include <ns3-dev/ns3/node.h>
 #include <ns3-dev/ns3/object-base.h>
+#include <ns3-dev/ns3/pointer.h>
 #include <ns3-dev/ns3/ptr.h>
 #include <ns3-dev/ns3/simulator.h>
 #include <ns3-dev/ns3/string.h>
 #include <ns3-dev/ns3/type-id.h>
+#include <ns3-dev/ns3/uinteger.h>
 #include <ns3-dev/ns3/trace-source-accessor.h>
 #include <ns3-dev/ns3/nstime.h>
 
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iterator>
 #include <map>
@@ -237,6 +245,29 @@ namespace ns3
 	                 MakeTimeAccessor (&ForwardingStrategy::m_ack_timeout),
 	                 MakeTimeChecker ())
 
+	  .AddAttribute ("EnrollBackoffMultiplier",
+	                 "Factor by which the time between EN or REN retransmissions grows after each attempt, starting from AckTimeout",
+	                 DoubleValue (2.0),
+	                 MakeDoubleAccessor (&ForwardingStrategy::m_enroll_backoff_multiplier),
+	                 MakeDoubleChecker<double> (1.0))
+
+	  .AddAttribute ("EnrollBackoffMax", "Largest time between EN or REN retransmissions",
+	                 StringValue ("16s"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_enroll_backoff_max),
+	                 MakeTimeChecker ())
+
+	  .AddAttribute ("EnrollJitter",
+	                 "Fraction by which each time between EN or REN retransmissions is randomly shortened or lengthened",
+	                 DoubleValue (0.5),
+	                 MakeDoubleAccessor (&ForwardingStrategy::m_enroll_jitter),
+	                 MakeDoubleChecker<double> (0.0, 1.0))
+
+	  .AddAttribute ("EnrollAggregation",
+	                 "Window during which received ENs and RENs are gathered and then answered together (0 answers each at once)",
+	                 StringValue ("0s"),
+	                 MakeTimeAccessor (&ForwardingStrategy::m_enroll_window),
+	                 MakeTimeChecker ())
+
 	  .AddAttribute ("StandardMetric", "Standard Metric in NNST for new entries (Only in use if Produce3NNames is used)",
 	                 IntegerValue (6),
 	                 MakeIntegerAccessor (&ForwardingStrategy::m_standardMetric),
@@ -248,6 +279,37 @@ namespace ns3
 	                 MakeTimeAccessor (&ForwardingStrategy::GetRetxTimer, &ForwardingStrategy::SetRetxTimer),
 	                 MakeTimeChecker ())
 
+	  .AddAttribute ("FlushBurst",
+	                 "Number of buffered PDUs sent back to back when flushing the buffer for a new 3N name (0 sends all at once)",
+	                 StringValue ("8"),
+	                 MakeUintegerAccessor (&ForwardingStrategy::m_flush_burst),
+	                 MakeUintegerChecker<uint32_t> ())
+
+	  .AddAttribute ("FlushRate",
+	                 "Rate at which buffer flush bursts are paced (0 uses the DataRate of the outgoing device)",
+	                 StringValue ("0bps"),
+	                 MakeDataRateAccessor (&ForwardingStrategy::m_flush_rate),
+	                 MakeDataRateChecker ())
+
+	  .AddAttribute ("Multipath",
+	                 "Spread DO and DU flows over all the GREEN next hops of an NNST entry, weighted by routing cost",
+	                 BooleanValue (false),
+	                 MakeBooleanAccessor (&ForwardingStrategy::m_multipath),
+	                 MakeBooleanChecker ())
+
+	  .AddTraceSource ("MultipathSplit", "Traces the NNST entry, Face and number of decisions for that Face of each multipath decision",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_multipathSplit))
+
+	  .AddAttribute ("PDUBuffer",
+	                 "Buffer of the PDUs headed to 3N names leaving the node, for its limits and traces",
+	                 TypeId::ATTR_GET,
+	                 PointerValue (),
+	                 MakePointerAccessor (&ForwardingStrategy::m_node_pdu_buffer),
+	                 MakePointerChecker<PDUBuffer> ())
+
+	  .AddTraceSource ("BufferFlushed", "Traces the PDUs, bytes and time taken by each flush of the PDU buffer",
+			   MakeTraceSourceAccessor (&ForwardingStrategy::m_flushed))
+
 	  .AddTraceSource ("Got3NName", "Traces when the forwarding strategy has a 3N name",
 			   MakeTraceSourceAccessor (&ForwardingStrategy::m_got3Nname))
 
@@ -265,10 +327,18 @@ namespace ns3
     , m_faces                (Create<FaceContainer> ())
     , m_node_names           (Create<NamesContainer> ())
     , m_leased_names         (Create<NamesContainer> ())
-    , m_node_pdu_buffer      (Create<PDUBuffer> ())
+    , m_node_name_version    (0)
+    , m_node_pdu_buffer      (CreateObject<PDUBuffer> ())
+    , m_flush_burst          (8)
+    , m_multipath            (false)
     , m_producedNameNumber   (0)
     , m_sent_ren             (false)
     , m_on_ren_oen           (false)
+    , m_enroll_backoff_multiplier (2.0)
+    , m_enroll_jitter        (0.5)
+    , m_enroll_rand          (0.0, 1.0)
+    , m_enroll_attempt       (0)
+    , m_reenroll_attempt     (0)
     {
       m_node_names->RegisterCallbacks(
 	  MakeCallback (&ForwardingStrategy::Reenroll, this),
@@ -297,13 +367,20 @@ namespace ns3
     const NNNAddress&
     ForwardingStrategy::GetNode3NName ()
     {
-      return *m_node_names->findNewestName();
+      return *GetNode3NNamePtr ();
     }
 
     Ptr<const NNNAddress>
     ForwardingStrategy::GetNode3NNamePtr ()
     {
-      return m_node_names->findNewestName();
+      // Only look in the container again once a name was added, removed
+      // or had its lease changed (enroll, reenroll, lease expiry)
+      if (m_node_name == 0 || m_node_name_version != m_node_names->GetVersion ())
+	{
+	  m_node_name = m_node_names->findNewestName ();
+	  m_node_name_version = m_node_names->GetVersion ();
+	}
+      return m_node_name;
     }
 
     Ptr<NNNAddress>
@@ -376,100 +453,232 @@ namespace ns3
       return m_node_pdu_buffer->GetReTX();
     }
 
+    Ptr<PDUBuffer>
+    ForwardingStrategy::GetPDUBuffer () const
+    {
+      return m_node_pdu_buffer;
+    }
+
     void
     ForwardingStrategy::flushBuffer(Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName)
     {
       NS_LOG_FUNCTION (this << face->GetId () << *oldName << " to " << *newName);
-      NNNAddress myAddr = GetNode3NName ();
       if (m_node_pdu_buffer->DestinationExists(oldName))
 	{
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") found a queue for (" << *oldName << "), attempting to flush");
+
+	  Ptr<FlushJob> job = Create<FlushJob> ();
+	  job->oldName = oldName;
+	  job->newName = newName;
+	  job->next = 0;
+	  job->start = Simulator::Now ();
+	  job->bytes = 0;
+	  job->do_flush = 0;
+	  job->du_flush = 0;
+
+	  // The PDUs still valid for oldName
+	  m_node_pdu_buffer->PopQueue(*oldName, job->pdus);
+	  // Make sure we delete the entry for oldName in the buffer
+	  m_node_pdu_buffer->RemoveDestination(oldName);
+
+	  // Everything buffered for oldName now goes towards newName, so the
+	  // next hop is looked up once for the whole flush. With multipath it
+	  // only paces the flush, FlushPDU spreads the flows themselves
+	  std::pair<Ptr<Face>, Address> closestSector = m_nnst->ClosestSectorFaceInfo(newName, 0);
+	  job->face = closestSector.first;
+	  job->addr = closestSector.second;
+	  job->rate = GetFlushRate (job->face);
 
-	  NS_LOG_INFO ("On (" << myAddr << ") found a queue for (" << *oldName << "), attempting to flush");
-	  // The actual queue
-	  std::queue<Ptr<Packet> > addrQueue = m_node_pdu_buffer->PopQueue(oldName);
+	  m_flush_jobs.push_back (job);
+	  FlushBurst (job);
+	}
+      else
+	{
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") no buffer found for (" << *oldName << "), continuing");
+	}
+    }
 
-	  // Dummy Pointers to the PDU types
-	  Ptr<DO> do_o_orig;
-	  Ptr<DU> du_o_orig;
+    void
+    ForwardingStrategy::FlushBurst (Ptr<FlushJob> job)
+    {
+      NS_LOG_FUNCTION (this << *job->oldName << " to " << *job->newName);
 
-	  uint32_t do_flush = 0;
-	  uint32_t du_flush = 0;
+      size_t burst = job->pdus.size () - job->next;
+      if (m_flush_burst != 0 && burst > m_flush_burst)
+	burst = m_flush_burst;
 
-	  std::pair<Ptr<Face>, Address> closestSector;
+      uint32_t burstBytes = 0;
+      for (size_t i = 0; i < burst; i++)
+	{
+	  Ptr<Packet> queuePDU = job->pdus[job->next];
+	  // Release the PDU as soon as it is sent
+	  job->pdus[job->next] = 0;
+	  job->next++;
 
-	  Ptr<Face> outFace;
-	  Address destAddr;
+	  burstBytes += FlushPDU (job, queuePDU);
+	}
+      job->bytes += burstBytes;
+
+      if (job->next < job->pdus.size ())
+	{
+	  // Wait for the burst to leave the link before sending the next one
+	  Time gap = Seconds (0);
+	  if (job->rate.GetBitRate () != 0)
+	    gap = Seconds (job->rate.CalculateTxTime (burstBytes));
+
+	  job->event = Simulator::Schedule (gap, &ForwardingStrategy::FlushBurst, this, job);
+	  return;
+	}
+
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") flushed (" << *job->oldName << ") -> (" << *job->newName << ") <->  DO: " << job->do_flush << " DU: " << job->du_flush );
+
+      m_flushed (job->oldName, job->newName, job->do_flush + job->du_flush, job->bytes, Simulator::Now () - job->start);
+      m_flush_jobs.remove (job);
+    }
+
+    uint32_t
+    ForwardingStrategy::FlushPDU (Ptr<FlushJob> job, Ptr<Packet> queuePDU)
+    {
+      // Dummy Pointers to the PDU types
+      Ptr<DO> do_o_orig;
+      Ptr<DU> du_o_orig;
+
+      Ptr<Face> outFace = job->face;
+      Address destAddr = job->addr;
+      std::pair<Ptr<Face>, Address> nextHop;
+
+      uint32_t size = queuePDU->GetSize ();
+
+      switch(HeaderHelper::GetNNNHeaderType(queuePDU))
+      {
+	case DO_NNN:
+	  // Renew the DO lifetime and change the DO 3N name to the new
+	  // name directly on the buffered wire format
+	  wire::nnnSIM::DO::Rewrite (queuePDU, *job->newName, m_3n_lifetime);
+	  // Convert the Packet back to a DO, the patched packet becomes its wire
+	  do_o_orig = wire::nnnSIM::DO::FromWire (Ptr<const Packet> (queuePDU));
 
-	  while (!addrQueue.empty())
+	  if (m_multipath)
 	    {
-	      // Get the PDU at the front of the queue
-	      Ptr<Packet> queuePDU = addrQueue.front();
+	      nextHop = FlowNextHop (*job->newName, PayloadFlow (do_o_orig->GetPayload (), do_o_orig->GetPDUPayloadType ()), 0);
+	      outFace = nextHop.first;
+	      destAddr = nextHop.second;
+	    }
 
-	      switch(HeaderHelper::GetNNNHeaderType(queuePDU))
-	      {
-		case DO_NNN:
-		  // Convert the Packet back to a DO for manipulation
-		  do_o_orig = wire::nnnSIM::DO::FromWire(queuePDU);
-
-		  // Renew the DO lifetime
-		  do_o_orig->SetLifetime(m_3n_lifetime);
-		  // Change the DO 3N name to the new name
-		  do_o_orig->SetName(newName);
-
-		  // Find where to send the SO
-		  closestSector = m_nnst->ClosestSectorFaceInfo(newName, 0);
-
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
-
-		  // Send the created DO PDU
-		  outFace->SendDO(do_o_orig, destAddr);
-		  // Log the DO sending
-		  m_outDOs(do_o_orig, outFace);
-		  do_flush++;
-		  break;
-		case DU_NNN:
-		  // Convert the Packet back to a DU for manipulation
-		  du_o_orig = wire::nnnSIM::DU::FromWire(queuePDU);
-
-		  // Renew the DU lifetime
-		  du_o_orig->SetLifetime(m_3n_lifetime);
-
-		  // Change the DU 3N names to the new names if necessary
-		  if (du_o_orig->GetDstName() == *oldName)
-		    du_o_orig->SetDstName(newName);
-
-		  if (du_o_orig->GetSrcName() == *oldName)
-		    du_o_orig->SetSrcName(newName);
-
-		  // Find where to send the DU
-		  closestSector = m_nnst->ClosestSectorFaceInfo(du_o_orig->GetDstNamePtr(), 0);
-
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
-
-		  // Send the created DU PDU
-		  outFace->SendDU(du_o_orig, destAddr);
-		  // Log the DU sending
-		  m_outDUs(du_o_orig, outFace);
-		  du_flush++;
-		  break;
-		default:
-		  NS_LOG_INFO("Obtained unknown PDU");
-	      }
-	      // Pop the queue and continue
-	      addrQueue.pop ();
+	  if (outFace == 0)
+	    {
+	      NS_LOG_INFO ("No route to (" << *job->newName << "), dropping DO");
+	      m_dropDOs (do_o_orig, outFace);
+	      return 0;
 	    }
 
-	  // Make sure we delete the entry for oldName in the buffer
-	  m_node_pdu_buffer->RemoveDestination(oldName);
+	  // Send the created DO PDU
+	  outFace->SendDO(do_o_orig, destAddr);
+	  // Log the DO sending
+	  m_outDOs(do_o_orig, outFace);
+	  job->do_flush++;
+	  return size;
+	case DU_NNN:
+	  // Convert the Packet back to a DU for manipulation, keeping the
+	  // buffered packet as its wire
+	  du_o_orig = wire::nnnSIM::DU::FromWire (Ptr<const Packet> (queuePDU));
 
-	  NS_LOG_INFO ("On (" << myAddr << ") flushed (" << *oldName << ") -> (" << *newName << ") <->  DO: " << do_flush << " DU: " << du_flush );
-	}
-      else
+	  // Change the DU 3N names to the new names if necessary
+	  if (du_o_orig->GetSrcName() == *job->oldName)
+	    {
+	      // The Src name is not covered by the header patch
+	      du_o_orig->SetLifetime(m_3n_lifetime);
+	      du_o_orig->SetSrcName(job->newName);
+
+	      if (du_o_orig->GetDstName() == *job->oldName)
+		du_o_orig->SetDstName(job->newName);
+	    }
+	  else if (du_o_orig->GetDstName() == *job->oldName)
+	    du_o_orig = Wire::RedirectDU (du_o_orig, *job->newName, m_3n_lifetime);
+	  else
+	    du_o_orig->SetLifetime(m_3n_lifetime);
+
+	  // Only DUs that did not go to oldName need their own lookup, unless
+	  // the flows are spread over several next hops
+	  if (m_multipath || du_o_orig->GetDstName() != *job->newName)
+	    {
+	      ndn::Name flow;
+	      if (m_multipath)
+		flow = PayloadFlow (du_o_orig->GetPayload (), du_o_orig->GetPDUPayloadType ());
+
+	      nextHop = FlowNextHop (du_o_orig->GetDstName (), flow, 0);
+	      outFace = nextHop.first;
+	      destAddr = nextHop.second;
+	    }
+
+	  if (outFace == 0)
+	    {
+	      NS_LOG_INFO ("No route to (" << du_o_orig->GetDstName () << "), dropping DU");
+	      m_dropDUs (du_o_orig, outFace);
+	      return 0;
+	    }
+
+	  // Send the created DU PDU
+	  outFace->SendDU(du_o_orig, destAddr);
+	  // Log the DU sending
+	  m_outDUs(du_o_orig, outFace);
+	  job->du_flush++;
+	  return size;
+	default:
+	  NS_LOG_INFO("Obtained unknown PDU");
+	  return 0;
+      }
+    }
+
+    ndn::Name
+    ForwardingStrategy::PayloadFlow (Ptr<const Packet> payload, uint16_t payloadType) const
+    {
+      if (payloadType != NDN_NNN || payload == 0)
+	return ndn::Name ();
+
+      // Decoding strips the headers, so it works on a copy
+      Ptr<Packet> decode = payload->Copy ();
+
+      try {
+	  switch (ndn::HeaderHelper::GetNdnHeaderType (payload))
+	  {
+	    case ndn::HeaderHelper::INTEREST_NDNSIM:
+	      return ndn::Wire::ToInterest (decode, ndn::Wire::WIRE_FORMAT_NDNSIM)->GetName ();
+	    case ndn::HeaderHelper::INTEREST_CCNB:
+	      return ndn::Wire::ToInterest (decode, ndn::Wire::WIRE_FORMAT_CCNB)->GetName ();
+	    case ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM:
+	      return ndn::Wire::ToData (decode, ndn::Wire::WIRE_FORMAT_NDNSIM)->GetName ();
+	    case ndn::HeaderHelper::CONTENT_OBJECT_CCNB:
+	      return ndn::Wire::ToData (decode, ndn::Wire::WIRE_FORMAT_CCNB)->GetName ();
+	    default:
+	      break;
+	  }
+      }
+      catch (ndn::UnknownHeaderException)
+      {
+	  NS_LOG_DEBUG ("Buffered payload is not an NDN PDU");
+      }
+
+      return ndn::Name ();
+    }
+
+    DataRate
+    ForwardingStrategy::GetFlushRate (Ptr<Face> face) const
+    {
+      if (m_flush_rate.GetBitRate () != 0 || face == 0)
+	return m_flush_rate;
+
+      DataRate rate = m_flush_rate;
+
+      Ptr<NetDeviceFace> devFace = DynamicCast<NetDeviceFace> (face);
+      if (devFace != 0)
 	{
-	  NS_LOG_INFO ("On (" << myAddr << ") no buffer found for (" << *oldName << "), continuing");
+	  DataRateValue value;
+	  if (devFace->GetNetDevice ()->GetAttributeFailSafe ("DataRate", value))
+	    rate = value.Get ();
 	}
+
+      return rate;
     }
 
     void
@@ -482,59 +691,69 @@ namespace ns3
       // Find if we can produce 3N names
       if (m_produce3Nnames && Has3NName ())
 	{
-	  NNNAddress myAddr = GetNode3NName ();
-	  NS_LOG_INFO("On (" << myAddr << ") producing 3N name for new node");
-
-	  // Get the first Address from the EN PDU (this probably requires more tuning)
-	  Address destAddr = en_p->GetOnePoa(0);
-
-	  NS_LOG_INFO ("On (" << myAddr << "), will return OEN to " << destAddr);
-
-	  // Get all the PoA Address in the EN PDU to fill the NNST
-	  std::vector<Address> poaAddrs = en_p->GetPoas();
-
-	  NS_LOG_INFO ("Received PoA Names: ");
-	  for (int i = 0; i < poaAddrs.size (); i++)
-	    {
-	      NS_LOG_INFO (i << ": " << poaAddrs[i]);
-	    }
-
-	  // Produce a 3N name
-	  Ptr<NNNAddress> produced3Nname = produce3NName ();
+	  if (m_enroll_window.IsStrictlyPositive ())
+	    QueueEnrollment (face, en_p, 0);
+	  else
+	    AnswerEN (face, en_p, GetAllPoANames (face));
+	}
+      else
+	{
+	  m_dropENs (en_p, face);
+	}
+    }
 
-	  // Add the new information into the Awaiting Response NNST type structure
-	  // Create a 5 second timeout - remember absolute time
-	  m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
+    void
+    ForwardingStrategy::AnswerEN (Ptr<Face> face, Ptr<EN> en_p, const std::vector<Address> &personalPoas)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
 
-	  NS_LOG_INFO ("On (" << myAddr << ") creating OEN PDU to send");
-	  // Create an OEN PDU to respond
-	  Ptr<OEN> oen_p = Create<OEN> (produced3Nname);
-	  oen_p->SetLifetime(m_3n_lifetime);
-	  // Ensure that the lease time is set in the PDU
-	  // We send the lease out in absolute simulator time
-	  Time absoluteLease = Simulator::Now () + m_3n_lease_time;
-	  oen_p->SetLeasetime(absoluteLease);
-	  // Add the PoA names to the PDU
-	  oen_p->AddPoa(poaAddrs);
-	  // Add my name to the PDU
-	  oen_p->SetSrcName (GetNode3NName ());
-	  // Add personal PoAs
-	  oen_p->AddPersonalPoa (GetAllPoANames (face));
+      NS_LOG_INFO("On (" << GetNode3NName () << ") producing 3N name for new node");
 
-	  // Send the create OEN PDU out the way it came
-	  face->SendOEN(oen_p, destAddr);
+      // Get the first Address from the EN PDU (this probably requires more tuning)
+      Address destAddr = en_p->GetOnePoa(0);
 
-	  NS_LOG_INFO ("Making a lease entry in (" << myAddr << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds());
+      NS_LOG_INFO ("On (" << GetNode3NName () << "), will return OEN to " << destAddr);
 
-	  // Maintain the lease time given to the 3N name for further checking
-	  m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+      // Get all the PoA Address in the EN PDU to fill the NNST
+      std::vector<Address> poaAddrs = en_p->GetPoas();
 
-	  m_outOENs (oen_p, face);
-	}
-      else
+      NS_LOG_INFO ("Received PoA Names: ");
+      for (int i = 0; i < poaAddrs.size (); i++)
 	{
-	  m_dropENs (en_p, face);
+	  NS_LOG_INFO (i << ": " << poaAddrs[i]);
 	}
+
+      // Produce a 3N name
+      Ptr<NNNAddress> produced3Nname = produce3NName ();
+
+      // Add the new information into the Awaiting Response NNST type structure
+      // Create a 5 second timeout - remember absolute time
+      m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
+
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") creating OEN PDU to send");
+      // Create an OEN PDU to respond
+      Ptr<OEN> oen_p = Create<OEN> (produced3Nname);
+      oen_p->SetLifetime(m_3n_lifetime);
+      // Ensure that the lease time is set in the PDU
+      // We send the lease out in absolute simulator time
+      Time absoluteLease = Simulator::Now () + m_3n_lease_time;
+      oen_p->SetLeasetime(absoluteLease);
+      // Add the PoA names to the PDU
+      oen_p->AddPoa(poaAddrs);
+      // Add my name to the PDU
+      oen_p->SetSrcName (GetNode3NName ());
+      // Add personal PoAs
+      oen_p->AddPersonalPoa (personalPoas);
+
+      // Send the create OEN PDU out the way it came
+      face->SendOEN(oen_p, destAddr);
+
+      NS_LOG_INFO ("Making a lease entry in (" << GetNode3NName () << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds());
+
+      // Maintain the lease time given to the 3N name for further checking
+      m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+
+      m_outOENs (oen_p, face);
     }
 
     void
@@ -549,11 +768,11 @@ namespace ns3
 	{
 	  // Get the 3N name from the AEN
 	  NNNAddress tmp = aen_p->GetName ();
-	  NNNAddress myAddr = GetNode3NName ();
+	  Ptr<const NNNAddress> myAddr = GetNode3NNamePtr ();
 
-	  NS_LOG_INFO("On (" << myAddr << ") obtained AEN for (" << tmp << ")");
+	  NS_LOG_INFO("On (" << *myAddr << ") obtained AEN for (" << tmp << ")");
 	  // Assure that the name in the AEN is under the delegated 3N name
-	  if (myAddr == tmp.getSectorName ())
+	  if (*myAddr == tmp.getSectorName ())
 	    {
 	      // Check if we have this entry in the waiting list
 	      if (m_awaiting_response->FoundName(tmp))
@@ -599,7 +818,7 @@ namespace ns3
 			{
 			  Time recordedLeaseTime = it->second;
 
-			  NS_LOG_INFO ("Checking discrepancies between recorded time " << recordedLeaseTime << " and obtained time " << absoluteLeaseTime << " in (" << myAddr << ") for (" << tmp << ")");
+			  NS_LOG_INFO ("Checking discrepancies between recorded time " << recordedLeaseTime << " and obtained time " << absoluteLeaseTime << " in (" << *myAddr << ") for (" << tmp << ")");
 
 			  if (absoluteLeaseTime <= recordedLeaseTime)
 			    {
@@ -630,7 +849,7 @@ namespace ns3
 			  NS_LOG_INFO("Attempting to flush buffer");
 
 			  // Check if the Node was in our subsector
-			  if (! registeredOldName->isSubSector (myAddr))
+			  if (! registeredOldName->isSubSector (*myAddr))
 			    {
 			      // If node was not originally in our sector, create a INF PDU
 			      NS_LOG_INFO ("(" << *registeredOldName << ") was not in our sector, creating INF PDU");
@@ -665,7 +884,7 @@ namespace ns3
 		      // Add the new information to the NNST
 		      m_nnst->Add(newName, face, storedPoas, absoluteLeaseTime, m_standardMetric);
 
-		      NS_LOG_DEBUG ("On (" << myAddr << "): " << *m_nnst);
+		      NS_LOG_DEBUG ("On (" << *myAddr << "): " << *m_nnst);
 
 		      NS_LOG_INFO("Adding lease information for (" << tmp << ") until " << absoluteLeaseTime.GetSeconds ());
 		      // Add the information the the leased NodeNameContainer
@@ -711,59 +930,133 @@ namespace ns3
       // Check we can actually produce 3N names
       if(m_produce3Nnames && Has3NName ())
 	{
-	  NNNAddress myAddr = GetNode3NName ();
+	  if (m_enroll_window.IsStrictlyPositive ())
+	    QueueEnrollment (face, 0, ren_p);
+	  else
+	    AnswerREN (face, ren_p, GetAllPoANames (face));
+	}
+      else
+	{
+	  m_dropRENs (ren_p, face);
+	}
+    }
 
-	  // Get the 3N name that the node was using
-	  Ptr<const NNNAddress> reenroll = ren_p->GetNamePtr();
+    void
+    ForwardingStrategy::AnswerREN (Ptr<Face> face, Ptr<REN> ren_p, const std::vector<Address> &personalPoas)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
 
-	  NS_LOG_INFO("On (" << myAddr << ") producing 3N name for reenrolling node (" << *reenroll << ")");
+      // Get the 3N name that the node was using
+      Ptr<const NNNAddress> reenroll = ren_p->GetNamePtr();
 
-	  // Get the first Address from the REN PDU
-	  Address destAddr = ren_p->GetOnePoa(0);
+      NS_LOG_INFO("On (" << GetNode3NName () << ") producing 3N name for reenrolling node (" << *reenroll << ")");
 
-	  // Get all the PoA Address in the REN PDU to fill the NNST
-	  std::vector<Address> poaAddrs = ren_p->GetPoas ();
+      // Get the first Address from the REN PDU
+      Address destAddr = ren_p->GetOnePoa(0);
 
-	  // Produce a new 3N name
-	  Ptr<const NNNAddress> produced3Nname = produce3NName ();
+      // Get all the PoA Address in the REN PDU to fill the NNST
+      std::vector<Address> poaAddrs = ren_p->GetPoas ();
 
-	  // Add the new information into the Awaiting Response NNST type structure
-	  // Create a 5 second timeout - must be in absolute simulator time
-	  m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
+      // Produce a new 3N name
+      Ptr<const NNNAddress> produced3Nname = produce3NName ();
 
-	  NS_LOG_INFO("On (" << myAddr << ") creating OEN PDU to send");
-	  // Create an OEN PDU to respond
-	  Ptr<OEN> oen_p = Create<OEN> (produced3Nname->getName());
-	  oen_p->SetLifetime(m_3n_lifetime);
-	  // Ensure that the lease time is set in the PDU
-	  // We send the lease out in absolute simulator time
-	  Time absoluteLease = Simulator::Now () + m_3n_lease_time;
-	  oen_p->SetLeasetime(absoluteLease);
-	  // Add the PoA names to the PDU
-	  oen_p->AddPoa(poaAddrs);
-	  // Add my name to the PDU
-	  oen_p->SetSrcName (GetNode3NName ());
-	  // Add personal PoAs
-	  oen_p->AddPersonalPoa (GetAllPoANames (face));
+      // Add the new information into the Awaiting Response NNST type structure
+      // Create a 5 second timeout - must be in absolute simulator time
+      m_awaiting_response->Add(produced3Nname, face, poaAddrs, Simulator::Now () + m_3n_lease_ack_timeout, m_standardMetric);
 
-	  // Send the create OEN PDU out the way it came
-	  face->SendOEN(oen_p, destAddr);
+      NS_LOG_INFO("On (" << GetNode3NName () << ") creating OEN PDU to send");
+      // Create an OEN PDU to respond
+      Ptr<OEN> oen_p = Create<OEN> (produced3Nname->getName());
+      oen_p->SetLifetime(m_3n_lifetime);
+      // Ensure that the lease time is set in the PDU
+      // We send the lease out in absolute simulator time
+      Time absoluteLease = Simulator::Now () + m_3n_lease_time;
+      oen_p->SetLeasetime(absoluteLease);
+      // Add the PoA names to the PDU
+      oen_p->AddPoa(poaAddrs);
+      // Add my name to the PDU
+      oen_p->SetSrcName (GetNode3NName ());
+      // Add personal PoAs
+      oen_p->AddPersonalPoa (personalPoas);
 
-	  m_outOENs (oen_p, face);
+      // Send the create OEN PDU out the way it came
+      face->SendOEN(oen_p, destAddr);
 
-	  Time remaining = ren_p->GetRemainLease ();
-	  NS_LOG_INFO("On (" << myAddr << ") creating an NNPT entry for (" << *reenroll << ") -> (" << *produced3Nname << ") until " << remaining.GetSeconds ());
+      m_outOENs (oen_p, face);
 
-	  // Regardless of the name, we need to update the NNPT
-	  m_nnpt->addEntry (reenroll, produced3Nname, remaining);
+      Time remaining = ren_p->GetRemainLease ();
+      NS_LOG_INFO("On (" << GetNode3NName () << ") creating an NNPT entry for (" << *reenroll << ") -> (" << *produced3Nname << ") until " << remaining.GetSeconds ());
 
-	  NS_LOG_INFO ("Making a lease entry in (" << myAddr << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds ());
-	  // Maintain the lease time given to the 3N name for further checking
-	  m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
-	}
-      else
+      // Regardless of the name, we need to update the NNPT
+      m_nnpt->addEntry (reenroll, produced3Nname, remaining);
+
+      NS_LOG_INFO ("Making a lease entry in (" << GetNode3NName () << ") for (" <<*produced3Nname << ") until " << absoluteLease.GetSeconds ());
+      // Maintain the lease time given to the 3N name for further checking
+      m_node_lease_times[oen_p->GetNamePtr()] = absoluteLease;
+    }
+
+    void
+    ForwardingStrategy::QueueEnrollment (Ptr<Face> face, Ptr<EN> en_p, Ptr<REN> ren_p)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      // The OEN goes back to the first PoA of the PDU, which identifies the node
+      Address poa = (en_p != 0) ? en_p->GetOnePoa (0) : ren_p->GetOnePoa (0);
+      PendingEnrollment &pending = m_pending_enrollments[std::make_pair (face->GetId (), poa)];
+
+      // A retransmission from a node we have not answered yet replaces its
+      // earlier PDU, so it only gets one 3N name
+      if (pending.en != 0)
+	m_dropENs (pending.en, face);
+      if (pending.ren != 0)
+	m_dropRENs (pending.ren, face);
+
+      pending.face = face;
+      pending.en = en_p;
+      pending.ren = ren_p;
+
+      if (!m_enroll_flush.IsRunning ())
+	m_enroll_flush = Simulator::Schedule (m_enroll_window, &ForwardingStrategy::FlushEnrollments, this);
+    }
+
+    void
+    ForwardingStrategy::FlushEnrollments ()
+    {
+      NS_LOG_FUNCTION (this << m_pending_enrollments.size ());
+
+      std::map<std::pair<uint32_t, Address>, PendingEnrollment> pending;
+      pending.swap (m_pending_enrollments);
+
+      bool canAnswer = m_produce3Nnames && Has3NName ();
+
+      // The map is ordered by Face id, so the PoA names are computed once per Face
+      Ptr<Face> face;
+      std::vector<Address> personalPoas;
+      for (std::map<std::pair<uint32_t, Address>, PendingEnrollment>::iterator i = pending.begin ();
+	  i != pending.end ();
+	  ++i)
 	{
-	  m_dropRENs (ren_p, face);
+	  PendingEnrollment &p = i->second;
+
+	  if (!canAnswer)
+	    {
+	      if (p.en != 0)
+		m_dropENs (p.en, p.face);
+	      else
+		m_dropRENs (p.ren, p.face);
+	      continue;
+	    }
+
+	  if (p.face != face)
+	    {
+	      face = p.face;
+	      personalPoas = GetAllPoANames (face);
+	    }
+
+	  if (p.en != 0)
+	    AnswerEN (p.face, p.en, personalPoas);
+	  else
+	    AnswerREN (p.face, p.ren, personalPoas);
 	}
     }
 
@@ -774,29 +1067,30 @@ namespace ns3
 
       m_inDENs (den_p, face);
 
-      NNNAddress myAddr = GetNode3NName ();
+      Ptr<const NNNAddress> myAddr = GetNode3NNamePtr ();
       Ptr<NNNAddress> leavingAddr = Create<NNNAddress> (den_p->GetNamePtr ()->getName ());
 
-      NS_LOG_INFO ("On (" << myAddr << "), (" << *leavingAddr << ") is leaving");
+      NS_LOG_INFO ("On (" << *myAddr << "), (" << *leavingAddr << ") is leaving");
 
       // If the DEN packet arrives at a node that is less than 2 hops away, then we
       // forward the DEN packet to the parent of this node
-      if (leavingAddr->distance (myAddr) <= 2 && leavingAddr->isSubSector (myAddr))
+      if (leavingAddr->distance (*myAddr) <= 2 && leavingAddr->isSubSector (*myAddr))
 	{
 	  NS_LOG_INFO ("We can still attempt to propagate DEN");
 	  // Now we forward the DEN information to the higher hierarchical nodes
-	  std::vector<std::pair<Ptr<Face>, Address> > hierarchicalFaces = m_nnst->OneHopParentSectorFaceInfo (myAddr, 0);
-	  std::vector<std::pair<Ptr<Face>, Address> >::iterator it;
+	  // A sector has a single parent sector in the NNST
+	  std::pair<Ptr<Face>, Address> hierarchicalFaces[1];
+	  uint32_t numHierarchical = m_nnst->OneHopParentSectorFaceInfo (*myAddr, 0, hierarchicalFaces, 1);
 
 	  Ptr<Face> outFace;
 	  Address destAddr;
 	  bool propagated = false;
 	  bool ok = false;
 
-	  for (it = hierarchicalFaces.begin (); it != hierarchicalFaces.end (); ++it)
+	  for (uint32_t i = 0; i < numHierarchical; i++)
 	    {
-	      outFace = it->first;
-	      destAddr = it->second;
+	      outFace = hierarchicalFaces[i].first;
+	      destAddr = hierarchicalFaces[i].second;
 
 	      NS_LOG_INFO ("Pushing DEN out Face " << *outFace);
 
@@ -811,13 +1105,13 @@ namespace ns3
 	    }
 
 	  if (propagated)
-	    NS_LOG_INFO ("On (" << myAddr << ") found parent sectors to propagate DEN to");
+	    NS_LOG_INFO ("On (" << *myAddr << ") found parent sectors to propagate DEN to");
 	  else
-	    NS_LOG_INFO ("On (" << myAddr << ") no parent sectors to propagate DEN to, stopping propagation");
+	    NS_LOG_INFO ("On (" << *myAddr << ") no parent sectors to propagate DEN to, stopping propagation");
 	}
       else
 	{
-	  NS_LOG_INFO ("On (" << myAddr << ") we have left the sector and are too far, stopping propagation");
+	  NS_LOG_INFO ("On (" << *myAddr << ") we have left the sector and are too far, stopping propagation");
 	}
 
       NS_LOG_INFO ("Adding (" << *leavingAddr << ") to buffers");
@@ -954,23 +1248,24 @@ namespace ns3
       bool routed = false;
       bool propagated = false;
 
-      NNNAddress myAddr = GetNode3NName ();
+      Ptr<const NNNAddress> myAddr = GetNode3NNamePtr ();
 
       Ptr<NNNAddress> oldName = Create<NNNAddress> (inf_p->GetOldName ());
       Ptr<NNNAddress> newName = Create<NNNAddress> (inf_p->GetNewName ());
 
       NNNAddress endSector = inf_p->GetOldNamePtr ()->getSectorName ();
 
-      if (myAddr != endSector)
+      if (*myAddr != endSector)
 	{
-	  NS_LOG_INFO("On (" << myAddr << ") have not yet reached sector. Attempting to forward to (" << endSector << ")");
+	  NS_LOG_INFO("On (" << *myAddr << ") have not yet reached sector. Attempting to forward to (" << endSector << ")");
 
 	  // Roughly pick the next hop that would bring us closer to the endSector
 	  std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (endSector, 0);
 
 	  // Just like with DEN, we need to inform our higher ups that things have changed in this sector
-	  std::vector<std::pair<Ptr<Face>, Address> > hierarchicalFaces = m_nnst->OneHopParentSectorFaceInfo (myAddr, 0);
-	  std::vector<std::pair<Ptr<Face>, Address> >::iterator it;
+	  // A sector has a single parent sector in the NNST
+	  std::pair<Ptr<Face>, Address> hierarchicalFaces[1];
+	  uint32_t numHierarchical = m_nnst->OneHopParentSectorFaceInfo (*myAddr, 0, hierarchicalFaces, 1);
 
 	  Ptr<Face> outFace;
 	  // First send out the routed Face
@@ -988,16 +1283,16 @@ namespace ns3
 	    }
 
 	  if (routed)
-	    NS_LOG_INFO ("On (" << myAddr << ") forwarded one hop closer to (" << endSector << ")");
+	    NS_LOG_INFO ("On (" << *myAddr << ") forwarded one hop closer to (" << endSector << ")");
 
 	  // Check how far we are from old Name
-	  if (oldName->distance (myAddr) <= 2)
+	  if (oldName->distance (*myAddr) <= 2)
 	    {
-	      for (it = hierarchicalFaces.begin (); it != hierarchicalFaces.end (); ++it)
+	      for (uint32_t i = 0; i < numHierarchical; i++)
 		{
 		  // Check the information for the hierarchical Faces
-		  outFace = it->first;
-		  destAddr = it->second;
+		  outFace = hierarchicalFaces[i].first;
+		  destAddr = hierarchicalFaces[i].second;
 
 		  // Should we stumble on a face that is how we got here, skip
 		  if (outFace == face)
@@ -1019,22 +1314,22 @@ namespace ns3
 		}
 
 	      if (propagated)
-		NS_LOG_INFO ("On (" << myAddr << ") found parent sector to propagate to");
+		NS_LOG_INFO ("On (" << *myAddr << ") found parent sector to propagate to");
 	    }
 	  else
 	    {
-	      NS_LOG_INFO ("On (" << myAddr << ") we are too far from (" << endSector << "), no forwarding to parent sectors");
+	      NS_LOG_INFO ("On (" << *myAddr << ") we are too far from (" << endSector << "), no forwarding to parent sectors");
 	    }
 	}
       else
 	{
-	  NS_LOG_INFO ("On (" << myAddr << ") reached sector, ending");
+	  NS_LOG_INFO ("On (" << *myAddr << ") reached sector, ending");
 	}
 
       // We have inserted the INF information. Now flush the relevant buffer
       flushBuffer (face, oldName, newName);
 
-      NS_LOG_INFO ("On (" << myAddr << ") creating NNPT Entry for Old: (" << *oldName << ") -> New: (" << *newName << ")");
+      NS_LOG_INFO ("On (" << *myAddr << ") creating NNPT Entry for Old: (" << *oldName << ") -> New: (" << *newName << ")");
 
       // Update our NNPT with the information in the INF PDU
       m_nnpt->addEntry (inf_p->GetOldNamePtr (), inf_p->GetNewNamePtr (), inf_p->GetRemainLease ());
@@ -1047,11 +1342,11 @@ namespace ns3
 
       m_inNULLps (null_p, face);
 
-      //Give us a rw copy of the packet
-      Ptr<Packet> icn_pdu = null_p->GetPayload ()->Copy ();
+      // The encoded ICN PDU is shared, not copied
+      Ptr<const Packet> icn_pdu = null_p->GetPayload ();
 
       // To be able to simplify code, convert pointer to common type
-      Ptr<NNNPDU> pdu = DynamicCast<NNNPDU> (null_p);
+      Ptr<NNNPDU> pdu = null_p;
 
       ProcessICNPDU (pdu, face, icn_pdu);
     }
@@ -1063,15 +1358,13 @@ namespace ns3
 
       m_inSOs (so_p, face);
 
-      NNNAddress myAddr = GetNode3NName ();
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") got SO from (" << so_p->GetName() << ")");
 
-      NS_LOG_INFO ("On (" << myAddr << ") got SO from (" << so_p->GetName() << ")");
-
-      //Give us a rw copy of the packet
-      Ptr<Packet> icn_pdu = so_p->GetPayload ()->Copy ();
+      // The encoded ICN PDU is shared, not copied
+      Ptr<const Packet> icn_pdu = so_p->GetPayload ();
 
       // To be able to simplify code, convert pointer to common type
-      Ptr<NNNPDU> pdu = DynamicCast<NNNPDU>(so_p);
+      Ptr<NNNPDU> pdu = so_p;
 
       ProcessICNPDU (pdu, face, icn_pdu);
     }
@@ -1083,15 +1376,13 @@ namespace ns3
 
       m_inDOs (do_p, face);
 
-      NNNAddress myAddr = GetNode3NName ();
-
-      NS_LOG_INFO ("On (" << myAddr << ") got DO headed to (" << do_p->GetName() << ")");
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") got DO headed to (" << do_p->GetName() << ")");
 
-      //Give us a rw copy of the packet
-      Ptr<Packet> icn_pdu = do_p->GetPayload ()->Copy ();
+      // The encoded ICN PDU is shared, not copied
+      Ptr<const Packet> icn_pdu = do_p->GetPayload ();
 
       // To be able to simplify code, convert pointer to common type
-      Ptr<NNNPDU> pdu = DynamicCast<NNNPDU> (do_p);
+      Ptr<NNNPDU> pdu = do_p;
 
       ProcessICNPDU (pdu, face, icn_pdu);
     }
@@ -1103,21 +1394,19 @@ namespace ns3
 
       m_inDUs (du_p, face);
 
-      NNNAddress myAddr = GetNode3NName ();
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") got DU from (" << du_p->GetSrcName() << ") to (" << du_p->GetDstName() << ")");
 
-      NS_LOG_INFO ("On (" << myAddr << ") got DU from (" << du_p->GetSrcName() << ") to (" << du_p->GetDstName() << ")");
-
-      //Give us a rw copy of the packet
-      Ptr<Packet> icn_pdu = du_p->GetPayload ()->Copy ();
+      // The encoded ICN PDU is shared, not copied
+      Ptr<const Packet> icn_pdu = du_p->GetPayload ();
 
       // To be able to simplify code, convert pointer to common type
-      Ptr<NNNPDU> pdu = DynamicCast<NNNPDU> (du_p);
+      Ptr<NNNPDU> pdu = du_p;
 
       ProcessICNPDU (pdu, face, icn_pdu);
     }
 
     void
-    ForwardingStrategy::ProcessICNPDU (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<Packet> icn_pdu)
+    ForwardingStrategy::ProcessICNPDU (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<const Packet> icn_pdu)
     {
       NS_LOG_FUNCTION (this << face->GetId ());
       bool receivedInterest =false;
@@ -1125,24 +1414,28 @@ namespace ns3
       Ptr<ndn::Interest> interest;
       Ptr<ndn::Data> data;
 
+      // Decoding strips the headers, so it works on a copy-on-write
+      // duplicate of the shared packet
+      Ptr<Packet> decode = icn_pdu->Copy ();
+
       try {
 	  ndn::HeaderHelper::Type ndnType = ndn::HeaderHelper::GetNdnHeaderType(icn_pdu);
 	  switch (ndnType)
 	  {
 	    case ndn::HeaderHelper::INTEREST_NDNSIM:
-	      interest = ndn::Wire::ToInterest (icn_pdu, ndn::Wire::WIRE_FORMAT_NDNSIM);
+	      interest = ndn::Wire::ToInterest (decode, ndn::Wire::WIRE_FORMAT_NDNSIM);
 	      receivedInterest = true;
 	      break;
 	    case ndn::HeaderHelper::INTEREST_CCNB:
-	      interest = ndn::Wire::ToInterest (icn_pdu, ndn::Wire::WIRE_FORMAT_CCNB);
+	      interest = ndn::Wire::ToInterest (decode, ndn::Wire::WIRE_FORMAT_CCNB);
 	      receivedInterest = true;
 	      break;
 	    case ndn::HeaderHelper::CONTENT_OBJECT_NDNSIM:
-	      data = ndn::Wire::ToData (icn_pdu, ndn::Wire::WIRE_FORMAT_NDNSIM);
+	      data = ndn::Wire::ToData (decode, ndn::Wire::WIRE_FORMAT_NDNSIM);
 	      receivedData = true;
 	      break;
 	    case ndn::HeaderHelper::CONTENT_OBJECT_CCNB:
-	      data = ndn::Wire::ToData (icn_pdu, ndn::Wire::WIRE_FORMAT_CCNB);
+	      data = ndn::Wire::ToData (decode, ndn::Wire::WIRE_FORMAT_CCNB);
 	      receivedData = true;
 	      break;
 	    default:
@@ -1157,16 +1450,42 @@ namespace ns3
       // If the PDU is an Interest
       if (receivedInterest)
 	{
+	  // Keep the received encoding, so forwarding does not encode it again
+	  interest->SetWire (icn_pdu);
 	  ProcessInterest (pdu, face, interest);
 	}
 
       // If the PDU is Data
       if (receivedData)
 	{
+	  // Keep the received encoding, so forwarding does not encode it again
+	  data->SetWire (icn_pdu);
 	  ProcessData (pdu, face, data);
 	}
     }
 
+    Ptr<const Packet>
+    ForwardingStrategy::GetICNWire (Ptr<const ndn::Interest> interest)
+    {
+      Ptr<const Packet> wire = interest->GetWire ();
+
+      if (wire == 0)
+	wire = ndn::Wire::FromInterest (interest);
+
+      return wire;
+    }
+
+    Ptr<const Packet>
+    ForwardingStrategy::GetICNWire (Ptr<const ndn::Data> data)
+    {
+      Ptr<const Packet> wire = data->GetWire ();
+
+      if (wire == 0)
+	wire = ndn::Wire::FromData (data);
+
+      return wire;
+    }
+
     void
     ForwardingStrategy::UpdatePITEntry (Ptr<pit::Entry> pitEntry, Ptr<NNNPDU> pdu, Ptr<Face> face, Time lifetime)
     {
@@ -1181,13 +1500,13 @@ namespace ns3
       {
 	case SO_NNN:
 	  // Convert pointer to SO
-	  so_i = DynamicCast<SO> (pdu);
+	  so_i = StaticCast<SO> (pdu);
 	  // Add the Face and 3N name
 	  pitEntry->AddIncoming (face, so_i->GetNamePtr ());
 	  break;
 	case DU_NNN:
 	  // Convert pointer to DU
-	  du_i = DynamicCast<DU> (pdu);
+	  du_i = StaticCast<DU> (pdu);
 	  // Add the Face and 3N name
 	  pitEntry->AddIncoming (face, du_i->GetSrcNamePtr ());
 	  break;
@@ -1207,8 +1526,7 @@ namespace ns3
       // Log the Interest PDU
       m_inInterests (interest, face);
 
-      NNNAddress myAddr = GetNode3NName ();
-      NS_LOG_INFO ("On (" << myAddr << ") processing Interest for " << std::dec << interest->GetName ().get (-1).toSeqNum ());
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") processing Interest for " << std::dec << interest->GetName ().get (-1).toSeqNum ());
 
       // Search for the PIT with the Interest
       Ptr<pit::Entry> pitEntry = m_pit->Lookup (*interest);
@@ -1296,9 +1614,7 @@ namespace ns3
       // Log the Data PDU
       m_inData (data, face);
 
-      NNNAddress myAddr = GetNode3NName ();
-
-      NS_LOG_INFO ("On (" << myAddr << ") processing DATA " << std::dec << data->GetName ().get (-1).toSeqNum ());
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") processing DATA " << std::dec << data->GetName ().get (-1).toSeqNum ());
 
       // Lookup PIT entry
       Ptr<pit::Entry> pitEntry = m_pit->Lookup (*data);
@@ -1318,7 +1634,7 @@ namespace ns3
 	  // Log that this node is proactively caching this data
 	  DidReceiveUnsolicitedData (face, data, true);
 
-	  NS_LOG_INFO ("On (" << myAddr << ") there is no PIT Entry for this DATA " << std::dec << data->GetName ().get (-1).toSeqNum ());
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") there is no PIT Entry for this DATA " << std::dec << data->GetName ().get (-1).toSeqNum ());
 
 	  // We got Data without having solicited it. If it is of type NULL or SO PDU, we can't do anything about it
 	  // If the data is of DU or DO, then we can actually forward it!
@@ -1375,45 +1691,55 @@ namespace ns3
     ForwardingStrategy::GetAllPoANames (Ptr<Face> face)
     {
       NS_LOG_FUNCTION (this);
-      // Vector to save the PoA names
-      std::vector<Address> poanames1;
-      std::vector<Address> poanames2;
-      // Get the total number of addresses we have
-      int totalFaces = m_faces->GetN ();
-      Ptr<Face> tmp;
-      Address tmpaddr;
-
-      // Go through the Faces attached to the ForwardingStrategy
-      for (int i = 0; i < totalFaces; i++)
-	{
-	  // Get a Face
-	  tmp = m_faces->Get (i);
-
-	  // Check that the Face is not of type APPLICATION
-	  if (!tmp->isAppFace ())
-	    {
-	      if (face == tmp)
-		{
-		  tmpaddr = tmp->GetAddress ();
-		  poanames1.push_back (tmpaddr);
-		}
-	      else
-		poanames2.push_back (tmp->GetAddress ());
-	    }
-	}
+      uint32_t totalFaces = m_faces->GetN ();
+
+      // The PoA name of face goes first, followed by those of the other non
+      // APPLICATION Faces in order
+      std::vector<Address> poanames;
+      poanames.reserve (totalFaces);
 
-      for (int i = 0; i < poanames2.size (); i++)
+      if (face != 0 && !face->isAppFace ())
+	poanames.push_back (face->GetAddress ());
+
+      for (uint32_t i = 0; i < totalFaces; i++)
 	{
-	  poanames1.push_back (poanames2[i]);
+	  Ptr<Face> tmp = m_faces->Get (i);
+
+	  if (tmp != face && !tmp->isAppFace ())
+	    poanames.push_back (tmp->GetAddress ());
 	}
 
-      return poanames1;
+      return poanames;
+    }
+
+    Time
+    ForwardingStrategy::GetEnrollBackoff (uint32_t attempt)
+    {
+      double backoff = m_ack_timeout.ToDouble (Time::S) * std::pow (m_enroll_backoff_multiplier, static_cast<double> (attempt));
+      backoff = std::min (backoff, m_enroll_backoff_max.ToDouble (Time::S));
+
+      // Spread the retransmissions of nodes that enrolled at the same time
+      backoff *= 1.0 + m_enroll_jitter * (2.0 * m_enroll_rand.GetValue () - 1.0);
+
+      return Seconds (backoff);
     }
 
     void
     ForwardingStrategy::Enroll ()
     {
       NS_LOG_FUNCTION (this);
+
+      // A new enrollment starts over from the shortest retransmission time
+      m_enroll_event.Cancel ();
+      m_enroll_attempt = 0;
+
+      SendEnroll ();
+    }
+
+    void
+    ForwardingStrategy::SendEnroll ()
+    {
+      NS_LOG_FUNCTION (this << m_enroll_attempt);
       // Check whether this node has a 3N name
       if (!Has3NName ())
 	{
@@ -1455,13 +1781,15 @@ namespace ns3
 		}
 	    }
 
-	  NS_LOG_INFO ("Scheduling an enroll should things go south");
+	  Time backoff = GetEnrollBackoff (m_enroll_attempt++);
+	  NS_LOG_INFO ("Scheduling an enroll in " << backoff.GetSeconds () << "s should things go south");
 	  // Schedule the another enroll, should things go bad
-	  Simulator::Schedule (m_ack_timeout, &ForwardingStrategy::Enroll, this);
+	  m_enroll_event = Simulator::Schedule (backoff, &ForwardingStrategy::SendEnroll, this);
 	}
       else
 	{
 	  NS_LOG_INFO ("Node has name (" << GetNode3NName () << "), no more need for enrollment for now");
+	  m_enroll_attempt = 0;
 	}
     }
 
@@ -1469,12 +1797,25 @@ namespace ns3
     ForwardingStrategy::Reenroll ()
     {
       NS_LOG_FUNCTION (this);
+
+      // A new reenrollment starts over from the shortest retransmission time
+      m_reenroll_event.Cancel ();
+      m_reenroll_attempt = 0;
+
+      SendReenroll ();
+    }
+
+    void
+    ForwardingStrategy::SendReenroll ()
+    {
+      NS_LOG_FUNCTION (this << m_reenroll_attempt);
       std::set <Ptr<Face>, PtrFaceComp>::iterator it;
 
       // Check whether this node has a 3N name
       if (Has3NName () && !m_on_ren_oen)
 	{
 	  bool ok = false;
+	  bool tried = false;
 	  Ptr<Face> tmp;
 	  // Now transmit the REN through all Faces that are not of type APPLICATION
 	  for (int i = 0; i < m_faces->GetN (); i++)
@@ -1523,11 +1864,17 @@ namespace ns3
 		      m_sent_ren = true;
 		    }
 
-		  NS_LOG_INFO ("Scheduling an reenroll should things go south");
-		  // Schedule the another enroll, should things go bad
-		  Simulator::Schedule (m_ack_timeout, &ForwardingStrategy::Reenroll, this);
+		  tried = true;
 		}
 	    }
+
+	  if (tried)
+	    {
+	      Time backoff = GetEnrollBackoff (m_reenroll_attempt++);
+	      NS_LOG_INFO ("Scheduling a reenroll in " << backoff.GetSeconds () << "s should things go south");
+	      // Schedule the another reenroll, should things go bad
+	      m_reenroll_event = Simulator::Schedule (backoff, &ForwardingStrategy::SendReenroll, this);
+	    }
 	}
       else
 	{
@@ -1535,6 +1882,7 @@ namespace ns3
 	  // Reset everything
 	  m_sent_ren = false;
 	  m_on_ren_oen = false;
+	  m_reenroll_attempt = 0;
 	}
     }
 
@@ -1668,6 +2016,90 @@ namespace ns3
       NS_LOG_FUNCTION (this);
     }
 
+    template<>
+    TracedCallback<Ptr<const NULLp>, Ptr<const Face> > &
+    ForwardingStrategy::OutTrace<NULLp> ()
+    {
+      return m_outNULLps;
+    }
+
+    template<>
+    TracedCallback<Ptr<const SO>, Ptr<const Face> > &
+    ForwardingStrategy::OutTrace<SO> ()
+    {
+      return m_outSOs;
+    }
+
+    template<>
+    TracedCallback<Ptr<const DO>, Ptr<const Face> > &
+    ForwardingStrategy::OutTrace<DO> ()
+    {
+      return m_outDOs;
+    }
+
+    template<>
+    TracedCallback<Ptr<const DU>, Ptr<const Face> > &
+    ForwardingStrategy::OutTrace<DU> ()
+    {
+      return m_outDUs;
+    }
+
+    template<>
+    TracedCallback<Ptr<const NULLp>, Ptr<const Face> > &
+    ForwardingStrategy::DropTrace<NULLp> ()
+    {
+      return m_dropNULLps;
+    }
+
+    template<>
+    TracedCallback<Ptr<const SO>, Ptr<const Face> > &
+    ForwardingStrategy::DropTrace<SO> ()
+    {
+      return m_dropSOs;
+    }
+
+    template<>
+    TracedCallback<Ptr<const DO>, Ptr<const Face> > &
+    ForwardingStrategy::DropTrace<DO> ()
+    {
+      return m_dropDOs;
+    }
+
+    template<>
+    TracedCallback<Ptr<const DU>, Ptr<const Face> > &
+    ForwardingStrategy::DropTrace<DU> ()
+    {
+      return m_dropDUs;
+    }
+
+    template<class PDU>
+    bool
+    ForwardingStrategy::SatisfyWith (Ptr<PDU> pdu, Ptr<Face> inFace, Ptr<Face> outFace,
+                                     Ptr<const ndn::Data> data, Ptr<pit::Entry> pitEntry)
+    {
+      bool ok = PDUTraits<PDU>::Send (outFace, pdu);
+
+      // Something caused an error
+      if (!ok)
+	{
+	  // Log Data drops
+	  m_dropData (data, outFace);
+	  // Log the type of 3N Data transfer PDU that was dropped
+	  DropTrace<PDU> () (pdu, outFace);
+
+	  NS_LOG_DEBUG ("Cannot satisfy data to via "<< *outFace);
+	}
+      else
+	{
+	  // Log that a Data PDU was sent
+	  DidSendOutData (inFace, outFace, data, pitEntry);
+
+	  NS_LOG_INFO ("Satisfying with " << PDUTraits<PDU>::GetName ());
+	  OutTrace<PDU> () (pdu, outFace);
+	}
+
+      return ok;
+    }
     void
     ForwardingStrategy::DidExhaustForwardingOptions (Ptr<NNNPDU> pdu,
                                                      Ptr<Face> inFace,
@@ -1677,54 +2109,27 @@ namespace ns3
       NS_LOG_FUNCTION (this << boost::cref (*inFace));
       if (pitEntry->AreAllOutgoingInVain ())
 	{
-	  // Pointers and flags for PDU types
-	  Ptr<NULLp> nullp_i;
-	  bool wasNULL = false;
-	  Ptr<SO> so_i;
-	  bool wasSO = false;
-	  Ptr<DO> do_i;
-	  bool wasDO = false;
-	  Ptr<DU> du_i;
-	  bool wasDU = false;
-
-	  uint32_t pduid = pdu->GetPacketId();
-	  switch(pduid)
+	  m_dropInterests (interest, inFace);
+
+	  // Log the type of 3N Data transfer PDU that was dropped
+	  switch (pdu->GetPacketId ())
 	  {
 	    case NULL_NNN:
-	      // Convert pointer to NULLp PDU
-	      nullp_i = DynamicCast<NULLp> (pdu);
-	      wasNULL = true;
+	      DropTrace<NULLp> () (StaticCast<NULLp> (pdu), inFace);
 	      break;
 	    case SO_NNN:
-	      // Convert pointer to SO PDU
-	      so_i = DynamicCast<SO> (pdu);
-	      wasSO = true;
+	      DropTrace<SO> () (StaticCast<SO> (pdu), inFace);
 	      break;
 	    case DO_NNN:
-	      // Convert pointer to DO PDU
-	      do_i = DynamicCast<DO> (pdu);
-	      wasDO = true;
+	      DropTrace<DO> () (StaticCast<DO> (pdu), inFace);
 	      break;
 	    case DU_NNN:
-	      // Convert pointer to DU PDU
-	      du_i = DynamicCast<DU> (pdu);
-	      wasDU = true;
+	      DropTrace<DU> () (StaticCast<DU> (pdu), inFace);
 	      break;
 	    default:
 	      break;
 	  }
 
-	  m_dropInterests (interest, inFace);
-
-	  if (wasNULL)
-	    m_dropNULLps (nullp_i, inFace);
-	  else if (wasSO)
-	    m_dropSOs (so_i, inFace);
-	  else if (wasDO)
-	    m_dropDOs (do_i, inFace);
-	  else if (wasDU)
-	    m_dropDUs (du_i, inFace);
-
 	  // All incoming interests cannot be satisfied. Remove them
 	  pitEntry->ClearIncoming ();
 
@@ -1784,297 +2189,152 @@ namespace ns3
                                                 Ptr<pit::Entry> pitEntry)
     {
       NS_LOG_FUNCTION (this);
-      NNNAddress myAddr = GetNode3NName ();
 
-      NS_LOG_INFO ("On (" << myAddr << ") Satisfying pending Interests for " << data->GetName());
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") Satisfying pending Interests for " << data->GetName());
 
       if (inFace != 0)
 	pitEntry->RemoveIncoming (inFace);
       else
-	NS_LOG_INFO ("On (" << myAddr << ") satisfying from local CS");
-
-      // Convert the Data PDU into a NS-3 Packet
-      Ptr<Packet> icn_pdu = ndn::Wire::FromData (data);
-
-      // Pointers and flags for PDU types
-      Ptr<NULLp> nullp_i;
-      bool wasNULL = false;
-      Ptr<SO> so_i;
-      bool wasSO = false;
-      Ptr<DO> do_i;
-      bool wasDO = false;
-      Ptr<DU> du_i;
-      bool wasDU = false;
+	NS_LOG_INFO ("On (" << GetNode3NName () << ") satisfying from local CS");
 
-      uint32_t pduid = pdu->GetPacketId ();
-      switch(pduid)
+      // Resolve the 3N PDU type once, the rest works on the typed PDU
+      switch (pdu->GetPacketId ())
       {
 	case NULL_NNN:
-	  // Convert pointer to NULLp PDU
-	  nullp_i = DynamicCast<NULLp> (pdu);
-	  wasNULL = true;
 	  NS_LOG_INFO ("Received a NULLp");
+	  TypedSatisfyPendingInterest (StaticCast<NULLp> (pdu), inFace, data, pitEntry);
 	  break;
 	case SO_NNN:
-	  // Convert pointer to SO PDU
-	  so_i = DynamicCast<SO> (pdu);
-	  wasSO = true;
 	  NS_LOG_INFO ("Received a SO");
+	  TypedSatisfyPendingInterest (StaticCast<SO> (pdu), inFace, data, pitEntry);
 	  break;
 	case DO_NNN:
-	  // Convert pointer to DO PDU
-	  do_i = DynamicCast<DO> (pdu);
-	  wasDO = true;
 	  NS_LOG_INFO ("Received a DO");
+	  TypedSatisfyPendingInterest (StaticCast<DO> (pdu), inFace, data, pitEntry);
 	  break;
 	case DU_NNN:
-	  // Convert pointer to DU PDU
-	  du_i = DynamicCast<DU> (pdu);
-	  wasDU = true;
 	  NS_LOG_INFO ("Received a DU");
+	  TypedSatisfyPendingInterest (StaticCast<DU> (pdu), inFace, data, pitEntry);
 	  break;
 	default:
 	  break;
       }
 
-      // Satisfy all pending Interests with the Data we received on each Face
-      BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
+      NS_LOG_INFO ("Finished satisfying, clearing PIT Entry");
+
+      // All incoming interests are satisfied. Remove them
+      pitEntry->ClearIncoming ();
+
+      // Remove all outgoing faces
+      pitEntry->ClearOutgoing ();
+
+      // Set pruning timeout on PIT entry (instead of deleting the record)
+      m_pit->MarkErased (pitEntry);
+    }
+
+    template<class PDU>
+    void
+    ForwardingStrategy::TypedSatisfyPendingInterest (Ptr<PDU> pdu,
+                                                     Ptr<Face> inFace,
+                                                     Ptr<const ndn::Data> data,
+                                                     Ptr<pit::Entry> pitEntry)
+    {
+      typedef PDUTraits<PDU> traits;
+
+      // Obtain the encoded Data PDU, shared with the PDU it arrived in
+      Ptr<const Packet> icn_pdu = GetICNWire (data);
+
+      // Satisfy all pending Interests with the Data we received on each Face
+      BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
       {
 	bool ok = false;
 	bool sentSomething = false;
 
-	NS_LOG_INFO ("On (" << myAddr << ") Satisfying for Face " << incoming.m_face->GetId() << " of type " << incoming.m_face->GetFlags() << " at (" << GetNode3NName () << ")");
+	NS_LOG_INFO ("On (" << GetNode3NName () << ") Satisfying for Face " << incoming.m_face->GetId() << " of type " << incoming.m_face->GetFlags());
 
 	/////////////////////////////////////////////////////////////////////////////////////////
 	// Obtain the distinct 3N names associated to this Face and go through them
-	std::vector<Ptr<NNNAddress> > distinct = incoming.m_addrs->GetDistinctDestinations ();
+	std::vector<Ptr<NNNAddress> > distinct = incoming.GetDistinctDestinations ();
 	// It is possible for the face to have no destinations
 	if (distinct.empty())
 	  {
 	    // The PIT Entry has been created but has no 3N names. We satisfy with whatever we were given
-	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has no 3N names aggregated");
+	    NS_LOG_INFO ("On (" << GetNode3NName () << ") Our PIT has no 3N names aggregated");
 
 	    if (inFace == 0)
 	      {
-		NS_LOG_INFO ("On (" << myAddr << ") we are satisfying directly from our CS");
+		NS_LOG_INFO ("On (" << GetNode3NName () << ") we are satisfying directly from our CS");
 
 		// If an application Face, forward PDU as it arrive
 		if (incoming.m_face->isAppFace())
 		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") we are sending to an Application Face");
-		    if (wasNULL)
-		      ok = incoming.m_face->SendNULLp (nullp_i);
-		    else if (wasSO)
-		      ok = incoming.m_face->SendSO (so_i);
-		    else if (wasDO)
-		      ok = incoming.m_face->SendDO (do_i);
-		    else if (wasDU)
-		      ok = incoming.m_face->SendDU (du_i);
-
-		    // Something caused an error
-		    if (!ok)
-		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log the type of 3N Data transfer PDU that was dropped
-			if (wasNULL)
-			  m_dropNULLps (nullp_i, incoming.m_face);
-			else if (wasSO)
-			  m_dropSOs (so_i, incoming.m_face);
-			else if (wasDO)
-			  m_dropDOs (do_i, incoming.m_face);
-			else if (wasDU)
-			  m_dropDUs (du_i, incoming.m_face);
-
-			NS_LOG_DEBUG ("Cannot satisfy data to via "<< *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") we are sending to an Application Face");
+		    SatisfyWith (pdu, inFace, incoming.m_face, data, pitEntry);
+		  }
+		// Without a 3N Src name there is nobody to address, return with a NULL PDU
+		else if (!traits::HasSrcName)
+		  {
+		    // Create a NULL to return the information
+		    Ptr<NULLp> null_p_spec = Create<NULLp> ();
+		    // Set the lifetime of the 3N PDU
+		    null_p_spec->SetLifetime (m_3n_lifetime);
+		    // Configure payload for PDU
+		    null_p_spec->SetPayload (icn_pdu);
+		    // Signal that the PDU had an ICN PDU as payload
+		    null_p_spec->SetPDUPayloadType (NDN_NNN);
 
-			if (wasNULL)
-			  {
-			    NS_LOG_INFO ("Satisfying with NULLp");
-			    m_outNULLps (nullp_i, incoming.m_face);
-			  }
-			else if (wasSO)
-			  {
-			    NS_LOG_INFO ("Satisfying with SO");
-			    m_outSOs (so_i, incoming.m_face);
-			  }
-			else if (wasDO)
-			  {
-			    NS_LOG_INFO ("Satisfying with DO");
-			    m_outDOs (do_i, incoming.m_face);
-			  }
-			else if (wasDU)
-			  {
-			    NS_LOG_INFO ("Satisfying with DU");
-			    m_outDUs (du_i, incoming.m_face);
-			  }
-		      }
+		    SatisfyWith (null_p_spec, inFace, incoming.m_face, data, pitEntry);
 		  }
 		else
 		  {
-		    Ptr<NULLp> null_p_spec;
-		    Ptr<DO> do_o_spec;
-
-		    // We can do a little PDU modification particularly for SO and DU
-		    if (wasNULL || wasDO)
-		      {
-			// DO has destination only, so we need to return with NULL PDU
-			// Create a NULL to return the information
-			null_p_spec = Create<NULLp> ();
-			// Set the lifetime of the 3N PDU
-			null_p_spec->SetLifetime (m_3n_lifetime);
-			// Configure payload for PDU
-			null_p_spec->SetPayload (icn_pdu);
-			// Signal that the PDU had an ICN PDU as payload
-			null_p_spec->SetPDUPayloadType (NDN_NNN);
-
-			ok = incoming.m_face->SendNULLp (null_p_spec);
-		      }
-		    else if (wasSO || wasDU)
-		      {
-			// Get the Src 3N name
-			Ptr<const NNNAddress> olddest;
-			if (wasSO)
-			  {
-			    olddest = so_i->GetNamePtr();
-			  }
-			else
-			  {
-			    olddest = du_i->GetSrcNamePtr();
-			  }
-
-			bool redirect = m_nnpt->foundOldName(olddest);
+		    // Get the Src 3N name
+		    Ptr<const NNNAddress> olddest = traits::GetSrcName (pdu);
 
-			NNNAddress endDest;
-			endDest = m_nnpt->findPairedNamePtr (olddest)->getName ();
+		    bool redirect = m_nnpt->foundOldName(olddest);
 
-			if (redirect)
-			  NS_LOG_INFO ("We are on (" << myAddr << ") we are redirecting (" << *olddest << ") to (" << endDest << ")");
+		    NNNAddress endDest;
+		    endDest = m_nnpt->findPairedNamePtr (olddest)->getName ();
 
-			// Although we have a 3N Src Name, via SO or DU, since we didn't create this Data object, we can only respond with a DO
-			do_o_spec = Create<DO> ();
-			// Set the new 3N name
-			do_o_spec->SetName (endDest);
-			// Set the lifetime of the 3N PDU
-			do_o_spec->SetLifetime (m_3n_lifetime);
-			// Signal that the PDU had an ICN PDU as payload
-			do_o_spec->SetPDUPayloadType (NDN_NNN);
-			// Configure payload for PDU
-			do_o_spec->SetPayload (icn_pdu);
+		    if (redirect)
+		      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we are redirecting (" << *olddest << ") to (" << endDest << ")");
 
-			// We may have obtained a DEN so we need to check
-			if (m_node_pdu_buffer->DestinationExists (endDest) && !redirect)
-			  {
-			    NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << endDest << ")");
-
-			    NS_LOG_INFO ("Buffering DO");
-			    m_node_pdu_buffer->PushDO (endDest, do_o_spec);
-			  }
-
-			ok = incoming.m_face->SendDO (do_o_spec);
-		      }
+		    // Although we have a 3N Src Name, via SO or DU, since we didn't create this Data object, we can only respond with a DO
+		    Ptr<DO> do_o_spec = Create<DO> ();
+		    // Set the new 3N name
+		    do_o_spec->SetName (endDest);
+		    // Set the lifetime of the 3N PDU
+		    do_o_spec->SetLifetime (m_3n_lifetime);
+		    // Signal that the PDU had an ICN PDU as payload
+		    do_o_spec->SetPDUPayloadType (NDN_NNN);
+		    // Configure payload for PDU
+		    do_o_spec->SetPayload (icn_pdu);
 
-		    // Something caused an error
-		    if (!ok)
+		    // We may have obtained a DEN so we need to check
+		    if (m_node_pdu_buffer->DestinationExists (endDest) && !redirect)
 		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log the type of 3N Data transfer PDU that was dropped
-			if (wasNULL || wasDO)
-			  m_dropNULLps (null_p_spec, incoming.m_face);
-			else if (wasSO || wasDU)
-			  m_dropDOs (do_o_spec, incoming.m_face);
+			NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << endDest << ")");
 
-			NS_LOG_DEBUG ("Cannot satisfy data to via "<< *incoming.m_face);
+			NS_LOG_INFO ("Buffering DO");
+			m_node_pdu_buffer->PushDO (endDest, do_o_spec);
 		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
 
-			if (wasNULL || wasDO)
-			  {
-			    NS_LOG_INFO ("Satisfying with NULLp");
-			    m_outNULLps (null_p_spec, incoming.m_face);
-			  }
-			else if (wasSO || wasDU)
-			  {
-			    NS_LOG_INFO ("Satisfying with DO");
-			    m_outDOs (do_o_spec, incoming.m_face);
-			  }
-		      }
+		    SatisfyWith (do_o_spec, inFace, incoming.m_face, data, pitEntry);
 		  }
 	      }
 	    else
 	      {
 		if (incoming.m_face->isAppFace ())
-		  NS_LOG_INFO ("On (" << myAddr << ") we are sending to an Application Face");
+		  NS_LOG_INFO ("On (" << GetNode3NName () << ") we are sending to an Application Face");
 		else
-		  NS_LOG_INFO ("On (" << myAddr << ") we are sending to a normal Face");
+		  NS_LOG_INFO ("On (" << GetNode3NName () << ") we are sending to a normal Face");
 
 		// If the Face is an application Face, then just forward it as is
-		if (wasNULL)
-		  ok = incoming.m_face->SendNULLp (nullp_i);
-		else if (wasSO)
-		  ok = incoming.m_face->SendSO (so_i);
-		else if (wasDO)
-		  ok = incoming.m_face->SendDO (do_i);
-		else if (wasDU)
-		  ok = incoming.m_face->SendDU (du_i);
-
-		// Something caused an error
-		if (!ok)
-		  {
-		    // Log Data drops
-		    m_dropData (data, incoming.m_face);
-		    // Log the type of 3N Data transfer PDU that was dropped
-		    if (wasNULL)
-		      m_dropNULLps (nullp_i, incoming.m_face);
-		    else if (wasSO)
-		      m_dropSOs (so_i, incoming.m_face);
-		    else if (wasDO)
-		      m_dropDOs (do_i, incoming.m_face);
-		    else if (wasDU)
-		      m_dropDUs (du_i, incoming.m_face);
-
-		    NS_LOG_DEBUG ("Cannot satisfy data to via "<< *incoming.m_face);
-		  }
-		else
-		  {
-		    // Log that a Data PDU was sent
-		    DidSendOutData (inFace, incoming.m_face, data, pitEntry);
-
-		    if (wasNULL)
-		      {
-			NS_LOG_INFO ("Satisfying with NULLp");
-			m_outNULLps (nullp_i, incoming.m_face);
-		      }
-		    else if (wasSO)
-		      {
-			NS_LOG_INFO ("Satisfying with SO");
-			m_outSOs (so_i, incoming.m_face);
-		      }
-		    else if (wasDO)
-		      {
-			NS_LOG_INFO ("Satisfying with DO");
-			m_outDOs (do_i, incoming.m_face);
-		      }
-		    else if (wasDU)
-		      {
-			NS_LOG_INFO ("Satisfying with DU");
-			m_outDUs (du_i, incoming.m_face);
-		      }
-		  }
+		SatisfyWith (pdu, inFace, incoming.m_face, data, pitEntry);
 	      }
 	  }
 	else
 	  {
-	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has 3N names aggregated");
+	    NS_LOG_INFO ("On (" << GetNode3NName () << ") Our PIT has 3N names aggregated");
 
 	    // There is at least one 3N name in this list - go through the code
 	    BOOST_FOREACH (Ptr<NNNAddress> j, distinct)
@@ -2082,7 +2342,7 @@ namespace ns3
 	      bool subSector = m_node_names->foundName(j);
 	      NNNAddress newdst;
 	      // Obtain all the 3N names aggregated in this sector
-	      std::vector<Ptr<NNNAddress> > addrs = incoming.m_addrs->GetCompleteDestinations (j);
+	      std::vector<Ptr<NNNAddress> > addrs = incoming.GetCompleteDestinations (j);
 
 	      BOOST_FOREACH (Ptr<NNNAddress> i, addrs)
 	      {
@@ -2096,10 +2356,10 @@ namespace ns3
 		else
 		  {
 
-		    NS_LOG_INFO ("On (" << myAddr << ") satisfying for 3N names in different subsector (" << *j << "), destination: (" << *i << ")");
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") satisfying for 3N names in different subsector (" << *j << "), destination: (" << *i << ")");
 		    if (sentSomething)
 		      {
-			NS_LOG_INFO ("On (" << myAddr << "), we seem to have already sent to subsector (" << *j << ") about to skip");
+			NS_LOG_INFO ("On (" << GetNode3NName () << "), we seem to have already sent to subsector (" << *j << ") about to skip");
 			continue;
 		      }
 		  }
@@ -2107,61 +2367,10 @@ namespace ns3
 		// First check to see if we happen to be the destination
 		if (m_node_names->foundName(i))
 		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") We are the desired 3N named node destination");
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") We are the desired 3N named node destination");
 		    // This also happens to mean that we satisfying an Application - do not know if
 		    // this holds in future references
-		    if (wasNULL)
-		      ok = incoming.m_face->SendNULLp (nullp_i);
-		    else if (wasSO)
-		      ok = incoming.m_face->SendSO (so_i);
-		    else if (wasDO)
-		      ok = incoming.m_face->SendDO (do_i);
-		    else if (wasDU)
-		      ok = incoming.m_face->SendDU (du_i);
-
-		    // Something caused an error
-		    if (!ok)
-		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log the type of 3N Data transfer PDU that was dropped
-			if (wasNULL)
-			  m_dropNULLps (nullp_i, incoming.m_face);
-			else if (wasSO)
-			  m_dropSOs (so_i, incoming.m_face);
-			else if (wasDO)
-			  m_dropDOs (do_i, incoming.m_face);
-			else if (wasDU)
-			  m_dropDUs (du_i, incoming.m_face);
-
-			NS_LOG_DEBUG ("Cannot satisfy data to " << *i << " via "<< *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
-
-			if (wasNULL)
-			  {
-			    NS_LOG_INFO ("Satisfying with NULLp");
-			    m_outNULLps (nullp_i, incoming.m_face);
-			  }
-			else if (wasSO)
-			  {
-			    NS_LOG_INFO ("Satisfying with SO");
-			    m_outSOs (so_i, incoming.m_face);
-			  }
-			else if (wasDO)
-			  {
-			    NS_LOG_INFO ("Satisfying with DO");
-			    m_outDOs (do_i, incoming.m_face);
-			  }
-			else if (wasDU)
-			  {
-			    NS_LOG_INFO ("Satisfying with DU");
-			    m_outDUs (du_i, incoming.m_face);
-			  }
-		      }
+		    SatisfyWith (pdu, inFace, incoming.m_face, data, pitEntry);
 
 		    sentSomething = true;
 		    continue;
@@ -2176,37 +2385,29 @@ namespace ns3
 		newdst = m_nnpt->findPairedNamePtr (i)->getName ();
 
 		if (redirect)
-		  NS_LOG_INFO ("We are on (" << myAddr << ") we are redirecting (" << *i << ") to (" << newdst << ")");
+		  NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we are redirecting (" << *i << ") to (" << newdst << ")");
 
 		// We may have obtained a DEN so we need to check
-		if (m_node_pdu_buffer->DestinationExists (i) && !redirect)
+		if (traits::HasDstName && m_node_pdu_buffer->DestinationExists (i) && !redirect)
 		  {
-		    NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << *i << ")");
+		    NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << *i << ")");
 
-		    if (wasDO)
-		      {
-			NS_LOG_INFO ("Buffering DO");
-			m_node_pdu_buffer->PushDO (i, do_i);
-		      }
-		    else if (wasDU)
-		      {
-			NS_LOG_INFO ("Buffering DU");
-			m_node_pdu_buffer->PushDU (i, du_i);
-		      }
+		    NS_LOG_INFO ("Buffering " << traits::GetName ());
+		    traits::Buffer (m_node_pdu_buffer, *i, pdu);
 		  }
 
-		NS_LOG_INFO ("On (" << myAddr << ") Going to look at NNST size: " << m_nnst->GetSize() << " to send to (" << newdst << ")");
+		NS_LOG_INFO ("On (" << GetNode3NName () << ") Going to look at NNST size: " << m_nnst->GetSize() << " to send to (" << newdst << ")");
 		NS_LOG_INFO (*m_nnst);
 
 		// Roughly pick the next hop that would bring us closer to newdst
-		std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (newdst, 0);
+		std::pair<Ptr<Face>, Address> tmp = FlowNextHop (newdst, data->GetName (), 0);
 
 		Ptr<Face> outFace = tmp.first;
 		Address destAddr = tmp.second;
 
-		if ((wasNULL || wasSO || wasDO) && (!sentSomething || redirect))
+		if (!(traits::HasSrcName && traits::HasDstName) && (!sentSomething || redirect))
 		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *i << ") using DO");
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") Satisfying for 3N name (" << *i << ") using DO");
 		    // Since we don't have more information about this 3N name, create a DO to push the
 		    // Data to a new location
 		    Ptr<DO> do_o_spec = Create<DO> ();
@@ -2246,14 +2447,14 @@ namespace ns3
 			  }
 		      }
 		  }
-		else if (wasDU && (!sentSomething || redirect))
+		else if (traits::HasSrcName && traits::HasDstName && (!sentSomething || redirect))
 		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *i << ") using DU");
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") Satisfying for 3N name (" << *i << ") using DU");
 		    // We know that the Data was brought by a DU PDU, meaning we know the origin
 		    // Create a new DU PDU to send the data
 		    Ptr<DU> du_o_spec = Create<DU> ();
 		    // Use the original DU's Src 3N name
-		    du_o_spec->SetSrcName (du_i->GetSrcName ());
+		    du_o_spec->SetSrcName (*traits::GetSrcName (pdu));
 		    // Set the new 3N name destination
 		    du_o_spec->SetDstName (newdst);
 		    // Set the lifetime of the 3N PDU
@@ -2295,7 +2496,7 @@ namespace ns3
 		// haven't pushed anything in previous sections, we should do it now
 		if (!sentSomething)
 		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying using NULLp");
+		    NS_LOG_INFO ("On (" << GetNode3NName () << ") Satisfying using NULLp");
 		    Ptr<NULLp> null_p_o = Create<NULLp> ();
 		    // Set the lifetime of the 3N PDU
 		    null_p_o->SetLifetime (m_3n_lifetime);
@@ -2304,24 +2505,10 @@ namespace ns3
 		    // Signal that the PDU had an ICN PDU as payload
 		    null_p_o->SetPDUPayloadType (NDN_NNN);
 
-		    // Send out the NULL PDU
-		    ok = incoming.m_face->SendNULLp (null_p_o);
-
 		    NS_LOG_DEBUG ("Satisfy " << *incoming.m_face);
 
-		    if (!ok)
-		      {
-			m_dropData (data, incoming.m_face);
-			m_dropNULLps (null_p_o, incoming.m_face);
-			NS_LOG_DEBUG ("Cannot satisfy data to " << *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
-			// Log that a DO PDU was sent
-			m_outNULLps (null_p_o, incoming.m_face);
-		      }
+		    // Send out the NULL PDU
+		    SatisfyWith (null_p_o, inFace, incoming.m_face, data, pitEntry);
 		  }
 	      }
 	      // Reset for each distinct 3N subsector
@@ -2329,17 +2516,6 @@ namespace ns3
 	    }
 	  }
       }
-
-      NS_LOG_INFO ("Finished satisfying, clearing PIT Entry");
-
-      // All incoming interests are satisfied. Remove them
-      pitEntry->ClearIncoming ();
-
-      // Remove all outgoing faces
-      pitEntry->ClearOutgoing ();
-
-      // Set pruning timeout on PIT entry (instead of deleting the record)
-      m_pit->MarkErased (pitEntry);
     }
 
     void
@@ -2443,46 +2619,34 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
 
-      // Convert the Interest PDU into a NS-3 Packet
-      Ptr<Packet> icn_pdu = ndn::Wire::FromInterest (interest);
-
-      // Pointers and flags for PDU types
-      Ptr<NULLp> nullp_i;
-      bool wasNULL = false;
-      Ptr<SO> so_i;
-      bool wasSO = false;
-      Ptr<DO> do_i;
-      bool wasDO = false;
-      Ptr<DU> du_i;
-      bool wasDU = false;
-
-      uint32_t pduid = pdu->GetPacketId();
-      switch(pduid)
+      switch (pdu->GetPacketId ())
       {
 	case NULL_NNN:
-	  // Convert pointer to NULLp PDU
-	  nullp_i = DynamicCast<NULLp> (pdu);
-	  wasNULL = true;
-	  break;
+	  return TypedTrySendOutInterest (StaticCast<NULLp> (pdu), inFace, outFace, addr, interest, pitEntry);
 	case SO_NNN:
-	  // Convert pointer to SO PDU
-	  so_i = DynamicCast<SO> (pdu);
-	  wasSO = true;
-	  break;
+	  return TypedTrySendOutInterest (StaticCast<SO> (pdu), inFace, outFace, addr, interest, pitEntry);
 	case DO_NNN:
-	  // Convert pointer to DO PDU
-	  do_i = DynamicCast<DO> (pdu);
-	  wasDO = true;
-	  break;
+	  return TypedTrySendOutInterest (StaticCast<DO> (pdu), inFace, outFace, addr, interest, pitEntry);
 	case DU_NNN:
-	  // Convert pointer to DU PDU
-	  du_i = DynamicCast<DU> (pdu);
-	  wasDU = true;
-	  break;
+	  return TypedTrySendOutInterest (StaticCast<DU> (pdu), inFace, outFace, addr, interest, pitEntry);
 	default:
 	  break;
       }
 
+      return false;
+    }
+
+    template<class PDU>
+    bool
+    ForwardingStrategy::TypedTrySendOutInterest (Ptr<PDU> pdu,
+                                                 Ptr<Face> inFace,
+                                                 Ptr<Face> outFace,
+                                                 Address addr,
+                                                 Ptr<const ndn::Interest> interest,
+                                                 Ptr<pit::Entry> pitEntry)
+    {
+      typedef PDUTraits<PDU> traits;
+
       // Check if we are allowed to retransmit through the selected Face
       if (!CanSendOutInterest (inFace, outFace, interest, pitEntry))
 	{
@@ -2492,30 +2656,13 @@ namespace ns3
       // Update the PIT Entry with the Outgoing selected Face
       pitEntry->AddOutgoing (outFace);
 
-      // Flag to know if what we sent was successful
-      bool successSend = false;
-
-      // Depending on the PDU type, send
-      if (wasNULL)
-	successSend = outFace->SendNULLp (nullp_i);
-      else if (wasSO)
-	successSend = outFace->SendSO (so_i);
-      else if (wasDO)
-	{
-	  // Application Faces have no names
-	  if (outFace->isAppFace ())
-	    successSend = outFace->SendDO (do_i);
-	  else
-	    successSend = outFace->SendDO (do_i, addr);
-	}
-      else if (wasDU)
-	{
-	  // Application Faces have no names
-	  if (outFace->isAppFace ())
-	    successSend = outFace->SendDU (du_i);
-	  else
-	    successSend = outFace->SendDU (du_i, addr);
-	}
+      // Only PDUs with a 3N destination are sent to a PoA address. Application
+      // Faces have no names
+      bool successSend;
+      if (traits::HasDstName && !outFace->isAppFace ())
+	successSend = traits::Send (outFace, pdu, addr);
+      else
+	successSend = traits::Send (outFace, pdu);
 
       // Check if our sending was successful
       if (!successSend)
@@ -2523,28 +2670,14 @@ namespace ns3
 	  // Log that an Interest PDU was dropped
 	  m_dropInterests (interest, outFace);
 	  // Log the type of 3N Data transfer PDU that was dropped
-	  if (wasNULL)
-	    m_dropNULLps (nullp_i, outFace);
-	  else if (wasSO)
-	    m_dropSOs (so_i, outFace);
-	  else if (wasDO)
-	    m_dropDOs (do_i, outFace);
-	  else if (wasDU)
-	    m_dropDUs (du_i, outFace);
+	  DropTrace<PDU> () (pdu, outFace);
 	}
       else
 	{
 	  // Log that an Interest PDU was forwarded
 	  DidSendOutInterest (inFace, outFace, interest, pitEntry);
 	  // Log the type of 3N Data transfer PDU that was forwarded
-	  if (wasNULL)
-	    m_outNULLps (nullp_i, outFace);
-	  else if (wasSO)
-	    m_outSOs (so_i, outFace);
-	  else if (wasDO)
-	    m_outDOs (do_i, outFace);
-	  else if (wasDU)
-	    m_outDUs (du_i, outFace);
+	  OutTrace<PDU> () (pdu, outFace);
 	}
 
       return true;
@@ -2583,13 +2716,13 @@ namespace ns3
       {
 	case SO_NNN:
 	  // Convert pointer to SO PDU
-	  so_i = DynamicCast<SO> (pdu);
+	  so_i = StaticCast<SO> (pdu);
 	  // Add the 3N name in the SO
 	  pitEntry->AddIncoming(inFace, so_i->GetNamePtr());
 	  break;
 	case DU_NNN:
 	  // Convert pointer to DU PDU
-	  du_i = DynamicCast<DU> (pdu);
+	  du_i = StaticCast<DU> (pdu);
 	  // Add the 3N name in the DU
 	  pitEntry->AddIncoming(inFace, du_i->GetSrcNamePtr());
 	  break;
@@ -2638,227 +2771,256 @@ namespace ns3
 
       int propagatedCount = 0;
 
-      // Get the number of Faces available
-      int totalFaces = pitEntry->GetFibEntry ()->m_faces.size ();
-
-      // Convert the Interest PDU into a NS-3 Packet
-      Ptr<Packet> icn_pdu = ndn::Wire::FromInterest (interest);
-
-      // Pointers and flags for PDU types
-      Ptr<NNNPDU> pdu_i;
-
-      Ptr<DO> do_i;
-      bool wasDO = false;
-      Ptr<DU> du_i;
-      bool wasDU = false;
-      Ptr<SO> so_i;
-      bool wasSO = false;
-
-      // Since we are using a combination of ICN/3N, we copy the pointer and
-      // see if 3N gives us a different Face to use. This will be used
-      // specifically when the PDU has a destination, in other words when using
-      // DO and DU PDUs
-      Ptr<Face> foutFace;
-
-      uint32_t pduid = pdu->GetPacketId();
-      switch(pduid)
+      // The propagation rules are a little different if using a DO or DU PDU
+      switch (pdu->GetPacketId ())
       {
-	case SO_NNN:
-	  so_i = DynamicCast<SO> (pdu);
-	  wasSO = true;
-	  break;
 	case DO_NNN:
-	  // Convert pointer to DO PDU
-	  do_i = DynamicCast<DO> (pdu);
-	  wasDO = true;
-	  break;
+	  return TypedPropagateInterest (StaticCast<DO> (pdu), inFace, interest, pitEntry);
 	case DU_NNN:
-	  // Convert pointer to DU PDU
-	  du_i = DynamicCast<DU> (pdu);
-	  wasDU = true;
+	  return TypedPropagateInterest (StaticCast<DU> (pdu), inFace, interest, pitEntry);
+	case SO_NNN:
+	  NS_LOG_INFO ("Propagating SO from (" << StaticCast<SO> (pdu)->GetName() << ")");
 	  break;
 	default:
+	  NS_LOG_INFO ("Propagating NULLp");
 	  break;
       }
 
-      // Pointers to use when we have DO or DU PDUs
+      // For everything else, propagate like always
+
+      // Here we pick the next place to forward to using the ICN strategy
+      BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
+      {
+	NS_LOG_DEBUG ("Trying " << boost::cref(metricFace));
+	if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED ||
+	    metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_YELLOW)
+	  break; //propagate only to green faces
+
+	// Now we actually attempt to forward the PDU
+	if (!TrySendOutInterest (pdu, inFace, metricFace.GetFace (), Address(), interest, pitEntry))
+	  {
+	    continue;
+	  }
+	propagatedCount++;
+	break; // propagate only one interest
+      }
+
+      // If filtering the Yellow and Red Faces, didn't let us send anything out, attempt the
+      // using the Yellow Faces.
+      if (!(propagatedCount > 0))
+	{
+	  BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
+	  {
+	    NS_LOG_DEBUG ("Trying " << boost::cref(metricFace));
+	    if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-read faces are in the front of the list
+	      break;
+
+	    if (!TrySendOutInterest (pdu, inFace, metricFace.GetFace (), Address(), interest, pitEntry))
+	      {
+		continue;
+	      }
+
+	    propagatedCount++;
+	  }
+	}
+
+      return propagatedCount > 0;
+    }
+
+    template<class PDU>
+    bool
+    ForwardingStrategy::TypedPropagateInterest (Ptr<PDU> pdu,
+                                                Ptr<Face> inFace,
+                                                Ptr<const ndn::Interest> interest,
+                                                Ptr<pit::Entry> pitEntry)
+    {
+      typedef PDUTraits<PDU> traits;
+
+      int propagatedCount = 0;
+
+      // Get the number of Faces available
+      int totalFaces = pitEntry->GetFibEntry ()->m_faces.size ();
+
+      // Since we are using a combination of ICN/3N, we see if 3N gives us a
+      // different Face to use
       std::pair<Ptr<Face>, Address> tmp;
       Address destAddr;
-      NNNAddress newdst;
-      Ptr<NNNAddress> newdstPtr;
-      Ptr<const NNNAddress> constdstPtr;
-      Ptr<DO> do_o_spec;
-      Ptr<DU> du_o_spec;
-      bool nnptRedirect = false;
 
-      // The propagation rules are a little different if using a DO or DU PDU
-      if (wasDO || wasDU)
-	{
-	  // First obtain the name
-	  if (wasDO)
-	    {
-	      newdst = do_i->GetName ();
-	      constdstPtr = do_i->GetNamePtr();
-	      NS_LOG_INFO ("Propagating DO heading to (" << newdst << ")");
-	    }
-	  else if (wasDU)
-	    {
-	      newdst = du_i->GetDstName ();
-	      constdstPtr = du_i->GetDstNamePtr();
-	      NS_LOG_INFO ("Propagating DU from (" << du_i->GetSrcName() << " ) heading to (" << newdst << ")");
-	    }
+      // First obtain the name
+      Ptr<const NNNAddress> constdstPtr = traits::GetDstName (pdu);
+      NNNAddress newdst = *constdstPtr;
+      NS_LOG_INFO ("Propagating " << traits::GetName () << " heading to (" << newdst << ")");
 
-	  // Check if we are already at the destination (search through all the node names acquired)
-	  if (m_node_names->foundName(constdstPtr))
+      // Check if we are already at the destination (search through all the node names acquired)
+      if (m_node_names->foundName(constdstPtr))
+	{
+	  NS_LOG_INFO ("We have reached desired destination, looking for Apps");
+	  Ptr<Face> tmpFace;
+	  // We have reached the destination, look for Apps
+	  for (int i = 0; i < m_faces->GetN (); i++)
 	    {
-	      NS_LOG_INFO ("We have reached desired destination, looking for Apps");
-	      Ptr<Face> tmpFace;
-	      // We have reached the destination, look for Apps
-	      for (int i = 0; i < m_faces->GetN (); i++)
+	      tmpFace = m_faces->Get (i);
+	      // Check that the Face is of type APPLICATION
+	      if (tmpFace->isAppFace ())
 		{
-		  tmpFace = m_faces->Get (i);
-		  // Check that the Face is of type APPLICATION
-		  if (tmpFace->isAppFace ())
+		  // Through the virtual, so subclasses see app deliveries too
+		  if (TrySendOutInterest (pdu, inFace, tmpFace, destAddr, interest, pitEntry))
 		    {
-		      if (TrySendOutInterest(pdu, inFace, tmpFace, destAddr, interest, pitEntry))
-			{
-			  propagatedCount++;
-			}
+		      propagatedCount++;
 		    }
 		}
-	      return propagatedCount > 0;
 	    }
+	  return propagatedCount > 0;
+	}
 
-	  // We may have obtained a DEN so we need to check
-	  if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
-	    {
-	      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
+      bool nnptRedirect = m_nnpt->foundOldName(constdstPtr);
 
-	      if (wasDO)
-		{
-		  NS_LOG_INFO ("Buffering DO");
-		  m_node_pdu_buffer->PushDO (newdst, do_i);
-		}
-	      else if (wasDU)
-		{
-		  NS_LOG_INFO ("Buffering DU");
-		  m_node_pdu_buffer->PushDU (newdst, du_i);
-		}
-	    }
+      // We may have obtained a DEN so we need to check
+      if (!nnptRedirect && m_node_pdu_buffer->DestinationExists (newdst))
+	{
+	  NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
 
-	  // Check if the NNPT has any information for this particular 3N name
-	  if (m_nnpt->foundOldName(constdstPtr))
-	    {
-	      // Retrieve the new 3N name destination and update variable
-	      newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
-	      // Flag that the NNPT made a change
-	      nnptRedirect = true;
-	    }
+	  NS_LOG_INFO ("Buffering " << traits::GetName ());
+	  traits::Buffer (m_node_pdu_buffer, newdst, pdu);
+	}
 
-	  if (nnptRedirect)
-	    {
-	      NS_LOG_INFO ("On (" << GetNode3NName () << ") we are create redirect from (" << *constdstPtr << ") to (" << newdst << ")");
-	      if (wasDO)
-		{
-		  // Create a new DO PDU to send the data
-		  do_o_spec = Create<DO> ();
-		  // Set the new 3N name
-		  do_o_spec->SetName (newdst);
-		  // Set the lifetime of the 3N PDU
-		  do_o_spec->SetLifetime (m_3n_lifetime);
-		  // Configure payload for PDU
-		  do_o_spec->SetPayload (icn_pdu);
-		  // Signal that the PDU had an ICN PDU as payload
-		  do_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		  pdu_i = DynamicCast<NNNPDU> (do_o_spec);
-		}
-	      else if (wasDU)
-		{
-		  // Create a new DU PDU to send the data
-		  du_o_spec = Create<DU> ();
-		  // Use the original DU's Src 3N name
-		  du_o_spec->SetSrcName (du_i->GetSrcName ());
-		  // Set the new 3N name destination
-		  du_o_spec->SetDstName (newdst);
-		  // Set the lifetime of the 3N PDU
-		  du_o_spec->SetLifetime (m_3n_lifetime);
-		  // Configure payload for PDU
-		  du_o_spec->SetPayload (icn_pdu);
-		  // Signal that the PDU had an ICN PDU as payload
-		  du_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		  pdu_i = DynamicCast<NNNPDU> (du_o_spec);
-		}
-	    }
-	  else
+      Ptr<PDU> tosend = pdu;
+
+      // Check if the NNPT has any information for this particular 3N name
+      if (nnptRedirect)
+	{
+	  // Retrieve the new 3N name destination and update variable
+	  newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
+
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") we are create redirect from (" << *constdstPtr << ") to (" << newdst << ")");
+	  // Copy the PDU with the new 3N name and lifetime, patching
+	  // the received header instead of building the PDU again
+	  tosend = traits::Redirect (pdu, newdst, m_3n_lifetime);
+	}
+
+      for (int j = 0; j < totalFaces; j++)
+	{
+	  // Roughly find the next hop
+	  tmp = SelectNextHop (newdst, j, pitEntry);
+
+	  // No candidates left to attempt
+	  if (tmp.first == 0)
+	    break;
+
+	  // Update the variables for Face and PoA name, going through the
+	  // virtual so that subclasses see every attempt
+	  if (TrySendOutInterest(tosend, inFace, tmp.first, tmp.second, interest, pitEntry))
 	    {
-	      pdu_i = pdu;
+	      propagatedCount++;
+	      break;
 	    }
+	}
 
+      return propagatedCount > 0;
+    }
 
-	  for (int j = 0; j < totalFaces; j++)
-	    {
-	      // Roughly find the next hop
-	      tmp = m_nnst->ClosestSectorFaceInfo (newdst, j);
+    std::pair<Ptr<Face>, Address>
+    ForwardingStrategy::SelectNextHop (const NNNAddress &dst, uint32_t skip, Ptr<pit::Entry> pitEntry)
+    {
+      return FlowNextHop (dst, pitEntry->GetPrefix (), skip);
+    }
 
-	      // Update the variables for Face and PoA name
-	      foutFace = tmp.first;
-	      destAddr = tmp.second;
+    namespace
+    {
+      // FNV-1a, good enough to spread flows and stable across runs
+      inline uint32_t
+      FNVHash (uint32_t hash, const char *begin, const char *end)
+      {
+	for (; begin != end; ++begin)
+	  {
+	    hash ^= static_cast<uint8_t> (*begin);
+	    hash *= 16777619u;
+	  }
+	return hash;
+      }
 
-	      if (TrySendOutInterest(pdu_i, inFace, foutFace, destAddr, interest, pitEntry))
-		{
-		  propagatedCount++;
-		  break;
-		}
-	    }
+      const uint32_t FNV_OFFSET = 2166136261u;
+
+      struct MultipathCandidate
+      {
+	double score;
+	const nnst::FaceMetric *metric;
+
+	bool
+	operator< (const MultipathCandidate &other) const
+	{
+	  return score > other.score;
 	}
-      // For everything else, propagate like always
-      else
+      };
+    }
+
+    std::pair<Ptr<Face>, Address>
+    ForwardingStrategy::FlowNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip)
+    {
+      if (!m_multipath)
+	return m_nnst->ClosestSectorFaceInfo (dst, skip);
+
+      Ptr<nnst::Entry> entry = m_nnst->ClosestSector (dst);
+
+      if (entry == 0)
+	return std::make_pair (Ptr<Face> (), Address ());
+
+      // Identify the flow by its name without the sequence number
+      uint32_t flowHash = FNV_OFFSET;
+      for (size_t i = 0; i + 1 < flow.size (); i++)
 	{
-	  if (wasSO)
-	    NS_LOG_INFO ("Propagating SO from (" << so_i->GetName() << ")");
-	  else
-	    NS_LOG_INFO ("Propagating NULLp");
+	  const ndn::name::Component &comp = flow.get (i);
+	  flowHash = FNVHash (flowHash, comp.buf (), comp.buf () + comp.size ());
+	  flowHash = FNVHash (flowHash, "/", "/" + 1);
+	}
 
-	  // Here we pick the next place to forward to using the ICN strategy
-	  BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
-	  {
-	    NS_LOG_DEBUG ("Trying " << boost::cref(metricFace));
-	    if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED ||
-		metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_YELLOW)
-	      break; //propagate only to green faces
+      // Weighted rendezvous hashing over the GREEN candidates: a flow only
+      // moves when the candidate it was using changes
+      std::vector<MultipathCandidate> candidates;
+      const nnst::fmtr_set_by_metric &metrics = entry->m_faces.get<nnst::i_metric> ();
+      for (nnst::fmtr_set_by_metric::const_iterator i = metrics.begin (); i != metrics.end (); ++i)
+	{
+	  if (i->GetStatus () != nnst::FaceMetric::NNN_NNST_GREEN)
+	    break;
 
-	    // Now we actually attempt to forward the PDU
-	    if (!TrySendOutInterest (pdu, inFace, metricFace.GetFace (), Address(), interest, pitEntry))
-	      {
-		continue;
-	      }
-	    propagatedCount++;
-	    break; // propagate only one interest
-	  }
+	  uint8_t buf[Address::MAX_SIZE];
+	  uint32_t len = i->GetAddress ().CopyAllTo (buf, Address::MAX_SIZE);
+	  uint32_t faceId = i->GetFace ()->GetId ();
 
-	  // If filtering the Yellow and Red Faces, didn't let us send anything out, attempt the
-	  // using the Yellow Faces.
-	  if (!(propagatedCount > 0))
-	    {
-	      BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
-	      {
-		NS_LOG_DEBUG ("Trying " << boost::cref(metricFace));
-		if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-read faces are in the front of the list
-		  break;
+	  uint32_t h = FNVHash (flowHash, reinterpret_cast<const char *> (&faceId),
+	                        reinterpret_cast<const char *> (&faceId) + sizeof (faceId));
+	  h = FNVHash (h, reinterpret_cast<const char *> (buf), reinterpret_cast<const char *> (buf) + len);
 
-		if (!TrySendOutInterest (pdu, inFace, metricFace.GetFace (), Address(), interest, pitEntry))
-		  {
-		    continue;
-		  }
+	  // Uniform in (0, 1)
+	  double u = (static_cast<double> (h) + 1.0) / 4294967297.0;
+	  double weight = 1.0 / (1.0 + std::max<int32_t> (i->GetRoutingCost (), 0));
 
-		propagatedCount++;
-	      }
-	    }
+	  MultipathCandidate c;
+	  c.score = -weight / std::log (u);
+	  c.metric = &*i;
+	  candidates.push_back (c);
 	}
 
-      return propagatedCount > 0;
+      // Nothing to spread over, keep the single path behaviour
+      if (skip >= candidates.size ())
+	return entry->FindBestCandidateFaceInfo (skip);
+
+      std::sort (candidates.begin (), candidates.end ());
+
+      const nnst::FaceMetric *chosen = candidates[skip].metric;
+      uint64_t splits = ++m_split_counts[chosen->GetFace ()->GetId ()];
+
+      NS_LOG_DEBUG ("Flow " << flowHash << " towards (" << dst << ") through " << *chosen);
+      m_multipathSplit (entry->GetAddressPtr (), chosen->GetFace (), splits);
+
+      return std::make_pair (chosen->GetFace (), chosen->GetAddress ());
+    }
+
+    uint64_t
+    ForwardingStrategy::GetMultipathSplits (Ptr<Face> face) const
+    {
+      std::map<uint32_t, uint64_t>::const_iterator it = m_split_counts.find (face->GetId ());
+      return it == m_split_counts.end () ? 0 : it->second;
     }
 
     bool
@@ -2866,222 +3028,117 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
 
-      // Convert the Interest PDU into a NS-3 Packet
-      Ptr<Packet> icn_pdu = ndn::Wire::FromData (data);
-
-      // Pointers and flags for PDU types
-      Ptr<NNNPDU> pdu_i;
-
-      Ptr<DO> do_i;
-      bool wasDO = false;
-      Ptr<DU> du_i;
-      bool wasDU = false;
-      bool ok = false;
-
-      uint32_t pduid = pdu->GetPacketId();
-      switch(pduid)
+      switch (pdu->GetPacketId ())
       {
 	case DO_NNN:
-	  // Convert pointer to DO PDU
-	  do_i = DynamicCast<DO> (pdu);
-	  wasDO = true;
-	  break;
+	  return TypedPropagateData (StaticCast<DO> (pdu), inFace, data);
 	case DU_NNN:
-	  // Convert pointer to DU PDU
-	  du_i = DynamicCast<DU> (pdu);
-	  wasDU = true;
-	  break;
+	  return TypedPropagateData (StaticCast<DU> (pdu), inFace, data);
 	default:
+	  NS_LOG_INFO ("Received either NULL or SO, for which without a PIT entry can do nothing with");
 	  break;
       }
 
-      Ptr<DO> tosend_do = do_i;
-      Ptr<DU> tosend_du = du_i;
-      Ptr<Face> foutFace;
+      return false;
+    }
 
-      // Pointers to use when we have DO or DU PDUs
-      std::pair<Ptr<Face>, Address> tmp;
-      Address destAddr;
-      NNNAddress newdst;
-      Ptr<NNNAddress> newdstPtr;
-      Ptr<const NNNAddress> constdstPtr;
-      Ptr<DO> do_o_spec;
-      Ptr<DU> du_o_spec;
-      bool nnptRedirect = false;
+    template<class PDU>
+    bool
+    ForwardingStrategy::TypedPropagateData (Ptr<PDU> pdu, Ptr<Face> inFace, Ptr<const ndn::Data> data)
+    {
+      typedef PDUTraits<PDU> traits;
 
-      if (wasDO || wasDU)
-	{
-	  // First obtain the name
-	  if (wasDO)
-	    {
-	      newdst = do_i->GetName ();
-	      constdstPtr = do_i->GetNamePtr();
-	      NS_LOG_INFO ("Propagating Data DO heading to (" << newdst << ")");
-	    }
-	  else if (wasDU)
-	    {
-	      newdst = du_i->GetDstName ();
-	      constdstPtr = du_i->GetDstNamePtr();
-	      NS_LOG_INFO ("Propagating Data DU from (" << du_i->GetSrcName() << " ) heading to (" << newdst << ")");
-	    }
+      bool ok = false;
 
-	  // Check if we are already at the destination (search through all the node names acquired)
-	  if (m_node_names->foundName(constdstPtr))
+      // First obtain the name
+      Ptr<const NNNAddress> constdstPtr = traits::GetDstName (pdu);
+      NNNAddress newdst = *constdstPtr;
+      NS_LOG_INFO ("Propagating Data " << traits::GetName () << " heading to (" << newdst << ")");
+
+      // Check if we are already at the destination (search through all the node names acquired)
+      if (m_node_names->foundName(constdstPtr))
+	{
+	  NS_LOG_INFO ("We have reached desired destination, looking for Apps");
+	  Ptr<Face> tmpFace;
+	  // We have reached the destination, look for Apps
+	  for (int i = 0; i < m_faces->GetN (); i++)
 	    {
-	      NS_LOG_INFO ("We have reached desired destination, looking for Apps");
-	      Ptr<Face> tmpFace;
-	      // We have reached the destination, look for Apps
-	      for (int i = 0; i < m_faces->GetN (); i++)
+	      tmpFace = m_faces->Get (i);
+	      // Check that the Face is of type APPLICATION
+	      if (tmpFace->isAppFace ())
 		{
-		  tmpFace = m_faces->Get (i);
-		  // Check that the Face is of type APPLICATION
-		  if (tmpFace->isAppFace ())
+		  ok = traits::Send (tmpFace, pdu);
+
+		  if (!ok)
 		    {
-		      if (wasDO)
-			ok = tmpFace->SendDO (do_i);
-		      else if (wasDU)
-			ok = tmpFace->SendDU (du_i);
+		      // Log Data drops
+		      m_dropData (data, tmpFace);
+		      DropTrace<PDU> () (pdu, tmpFace);
 
-		      if (!ok)
-			{
-			  // Log Data drops
-			  m_dropData (data, tmpFace);
-			  if (wasDO)
-			    m_dropDOs (do_i, tmpFace);
-			  else if (wasDU)
-			    m_dropDUs (du_i, tmpFace);
-
-			  NS_LOG_DEBUG ("Cannot satisfy data to " << *tmpFace);
-			}
-		      else
-			{
-			  // Log that a Data PDU was sent
-			  m_outData (data, false, tmpFace);
+		      NS_LOG_DEBUG ("Cannot satisfy data to " << *tmpFace);
+		    }
+		  else
+		    {
+		      // Log that a Data PDU was sent
+		      m_outData (data, false, tmpFace);
 
-			  if (wasDO)
-			    {
-			      NS_LOG_INFO ("Satisfying with DO");
-			      m_outDOs (do_i, tmpFace);
-			    }
-			  else if (wasDU)
-			    {
-			      NS_LOG_INFO ("Satisfying with DU");
-			      m_outDUs (du_i, tmpFace);
-			    }
-			}
+		      NS_LOG_INFO ("Satisfying with " << traits::GetName ());
+		      OutTrace<PDU> () (pdu, tmpFace);
 		    }
 		}
-	      return ok;
 	    }
+	  return ok;
+	}
 
-	  // We may have obtained a DEN so we need to check
-	  if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
-	    {
-	      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
+      bool nnptRedirect = m_nnpt->foundOldName(constdstPtr);
 
-	      if (wasDO)
-		{
-		  NS_LOG_INFO ("Buffering DO");
-		  m_node_pdu_buffer->PushDO (newdst, do_i);
-		}
-	      else if (wasDU)
-		{
-		  NS_LOG_INFO ("Buffering DU");
-		  m_node_pdu_buffer->PushDU (newdst, du_i);
-		}
-	    }
+      // We may have obtained a DEN so we need to check
+      if (!nnptRedirect && m_node_pdu_buffer->DestinationExists (newdst))
+	{
+	  NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
 
-	  // Check if the NNPT has any information for this particular 3N name
-	  if (m_nnpt->foundOldName(constdstPtr))
-	    {
-	      // Retrieve the new 3N name destination and update variable
-	      newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
-	      // Flag that the NNPT made a change
-	      nnptRedirect = true;
-	    }
+	  NS_LOG_INFO ("Buffering " << traits::GetName ());
+	  traits::Buffer (m_node_pdu_buffer, newdst, pdu);
+	}
 
-	  if (nnptRedirect)
-	    {
-	      NS_LOG_INFO ("On (" << GetNode3NName () << ") we are create redirect from (" << *constdstPtr << ") to (" << newdst << ")");
-	      if (wasDO)
-		{
-		  // Create a new DO PDU to send the data
-		  do_o_spec = Create<DO> ();
-		  // Set the new 3N name
-		  do_o_spec->SetName (newdst);
-		  // Set the lifetime of the 3N PDU
-		  do_o_spec->SetLifetime (m_3n_lifetime);
-		  // Configure payload for PDU
-		  do_o_spec->SetPayload (icn_pdu);
-		  // Signal that the PDU had an ICN PDU as payload
-		  do_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		  tosend_do = do_o_spec;
-		}
-	      else if (wasDU)
-		{
-		  // Create a new DU PDU to send the data
-		  du_o_spec = Create<DU> ();
-		  // Use the original DU's Src 3N name
-		  du_o_spec->SetSrcName (du_i->GetSrcName ());
-		  // Set the new 3N name destination
-		  du_o_spec->SetDstName (newdst);
-		  // Set the lifetime of the 3N PDU
-		  du_o_spec->SetLifetime (m_3n_lifetime);
-		  // Configure payload for PDU
-		  du_o_spec->SetPayload (icn_pdu);
-		  // Signal that the PDU had an ICN PDU as payload
-		  du_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		  tosend_du = du_o_spec;
-		}
-	    }
+      Ptr<PDU> tosend = pdu;
 
-	  // Roughly find the next hop
-	  tmp = m_nnst->ClosestSectorFaceInfo (newdst, 0);
+      // Check if the NNPT has any information for this particular 3N name
+      if (nnptRedirect)
+	{
+	  // Retrieve the new 3N name destination and update variable
+	  newdst = m_nnpt->findPairedNamePtr (constdstPtr)->getName ();
 
-	  // Update the variables for Face and PoA name
-	  foutFace = tmp.first;
-	  destAddr = tmp.second;
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") we are create redirect from (" << *constdstPtr << ") to (" << newdst << ")");
+	  // Copy the PDU with the new 3N name and lifetime, patching
+	  // the received header instead of building the PDU again
+	  tosend = traits::Redirect (pdu, newdst, m_3n_lifetime);
+	}
 
+      // Roughly find the next hop
+      std::pair<Ptr<Face>, Address> tmp = FlowNextHop (newdst, data->GetName (), 0);
 
-	  if (wasDO)
-	    ok = foutFace->SendDO (tosend_do, destAddr);
-	  else if (wasDU)
-	    ok = foutFace->SendDU (tosend_du, destAddr);
+      // Update the variables for Face and PoA name
+      Ptr<Face> foutFace = tmp.first;
+      Address destAddr = tmp.second;
 
-	  if (!ok)
-	    {
-	      // Log Data drops
-	      m_dropData (data, foutFace);
-	      if (wasDO)
-		m_dropDOs (tosend_do, foutFace);
-	      else if (wasDU)
-		m_dropDUs (tosend_du, foutFace);
-
-	      NS_LOG_DEBUG ("Cannot satisfy data to " << *foutFace);
-	    }
-	  else
-	    {
-	      // Log that a Data PDU was sent
-	      m_outData (data, false, foutFace);
+      ok = traits::Send (foutFace, tosend, destAddr);
 
-	      if (wasDO)
-		{
-		  NS_LOG_INFO ("Satisfying with DO");
-		  m_outDOs (tosend_do, foutFace);
-		}
-	      else if (wasDU)
-		{
-		  NS_LOG_INFO ("Satisfying with DU");
-		  m_outDUs (tosend_du, foutFace);
-		}
-	    }
-	}
+      if (!ok)
+	{
+	  // Log Data drops
+	  m_dropData (data, foutFace);
+	  DropTrace<PDU> () (tosend, foutFace);
 
+	  NS_LOG_DEBUG ("Cannot satisfy data to " << *foutFace);
+	}
       else
 	{
-	  NS_LOG_INFO ("Received either NULL or SO, for which without a PIT entry can do nothing with");
+	  // Log that a Data PDU was sent
+	  m_outData (data, false, foutFace);
+
+	  NS_LOG_INFO ("Satisfying with " << traits::GetName ());
+	  OutTrace<PDU> () (tosend, foutFace);
 	}
 
       return ok;
@@ -3113,12 +3170,30 @@ namespace ns3
 	  m_contentStore = GetObject<ndn::ContentStore> ();
 	}
 
+      // Share the node lease wheel with the internal tables
+      Ptr<LeaseWheel> wheel = GetObject<LeaseWheel> ();
+      if (wheel != 0)
+	{
+	  m_awaiting_response->SetLeaseWheel (wheel);
+	  m_node_names->SetLeaseWheel (wheel);
+	  m_leased_names->SetLeaseWheel (wheel);
+	}
+
       Object::NotifyNewAggregate ();
     }
 
     void
     ForwardingStrategy::DoDispose ()
     {
+      for (std::list<Ptr<FlushJob> >::iterator i = m_flush_jobs.begin (); i != m_flush_jobs.end (); ++i)
+	Simulator::Cancel ((*i)->event);
+      m_flush_jobs.clear ();
+
+      m_enroll_event.Cancel ();
+      m_reenroll_event.Cancel ();
+      m_enroll_flush.Cancel ();
+      m_pending_enrollments.clear ();
+
       m_nnpt = 0;
       m_nnst = 0;
 
@@ -23,10 +23,17 @@
 #include <ns3-dev/ns3/address.h>
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/callback.h>
+#include <ns3-dev/ns3/data-rate.h>
+#include <ns3-dev/ns3/event-id.h>
 #include <ns3-dev/ns3/object.h>
 #include <ns3-dev/ns3/packet.h>
+#include <ns3-dev/ns3/random-variable.h>
 #include <ns3-dev/ns3/traced-callback.h>
 
+#include <list>
+#include <map>
+#include <vector>
+
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
@@ -38,6 +45,7 @@ namespace ns3
 {
   namespace ndn
   {
+    class Name;
     class Interest;
     class Data;
     class ContentStore;
@@ -164,6 +172,22 @@ namespace ns3
       virtual Time
       GetRetxTimer () const;
 
+      /**
+       * @brief Buffer holding the PDUs headed to 3N names leaving the node
+       *
+       * Also reachable as the PDUBuffer attribute, so its limits can be set
+       * and its traces connected per node, e.g. with
+       * /NodeList/[i]/$ns3::nnn::ForwardingStrategy/PDUBuffer/Drop
+       */
+      Ptr<PDUBuffer>
+      GetPDUBuffer () const;
+
+      /**
+       * @brief Number of multipath decisions that picked face
+       */
+      uint64_t
+      GetMultipathSplits (Ptr<Face> face) const;
+
       virtual void
       flushBuffer (Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName);
 
@@ -267,8 +291,28 @@ namespace ns3
       virtual void
       OnDU (Ptr<Face> face, Ptr<DU> du_p);
 
+      /**
+       * \brief Decode the ICN PDU carried by a 3N data transfer PDU
+       *
+       * The decoded Interest or Data keeps icn_pdu as its wire encoding,
+       * so the outgoing 3N PDUs share it instead of encoding it again
+       */
       virtual void
-      ProcessICNPDU (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<Packet> icn_pdu);
+      ProcessICNPDU (Ptr<NNNPDU> pdu, Ptr<Face> face, Ptr<const Packet> icn_pdu);
+
+      /**
+       * \brief Encoded form of the Interest, only encoded if it was not
+       * received from the network or was modified since
+       */
+      static Ptr<const Packet>
+      GetICNWire (Ptr<const ndn::Interest> interest);
+
+      /**
+       * \brief Encoded form of the Data, only encoded if it was not
+       * received from the network or was modified since
+       */
+      static Ptr<const Packet>
+      GetICNWire (Ptr<const ndn::Data> data);
 
       void
       UpdatePITEntry (Ptr<pit::Entry> pitEntry, Ptr<NNNPDU> pdu, Ptr<Face> face, Time lifetime);
@@ -679,11 +723,214 @@ namespace ns3
       DoPropagateData (Ptr<NNNPDU> pdu,
                        Ptr<Face> inFace,
                        Ptr<const ndn::Data> data);
+
+      /**
+       * @brief Pick the Face and PoA to use towards a 3N name destination
+       *
+       * The base class returns the skip-th candidate of the NNST entry
+       * closest to dst, in (status, routing cost) order. DoPropagateInterest
+       * calls it with an increasing skip, starting from 0 for every
+       * Interest, until an Interest could be sent or a null Face is returned
+       *
+       * @param dst      3N name destination of the PDU
+       * @param skip     number of candidates already attempted
+       * @param pitEntry PIT entry the Interest belongs to
+       */
+      virtual std::pair<Ptr<Face>, Address>
+      SelectNextHop (const NNNAddress &dst,
+                     uint32_t skip,
+                     Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief Pick the Face and PoA to use towards dst for a PDU of an ICN flow
+       *
+       * With Multipath disabled this is the skip-th NNST candidate. Otherwise
+       * flows are spread over the GREEN candidates of the NNST entry, each
+       * weighted by the inverse of its routing cost. The same flow keeps the
+       * same candidate while the candidate set does not change
+       *
+       * @param dst  3N name destination of the PDU
+       * @param flow ICN name carried by the PDU. The last component (the
+       *             sequence number) is not part of the flow identity
+       * @param skip number of candidates already attempted
+       */
+      std::pair<Ptr<Face>, Address>
+      FlowNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip);
     protected:
       // inherited from Object class
       virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
       virtual void DoDispose (); ///< @brief Do cleanup
 
+      /**
+       * @brief Trace of outgoing PDUs of type PDU, specialized for NULLp, SO, DO and DU
+       */
+      template<class PDU>
+      TracedCallback<Ptr<const PDU>, Ptr<const Face> > &
+      OutTrace ();
+
+      /**
+       * @brief Trace of dropped PDUs of type PDU, specialized for NULLp, SO, DO and DU
+       */
+      template<class PDU>
+      TracedCallback<Ptr<const PDU>, Ptr<const Face> > &
+      DropTrace ();
+
+      /**
+       * @brief Send a PDU carrying Data through outFace and trace the result
+       */
+      template<class PDU>
+      bool
+      SatisfyWith (Ptr<PDU> pdu, Ptr<Face> inFace, Ptr<Face> outFace,
+                   Ptr<const ndn::Data> data, Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief SatisfyPendingInterest once the type of the 3N PDU is known
+       */
+      template<class PDU>
+      void
+      TypedSatisfyPendingInterest (Ptr<PDU> pdu, Ptr<Face> inFace,
+                                   Ptr<const ndn::Data> data, Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief TrySendOutInterest once the type of the 3N PDU is known
+       */
+      template<class PDU>
+      bool
+      TypedTrySendOutInterest (Ptr<PDU> pdu, Ptr<Face> inFace, Ptr<Face> outFace, Address addr,
+                               Ptr<const ndn::Interest> interest, Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief DoPropagateInterest for the PDUs with a 3N name destination (DO and DU)
+       */
+      template<class PDU>
+      bool
+      TypedPropagateInterest (Ptr<PDU> pdu, Ptr<Face> inFace,
+                              Ptr<const ndn::Interest> interest, Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief DoPropagateData for the PDUs with a 3N name destination (DO and DU)
+       */
+      template<class PDU>
+      bool
+      TypedPropagateData (Ptr<PDU> pdu, Ptr<Face> inFace, Ptr<const ndn::Data> data);
+
+      /**
+       * @brief State of a flush of buffered PDUs towards a new 3N name
+       */
+      struct FlushJob : public SimpleRefCount<FlushJob>
+      {
+	Ptr<NNNAddress> oldName;
+	Ptr<NNNAddress> newName;
+	std::vector<Ptr<Packet> > pdus; ///< @brief PDUs popped from the buffer
+	size_t next;                    ///< @brief Index of the next PDU to send
+	Ptr<Face> face;                 ///< @brief Best next hop towards newName, resolved once
+	Address addr;                   ///< @brief Link address of the next hop
+	DataRate rate;                  ///< @brief Rate the bursts are paced to
+	Time start;
+	uint32_t bytes;
+	uint32_t do_flush;
+	uint32_t du_flush;
+	EventId event;
+      };
+
+      /**
+       * @brief Send the next burst of a flush and schedule the one after
+       * it once the burst has left the outgoing link
+       */
+      virtual void
+      FlushBurst (Ptr<FlushJob> job);
+
+      /**
+       * @brief Rename and send one buffered PDU
+       *
+       * The next hop comes from FlowNextHop, so with Multipath enabled each
+       * flow is spread on its own and the flush is only paced to the best
+       * next hop. PDUs without a route are reported through the DropDOs
+       * and DropDUs traces with a null Face
+       *
+       * @returns size of the PDU sent, 0 if it could not be sent
+       */
+      virtual uint32_t
+      FlushPDU (Ptr<FlushJob> job, Ptr<Packet> queuePDU);
+
+      /**
+       * @brief ICN name carried in the payload of a buffered PDU, used as
+       * its flow by FlowNextHop
+       *
+       * @returns empty name if the payload is not a decodable NDN PDU
+       */
+      ndn::Name
+      PayloadFlow (Ptr<const Packet> payload, uint16_t payloadType) const;
+
+      /**
+       * @brief Rate used to pace flushes going out of face
+       */
+      DataRate
+      GetFlushRate (Ptr<Face> face) const;
+
+      /**
+       * @brief Answer an EN with a freshly produced 3N name
+       *
+       * @param personalPoas PoA names of this node, as given by GetAllPoANames (face)
+       */
+      virtual void
+      AnswerEN (Ptr<Face> face, Ptr<EN> en_p, const std::vector<Address> &personalPoas);
+
+      /**
+       * @brief Answer a REN with a freshly produced 3N name and record it in the NNPT
+       *
+       * @param personalPoas PoA names of this node, as given by GetAllPoANames (face)
+       */
+      virtual void
+      AnswerREN (Ptr<Face> face, Ptr<REN> ren_p, const std::vector<Address> &personalPoas);
+
+      /**
+       * @brief EN or REN waiting for the enrollment aggregation window to close
+       */
+      struct PendingEnrollment
+      {
+	Ptr<Face> face;
+	Ptr<EN> en;     ///< @brief Set when the PDU is an EN
+	Ptr<REN> ren;   ///< @brief Set when the PDU is a REN
+      };
+
+      /**
+       * @brief Hold an EN or REN until the aggregation window closes
+       *
+       * A newer EN or REN from the same PoA on the same Face replaces the
+       * pending one, which is dropped
+       */
+      void
+      QueueEnrollment (Ptr<Face> face, Ptr<EN> en_p, Ptr<REN> ren_p);
+
+      /**
+       * @brief Answer all the pending ENs and RENs, computing the PoA names
+       * of each Face once
+       */
+      void
+      FlushEnrollments ();
+
+      /**
+       * @brief Send the ENs for one enrollment attempt and schedule the next
+       */
+      void
+      SendEnroll ();
+
+      /**
+       * @brief Send the RENs for one reenrollment attempt and schedule the next
+       */
+      void
+      SendReenroll ();
+
+      /**
+       * @brief Time to wait after attempt number attempt (starting at 0)
+       *
+       * AckTimeout * EnrollBackoffMultiplier^attempt, capped at
+       * EnrollBackoffMax and spread by EnrollJitter
+       */
+      Time
+      GetEnrollBackoff (uint32_t attempt);
+
     protected:
       Ptr<NNPT> m_nnpt; ///< \brief Reference to NNPT
       Ptr<NNST> m_nnst; ///< \brief Reference to NNST
@@ -692,8 +939,16 @@ namespace ns3
       Ptr<FaceContainer> m_faces; ///< \brief List of Faces attached to this node
       Ptr<NamesContainer> m_node_names; ///< \brief 3N names container for personal names
       Ptr<NamesContainer> m_leased_names; ///< \brief 3N names container for node leased names
+      Ptr<const NNNAddress> m_node_name; ///< \brief Cached result of m_node_names->findNewestName ()
+      uint32_t m_node_name_version; ///< \brief m_node_names version m_node_name was taken at
 
       Ptr<PDUBuffer> m_node_pdu_buffer; /// <\brief Buffer for Node using forwarding strategy
+      std::list<Ptr<FlushJob> > m_flush_jobs; ///< \brief Flushes of m_node_pdu_buffer in progress
+      uint32_t m_flush_burst; ///< \brief PDUs sent back to back when flushing, 0 sends all at once
+      DataRate m_flush_rate; ///< \brief Pacing rate for flushes, 0 uses the outgoing device DataRate
+
+      bool m_multipath; ///< \brief Spread DO/DU flows over all GREEN NNST candidates
+      std::map<uint32_t, uint64_t> m_split_counts; ///< \brief Multipath decisions per Face id
 
       Ptr<Pit> m_pit; ///< \brief Reference to PIT to which this forwarding strategy is associated
       Ptr<Fib> m_fib; ///< \brief Reference to FIB to which this forwarding strategy is associated
@@ -716,6 +971,19 @@ namespace ns3
       bool m_on_ren_oen;
       bool m_sent_ren;
 
+      double m_enroll_backoff_multiplier; ///< \brief Growth of the EN/REN retry time per attempt
+      Time m_enroll_backoff_max;          ///< \brief Largest EN/REN retry time
+      double m_enroll_jitter;             ///< \brief Retry times are spread by +/- this fraction
+      UniformVariable m_enroll_rand;      ///< \brief Random numbers for the retry jitter
+      uint32_t m_enroll_attempt;          ///< \brief EN attempts since the last Enroll
+      uint32_t m_reenroll_attempt;        ///< \brief REN attempts since the last Reenroll
+      EventId m_enroll_event;             ///< \brief Next EN attempt
+      EventId m_reenroll_event;           ///< \brief Next REN attempt
+
+      Time m_enroll_window;               ///< \brief ENs and RENs are answered in batches this far apart, 0 answers at once
+      std::map<std::pair<uint32_t, Address>, PendingEnrollment> m_pending_enrollments; ///< \brief By Face id and PoA
+      EventId m_enroll_flush;             ///< \brief Closing of the aggregation window
+
       ////////////////////////////////////////////////////////////////////
 
       TracedCallback<Ptr<const EN>,
@@ -860,6 +1128,12 @@ namespace ns3
       TracedCallback<> m_got3Nname;
       TracedCallback<> m_no3Nname;
 
+      TracedCallback<Ptr<const NNNAddress>, Ptr<const NNNAddress>,
+      uint32_t /*PDUs*/, uint32_t /*bytes*/, Time /*duration*/> m_flushed; ///< @brief trace of finished buffer flushes
+
+      TracedCallback<Ptr<const NNNAddress> /*NNST entry*/, Ptr<const Face>,
+      uint64_t /*flows sent*/> m_multipathSplit; ///< @brief trace of the Face picked by each multipath decision
+
     private:
       // Number generator
       boost::random::mt19937_64 gen;
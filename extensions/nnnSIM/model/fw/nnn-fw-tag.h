@@ -0,0 +1,45 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-fw-tag.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-fw-tag.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-fw-tag.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_FW_TAG_H_
+#define NNN_FW_TAG_H_
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace fw
+    {
+      /**
+       * @ingroup nnn-fw
+       * @brief Base class for the state a forwarding strategy keeps in a PIT entry
+       *
+       * @see pit::Entry::AddFwTag
+       */
+      class Tag
+      {
+      public:
+	virtual
+	~Tag () { }
+      };
+    } // namespace fw
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* NNN_FW_TAG_H_ */
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pdu-traits.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pdu-traits.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pdu-traits.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_PDU_TRAITS_H_
+#define NNN_PDU_TRAITS_H_
+
+#include <ns3-dev/ns3/address.h>
+#include <ns3-dev/ns3/ptr.h>
+
+#include "../nnn-face.h"
+#include "../nnn-pdus.h"
+#include "../nnn-naming.h"
+#include "../buffers/nnn-pdu-buffer.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-fw
+     * @brief Compile time description of a 3N data transfer PDU type
+     *
+     * Lets the forwarding strategy resolve the PDU type once per packet and
+     * then run code specialized for it, instead of casting and branching
+     * on the type at every send, trace and drop.
+     */
+    template<class PDU>
+    struct PDUTraits;
+
+    template<>
+    struct PDUTraits<NULLp>
+    {
+      static const uint32_t PacketId = NULL_NNN;
+      static const bool HasSrcName = false;  ///< @brief PDU carries the 3N name of its source
+      static const bool HasDstName = false;  ///< @brief PDU carries a 3N name destination
+
+      static const char *
+      GetName () { return "NULLp"; }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const NULLp> pdu) { return face->SendNULLp (pdu); }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const NULLp> pdu, Address addr) { return face->SendNULLp (pdu, addr); }
+
+      static Ptr<const NNNAddress>
+      GetSrcName (Ptr<const NULLp> pdu) { return 0; }
+
+      static Ptr<const NNNAddress>
+      GetDstName (Ptr<const NULLp> pdu) { return 0; }
+
+      static void
+      Buffer (Ptr<PDUBuffer> buffer, const NNNAddress &dst, Ptr<const NULLp> pdu) { }
+    };
+
+    template<>
+    struct PDUTraits<SO>
+    {
+      static const uint32_t PacketId = SO_NNN;
+      static const bool HasSrcName = true;
+      static const bool HasDstName = false;
+
+      static const char *
+      GetName () { return "SO"; }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const SO> pdu) { return face->SendSO (pdu); }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const SO> pdu, Address addr) { return face->SendSO (pdu, addr); }
+
+      static Ptr<const NNNAddress>
+      GetSrcName (Ptr<const SO> pdu) { return pdu->GetNamePtr (); }
+
+      static Ptr<const NNNAddress>
+      GetDstName (Ptr<const SO> pdu) { return 0; }
+
+      static void
+      Buffer (Ptr<PDUBuffer> buffer, const NNNAddress &dst, Ptr<const SO> pdu) { }
+    };
+
+    template<>
+    struct PDUTraits<DO>
+    {
+      static const uint32_t PacketId = DO_NNN;
+      static const bool HasSrcName = false;
+      static const bool HasDstName = true;
+
+      static const char *
+      GetName () { return "DO"; }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const DO> pdu) { return face->SendDO (pdu); }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const DO> pdu, Address addr) { return face->SendDO (pdu, addr); }
+
+      static Ptr<const NNNAddress>
+      GetSrcName (Ptr<const DO> pdu) { return 0; }
+
+      static Ptr<const NNNAddress>
+      GetDstName (Ptr<const DO> pdu) { return pdu->GetNamePtr (); }
+
+      static void
+      Buffer (Ptr<PDUBuffer> buffer, const NNNAddress &dst, Ptr<const DO> pdu) { buffer->PushDO (dst, pdu); }
+
+      static Ptr<DO>
+      Redirect (Ptr<const DO> pdu, const NNNAddress &dst, Time lifetime) { return Wire::RedirectDO (pdu, dst, lifetime); }
+    };
+
+    template<>
+    struct PDUTraits<DU>
+    {
+      static const uint32_t PacketId = DU_NNN;
+      static const bool HasSrcName = true;
+      static const bool HasDstName = true;
+
+      static const char *
+      GetName () { return "DU"; }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const DU> pdu) { return face->SendDU (pdu); }
+
+      static bool
+      Send (Ptr<Face> face, Ptr<const DU> pdu, Address addr) { return face->SendDU (pdu, addr); }
+
+      static Ptr<const NNNAddress>
+      GetSrcName (Ptr<const DU> pdu) { return pdu->GetSrcNamePtr (); }
+
+      static Ptr<const NNNAddress>
+      GetDstName (Ptr<const DU> pdu) { return pdu->GetDstNamePtr (); }
+
+      static void
+      Buffer (Ptr<PDUBuffer> buffer, const NNNAddress &dst, Ptr<const DU> pdu) { buffer->PushDU (dst, pdu); }
+
+      static Ptr<DU>
+      Redirect (Ptr<const DU> pdu, const NNNAddress &dst, Time lifetime) { return Wire::RedirectDU (pdu, dst, lifetime); }
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* NNN_PDU_TRAITS_H_ */
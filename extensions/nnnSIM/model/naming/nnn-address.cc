@@ -39,17 +39,23 @@ ATTRIBUTE_HELPER_CPP (NNNAddress);
 ///////////////////////////////////////////////////////////////////////////////
 
 NNNAddress::NNNAddress ()
+: m_packable (true)
 {
 }
 
 NNNAddress::NNNAddress (const NNNAddress &other)
+: m_packed (other.m_packed)
+, m_packable (other.m_packable)
 {
-  m_address_comp = other.m_address_comp;
+  // Packable components are rebuilt on demand rather than copied
+  if (!m_packable)
+    m_address_comp = other.m_address_comp;
 }
 
 // Create a valid NNN address
 // No more than 16 hexadecimal characters with a maximum of 15 "."
 NNNAddress::NNNAddress (const string &name)
+: m_packable (true)
 {
   string::const_iterator i = name.begin ();
   string::const_iterator end = name.end ();
@@ -106,8 +112,10 @@ NNNAddress::NNNAddress (const string &name)
 }
 
 NNNAddress::NNNAddress (const std::vector<name::Component> name)
+: m_packable (true)
 {
-  m_address_comp = name;
+  for (NNNAddress::const_iterator i = name.begin (); i != name.end (); i++)
+    appendComponent (*i);
 }
 
 const name::Component &
@@ -124,30 +132,19 @@ NNNAddress::get (int index) const
       << error::msg ("Index out of range")
       << error::pos (index));
     }
-  return m_address_comp [index];
-}
-
-name::Component &
-NNNAddress::get (int index)
-{
-  if (index < 0)
-    {
-      index = size () - (-index);
-    }
-
-  if (static_cast<unsigned int> (index) >= size())
-    {
-      BOOST_THROW_EXCEPTION (error::NNNAddress ()
-      << error::msg ("Index out of range")
-      << error::pos (index));
-    }
+  materialize ();
   return m_address_comp [index];
 }
 
 NNNAddress &
 NNNAddress::operator= (const NNNAddress &other)
 {
-  m_address_comp = other.m_address_comp;
+  if (other.m_packable)
+    m_address_comp.clear ();
+  else
+    m_address_comp = other.m_address_comp;
+  m_packed = other.m_packed;
+  m_packable = other.m_packable;
   return *this;
 }
 
@@ -159,9 +156,7 @@ NNNAddress::getName () const
   } else
     {
       // Copy the old name
-      std::vector<name::Component> sectorName (m_address_comp);
-
-      return NNNAddress (sectorName);
+      return NNNAddress (*this);
     }
 }
 
@@ -172,13 +167,18 @@ NNNAddress::getSectorName () const
       return NNNAddress ();
   } else
     {
-      // Copy the old name
-      std::vector<name::Component> sectorName (m_address_comp);
+      NNNAddress sectorName;
 
-      // Eliminate the last position
-      sectorName.pop_back();
+      if (m_packable)
+	sectorName.m_packed = m_packed.getSectorName ();
+      else
+	{
+	  // Copy the old name, minus the last position
+	  for (NNNAddress::const_iterator i = begin (); i != end () - 1; i++)
+	    sectorName.appendComponent (*i);
+	}
 
-      return NNNAddress (sectorName);
+      return sectorName;
     }
 }
 
@@ -193,6 +193,18 @@ NNNAddress::toDotHex () const
 void
 NNNAddress::toDotHex (std::ostream &os) const
 {
+  if (m_packable)
+    {
+      // Components print their label in hexadecimal, so the labels do too
+      for (uint8_t k = 0; k < m_packed.size (); k++)
+	{
+	  if (k != 0)
+	    os << SEP;
+	  os << std::hex << m_packed.getLabel (k);
+	}
+      return;
+    }
+
   for (NNNAddress::const_iterator comp = begin (); comp != end (); comp++)
     {
       comp->toHex (os);
@@ -207,6 +219,9 @@ NNNAddress::toDotHex (std::ostream &os) const
 int
 NNNAddress::compare (const NNNAddress &name) const
 {
+  if (bothPacked (name))
+    return m_packed.compare (name.m_packed);
+
   NNNAddress::const_iterator i = this->begin ();
   NNNAddress::const_iterator j = name.begin ();
 
@@ -237,6 +252,9 @@ NNNAddress::compareLabels(const NNNAddress & name) const
   else if (!this->isEmpty() && name.isEmpty ())
     return 1;
 
+  if (bothPacked (name))
+    return m_packed.compareLabels (name.m_packed);
+
   NNNAddress::const_iterator i = this->begin ();
   NNNAddress::const_iterator j = name.begin ();
 
@@ -267,6 +285,9 @@ NNNAddress::compareLabels(const NNNAddress & name) const
 bool
 NNNAddress::isSameSector (const NNNAddress &name) const
 {
+  if (bothPacked (name))
+    return (m_packed.getSectorName () == name.m_packed.getSectorName ());
+
   NNNAddress currSec = getSectorName();
   NNNAddress nameSec = name.getSectorName();
 
@@ -277,6 +298,8 @@ NNNAddress::isSameSector (const NNNAddress &name) const
 bool
 NNNAddress::isSubSector (const NNNAddress &name) const
 {
+  if (bothPacked (name))
+    return name.m_packed.isPrefixOf (m_packed);
 
   if (name.size () <= this->size ())
     {
@@ -303,6 +326,9 @@ NNNAddress::isSubSector (const NNNAddress &name) const
 bool
 NNNAddress::isParentSector (const NNNAddress &name) const
 {
+  if (bothPacked (name))
+    return (name.size () > size () && m_packed.isPrefixOf (name.m_packed));
+
   if (name.size () > this->size ())
     {
       NNNAddress::const_iterator i = this->begin ();
@@ -344,7 +370,14 @@ NNNAddress::getLastLabel () const
       return NNNAddress ();
   } else
     {
-      return NNNAddress ().append(m_address_comp.at(size() -1));
+      NNNAddress lastLabel;
+
+      if (m_packable)
+	lastLabel.m_packed.append (m_packed.getLastLabel ());
+      else
+	lastLabel.appendComponent (m_address_comp.back ());
+
+      return lastLabel;
     }
 }
 
@@ -368,7 +401,7 @@ NNNAddress::getClosestSector (const NNNAddress &name) const
   // If the same, then the top level is the closest sector
   if (res == 0)
     {
-      return NNNAddress (m_address_comp);
+      return NNNAddress (*this);
       // The address given is smaller than the one we have
     }
   else if ( res == 1)
@@ -445,69 +478,94 @@ NNNAddress::ConvertFrom (const Address &address)
   return NNNAddress(tmp->toDotHex());
 }
 
+size_t
+NNNAddress::commonLabels (const NNNAddress &name) const
+{
+  if (bothPacked (name))
+    return m_packed.commonLabels (name.m_packed);
+
+  NNNAddress::const_iterator i = this->begin ();
+  NNNAddress::const_iterator j = name.begin ();
+  size_t common = 0;
+
+  for (; i != this->end () && j != name.end (); i++, j++)
+    {
+      if (i->toNumber () != j->toNumber ())
+	break;
+
+      common++;
+    }
+
+  return common;
+}
+
 int
 NNNAddress::distance (const NNNAddress &name) const
 {
-  //std::cout << "Comparing " << *this << " with " << name << std::endl;
-  int res = compare(name);
+  // The distance is the number of sectors crossed going up from one
+  // address to the common sector and then down to the other address
+  int common = commonLabels (name);
+  int hops = size () + name.size () - 2 * common;
 
-  if (res == 0)
-    return 0;
-  else
-    {
-      NNNAddress::const_iterator i = this->begin ();
-      NNNAddress::const_iterator j = name.begin ();
-      if (isToplvlSector())
-	{
-	  int fin = name.size ();
-	  if (i->compare(*j) == 0)
-	    return fin - 1;
-	  else
-	    return fin;
-	}
+  // Top level sectors are considered to be one hop away from each other
+  if (common == 0 && hops > 0)
+    hops--;
 
-      if (name.isToplvlSector())
-	{
-	  int fin = size ();
-	  if (i->compare(*j) == 0)
-	    return fin - 1;
-	  else
-	    return fin;
-	}
+  return hops;
+}
 
-      int s1 = size ();
-      int s2 = name.size ();
-      if (s1 == s2)
-	{
-	  if (isSameSector(name))
-	    {
-	      return 2;
-	    }
+bool
+NNNAddress::canAppendComponent()
+{
+  return (size() < MAXCOMP);
+}
 
-	  if (res == 1)
-	    {
-	      return getSectorName ().distance(name) + 1;
-	    }
-	  else
-	    {
-	      return distance(name.getSectorName ()) + 1;
-	    }
-	}
-      else if (s1 > s2)
-	{
-	  return getSectorName ().distance(name) + 1;
-	}
-      else
+void
+NNNAddress::appendComponent (const name::Component &comp)
+{
+  if (m_packable && isCanonical (comp))
+    {
+      appendLabel (comp.toNumber ());
+      return;
+    }
+
+  // The component can't be rebuilt from its label, keep them all
+  materialize ();
+  m_packable = false;
+  packComponent (comp);
+  m_address_comp.push_back (comp);
+}
+
+void
+NNNAddress::appendLabel (uint64_t label)
+{
+  if (m_packable)
+    {
+      PackedNNNAddress packed = m_packed;
+      if (packed.append (label))
 	{
-	  return distance(name.getSectorName ()) + 1;
+	  m_packed = packed;
+	  m_address_comp.clear ();
+	  return;
 	}
+
+      // Over 16 digits, the components have to be stored from now on
+      materialize ();
+      m_packable = false;
     }
+
+  m_packed.append (label);
+  m_address_comp.push_back (name::Component ().fromNumber (label));
 }
 
-bool
-NNNAddress::canAppendComponent()
+void
+NNNAddress::buildComponents () const
 {
-  return (size() < MAXCOMP);
+  m_address_comp.clear ();
+  m_address_comp.reserve (m_packed.size ());
+
+  for (uint8_t k = 0; k < m_packed.size (); k++)
+    m_address_comp.push_back (name::Component ().fromNumber (m_packed.getLabel (k)));
 }
 
 NNN_NAMESPACE_END
@@ -32,6 +32,7 @@
 
 #include "../nnn-common.h"
 #include "name-component.h"
+#include "nnn-packed-address.h"
 
 #define SEP '.'
 #define MAXCOMP 16
@@ -40,15 +41,21 @@ NNN_NAMESPACE_BEGIN
 
 /**
  * @brief Class for NNN Address
+ *
+ * Addresses whose labels fit in a PackedNNNAddress are held in packed
+ * form only, the name::Component vector being built the first time the
+ * components are walked. Longer addresses, or addresses with components
+ * which can't be rebuilt from their numerical value, keep the vector.
+ * Components are therefore read only.
  */
 class NNNAddress : public SimpleRefCount<NNNAddress>
 {
 public:
-  typedef std::vector<name::Component>::iterator iterator;
+  typedef std::vector<name::Component>::const_iterator iterator;
   typedef std::vector<name::Component>::const_iterator const_iterator;
-  typedef std::vector<name::Component>::reverse_iterator reverse_iterator;
+  typedef std::vector<name::Component>::const_reverse_iterator reverse_iterator;
   typedef std::vector<name::Component>::const_reverse_iterator const_reverse_iterator;
-  typedef std::vector<name::Component>::reference reference;
+  typedef std::vector<name::Component>::const_reference reference;
   typedef std::vector<name::Component>::const_reference const_reference;
 
   typedef name::Component partial_type;
@@ -182,42 +189,20 @@ public:
   const name::Component &
   get (int index) const;
 
-  /**
-   * @brief Get binary blob of name component
-   * @param index index of the name component.  If less than 0, then getting component from the back
-   * @returns reference to binary blob of the requested name component
-   *
-   * If index is out of range, an exception will be thrown
-   */
-  name::Component &
-  get (int index);
-
   /////
   ///// Iterator interface to name components
   /////
   inline NNNAddress::const_iterator
-  begin () const;           ///< @brief Begin iterator (const)
-
-  inline NNNAddress::iterator
-  begin ();                 ///< @brief Begin iterator
+  begin () const;           ///< @brief Begin iterator
 
   inline NNNAddress::const_iterator
-  end () const;             ///< @brief End iterator (const)
-
-  inline NNNAddress::iterator
-  end ();                   ///< @brief End iterator
+  end () const;             ///< @brief End iterator
 
   inline NNNAddress::const_reverse_iterator
-  rbegin () const;          ///< @brief Reverse begin iterator (const)
-
-  inline NNNAddress::reverse_iterator
-  rbegin ();                ///< @brief Reverse begin iterator
+  rbegin () const;          ///< @brief Reverse begin iterator
 
   inline NNNAddress::const_reverse_iterator
-  rend () const;            ///< @brief Reverse end iterator (const)
-
-  inline NNNAddress::reverse_iterator
-  rend ();                  ///< @brief Reverse end iterator
+  rend () const;            ///< @brief Reverse end iterator
 
   /////
   ///// Static helpers to convert name component to appropriate value
@@ -336,13 +321,6 @@ public:
   inline bool
   operator > (const NNNAddress &name) const;
 
-  /**
-   * @brief Operator [] to simplify access to name components
-   * @see get
-   */
-  inline name::Component &
-  operator [] (int index);
-
   /**
    * @brief Operator [] to simplify access to name components
    * @see get
@@ -365,9 +343,39 @@ public:
   NNNAddress
   ConvertFrom (const Address &address);
 
+  /**
+   * @brief Number of leading labels both addresses have in common
+   */
+  size_t
+  commonLabels (const NNNAddress &name) const;
+
+  /**
+   * @brief Number of sector hops between two addresses
+   *
+   * Computed from the common prefix length, without building any
+   * intermediate address
+   */
   int
   distance (const NNNAddress &name) const;
 
+  /**
+   * @brief Get the fixed width representation of the address
+   *
+   * The packed representation is only usable when isValid () is true,
+   * that is, when all the labels fit in 16 hexadecimal digits
+   */
+  inline const PackedNNNAddress &
+  getPacked () const;
+
+  /**
+   * @brief Find out if the components can be rebuilt from the packed representation
+   *
+   * True when the packed representation is valid and every component is
+   * the shortest big endian encoding of its label
+   */
+  inline bool
+  isPackable () const;
+
 public:
   // Data Members (public):
   ///  Value returned by various member functions when they fail.
@@ -379,7 +387,52 @@ private:
   bool
   canAppendComponent();
 
-  std::vector<name::Component> m_address_comp;
+  /**
+   * @brief Append a component without checking the component limit
+   */
+  void
+  appendComponent (const name::Component &comp);
+
+  /**
+   * @brief Append the label of a component known to be in shortest form
+   */
+  void
+  appendLabel (uint64_t label);
+
+  /**
+   * @brief Keep the packed representation in sync with a newly appended component
+   */
+  inline void
+  packComponent (const name::Component &comp);
+
+  /**
+   * @brief Find out if comp is the shortest encoding of its label
+   */
+  static inline bool
+  isCanonical (const name::Component &comp);
+
+  /**
+   * @brief Build the components of a packable address if not done yet
+   */
+  inline void
+  materialize () const;
+
+  /**
+   * @brief Rebuild the components from the packed representation
+   */
+  void
+  buildComponents () const;
+
+  /**
+   * @brief Find out if both addresses can be operated on in packed form
+   */
+  inline bool
+  bothPacked (const NNNAddress &name) const;
+
+  // Complete unless packable, then either empty or built by materialize ()
+  mutable std::vector<name::Component> m_address_comp;
+  PackedNNNAddress m_packed;
+  bool m_packable;             ///< @brief Components can be rebuilt from m_packed
 };
 
 inline std::ostream &
@@ -405,49 +458,28 @@ operator >> (std::istream &is, NNNAddress &name)
 inline NNNAddress::const_iterator
 NNNAddress::begin () const
 {
-  return m_address_comp.begin ();
-}
-
-inline NNNAddress::iterator
-NNNAddress::begin ()
-{
+  materialize ();
   return m_address_comp.begin ();
 }
 
 inline NNNAddress::const_iterator
 NNNAddress::end () const
 {
-  return m_address_comp.end ();
-}
-
-inline NNNAddress::iterator
-NNNAddress::end ()
-{
+  materialize ();
   return m_address_comp.end ();
 }
 
 inline NNNAddress::const_reverse_iterator
 NNNAddress::rbegin () const
 {
-  return m_address_comp.rbegin ();
-}
-
-inline NNNAddress::reverse_iterator
-NNNAddress::rbegin ()
-{
+  materialize ();
   return m_address_comp.rbegin ();
 }
 
 inline NNNAddress::const_reverse_iterator
 NNNAddress::rend () const
 {
-  return m_address_comp.rend ();
-}
-
-
-inline NNNAddress::reverse_iterator
-NNNAddress::rend ()
-{
+  materialize ();
   return m_address_comp.rend ();
 }
 
@@ -457,16 +489,59 @@ NNNAddress::rend ()
 
 template<class Iterator>
 NNNAddress::NNNAddress (Iterator begin, Iterator end)
+: m_packable (true)
 {
   append (begin, end);
 }
 
+inline void
+NNNAddress::packComponent (const name::Component &comp)
+{
+  // Components wider than 64 bits can't be represented as a label value
+  if (comp.size () > sizeof (uint64_t))
+    m_packed.invalidate ();
+  else
+    m_packed.append (comp.toNumber ());
+}
+
+inline bool
+NNNAddress::isCanonical (const name::Component &comp)
+{
+  return (comp.size () != 0 && comp.size () <= sizeof (uint64_t) &&
+      (comp.size () == 1 || comp[0] != 0));
+}
+
+inline void
+NNNAddress::materialize () const
+{
+  if (m_packable && m_address_comp.size () != m_packed.size ())
+    buildComponents ();
+}
+
+inline bool
+NNNAddress::bothPacked (const NNNAddress &name) const
+{
+  return (m_packed.isValid () && name.m_packed.isValid ());
+}
+
+inline const PackedNNNAddress &
+NNNAddress::getPacked () const
+{
+  return m_packed;
+}
+
+inline bool
+NNNAddress::isPackable () const
+{
+  return m_packable;
+}
+
 inline NNNAddress &
 NNNAddress::append (const name::Component &comp)
 {
   if (comp.size () != 0)
     if (canAppendComponent())
-      m_address_comp.push_back (comp);
+      appendComponent (comp);
   return *this;
 }
 
@@ -476,8 +551,19 @@ NNNAddress::appendBySwap (name::Component &comp)
   if (comp.size () != 0)
     if (canAppendComponent())
       {
-	NNNAddress::iterator newComp = m_address_comp.insert (end (), name::Component ());
-	newComp->swap (comp);
+	if (m_packable && isCanonical (comp))
+	  {
+	    appendLabel (comp.toNumber ());
+	    name::Component ().swap (comp);
+	  }
+	else
+	  {
+	    materialize ();
+	    m_packable = false;
+	    packComponent (comp);
+	    m_address_comp.push_back (name::Component ());
+	    m_address_comp.back ().swap (comp);
+	  }
       }
   return *this;
 }
@@ -501,7 +587,15 @@ NNNAddress::append (const NNNAddress &comp)
       if (this == &comp)
 	{
 	  // have to double-copy if the object is self, otherwise results very frustrating (because we use vector...)
-	  return append (NNNAddress (comp.begin (), comp.end ()));
+	  return append (NNNAddress (comp));
+	}
+
+      if (comp.m_packable)
+	{
+	  // Take the labels straight from the packed form, without components
+	  for (uint8_t k = 0; k < comp.m_packed.size (); k++)
+	    appendLabel (comp.m_packed.getLabel (k));
+	  return *this;
 	}
       return append (comp.begin (), comp.end ());
     }
@@ -512,7 +606,7 @@ NNNAddress::append (const NNNAddress &comp)
 inline size_t
 NNNAddress::size () const
 {
-  return m_address_comp.size ();
+  return m_packable ? m_packed.size () : m_address_comp.size ();
 }
 
 NNNAddress &
@@ -558,12 +652,6 @@ NNNAddress::operator > (const NNNAddress &name) const
   return (compareLabels (name) > 0);
 }
 
-inline name::Component &
-NNNAddress::operator [] (int index)
-{
-  return get (index);
-}
-
 inline const name::Component &
 NNNAddress::operator [] (int index) const
 {
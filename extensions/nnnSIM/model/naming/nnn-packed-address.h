@@ -0,0 +1,344 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2014 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-packed-address.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-packed-address.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-packed-address.h.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NNN_PACKED_ADDRESS_H
+#define NNN_PACKED_ADDRESS_H
+
+#include <stdint.h>
+
+#include "../nnn-common.h"
+
+NNN_NAMESPACE_BEGIN
+
+/**
+ * @brief Fixed width representation of a 3N name
+ *
+ * A 3N name has at most 16 hexadecimal digits, so the whole name fits
+ * in a single 64 bit word.  The nibbles of every label are stored in
+ * canonical form (no leading zeros) starting from the most significant
+ * nibble, and the m_bounds bitmask marks the nibble on which each label
+ * ends (bit i set means a label finishes on nibble i).
+ *
+ * Names which do not fit (more than 16 digits in total) are flagged as
+ * not valid and all operations must then be done on the components.
+ */
+class PackedNNNAddress
+{
+public:
+  /**
+   * @brief Create an empty packed name
+   */
+  PackedNNNAddress ()
+  : m_nibbles (0)
+  , m_bounds (0)
+  , m_len (0)
+  , m_labels (0)
+  , m_valid (true)
+  {
+  }
+
+  /**
+   * @brief Append a label to the end of the name
+   *
+   * @param label numerical value of the label
+   * @returns false if the label does not fit, in which case the packed
+   *          name is no longer valid
+   */
+  inline bool
+  append (uint64_t label);
+
+  /**
+   * @brief Invalidate the packed name
+   */
+  void
+  invalidate ()
+  {
+    m_valid = false;
+  }
+
+  /**
+   * @brief Find out if the name fits in the packed representation
+   */
+  bool
+  isValid () const
+  {
+    return m_valid;
+  }
+
+  /**
+   * @brief Get the number of labels
+   */
+  uint8_t
+  size () const
+  {
+    return m_labels;
+  }
+
+  /**
+   * @brief Get the number of hexadecimal digits used by all labels
+   */
+  uint8_t
+  nibbles () const
+  {
+    return m_len;
+  }
+
+  /**
+   * @brief Get the hexadecimal digits, most significant nibble first
+   */
+  uint64_t
+  word () const
+  {
+    return m_nibbles;
+  }
+
+  /**
+   * @brief Get the label bitmap, bit i set if a label ends on nibble i
+   */
+  uint16_t
+  bounds () const
+  {
+    return m_bounds;
+  }
+
+  bool
+  isEmpty () const
+  {
+    return (m_labels == 0);
+  }
+
+  /**
+   * @brief Get the numerical value of the label at position index
+   */
+  inline uint64_t
+  getLabel (uint8_t index) const;
+
+  /**
+   * @brief Get the numerical value of the last label
+   */
+  inline uint64_t
+  getLastLabel () const;
+
+  /**
+   * @brief Obtain the packed name minus the ending label
+   */
+  inline PackedNNNAddress
+  getSectorName () const;
+
+  /**
+   * @brief Number of leading labels both names have in common
+   */
+  inline uint8_t
+  commonLabels (const PackedNNNAddress &other) const;
+
+  /**
+   * @brief Find out if this name is a (not necessarily strict) prefix of other
+   */
+  inline bool
+  isPrefixOf (const PackedNNNAddress &other) const;
+
+  /**
+   * @brief Compare two names, using the ordering of NNNAddress::compare
+   */
+  inline int
+  compare (const PackedNNNAddress &other) const;
+
+  /**
+   * @brief Compare two names, using the ordering of NNNAddress::compareLabels
+   */
+  inline int
+  compareLabels (const PackedNNNAddress &other) const;
+
+  bool
+  operator == (const PackedNNNAddress &other) const
+  {
+    return (m_nibbles == other.m_nibbles && m_bounds == other.m_bounds && m_len == other.m_len);
+  }
+
+  bool
+  operator != (const PackedNNNAddress &other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  /**
+   * @brief Position of the first nibble of the last label
+   */
+  inline uint8_t
+  lastLabelStart () const;
+
+  /**
+   * @brief Numerical value of the nibbles in [start, end)
+   */
+  uint64_t
+  extract (uint8_t start, uint8_t end) const
+  {
+    return (m_nibbles << (4 * start)) >> (64 - 4 * (end - start));
+  }
+
+  uint64_t m_nibbles;  ///< @brief Hexadecimal digits, most significant nibble first
+  uint16_t m_bounds;   ///< @brief Bit i set if a label ends on nibble i
+  uint8_t m_len;       ///< @brief Number of nibbles in use
+  uint8_t m_labels;    ///< @brief Number of labels
+  bool m_valid;        ///< @brief False if the name did not fit
+};
+
+inline bool
+PackedNNNAddress::append (uint64_t label)
+{
+  if (!m_valid)
+    return false;
+
+  uint8_t n = (label == 0) ? 1 : (64 - __builtin_clzll (label) + 3) / 4;
+
+  if (m_len + n > 16)
+    {
+      m_valid = false;
+      return false;
+    }
+
+  m_len += n;
+  m_nibbles |= label << (64 - 4 * m_len);
+  m_bounds |= static_cast<uint16_t> (1u << (m_len - 1));
+  m_labels++;
+  return true;
+}
+
+inline uint8_t
+PackedNNNAddress::lastLabelStart () const
+{
+  // Remove the bound of the last label, the highest remaining bound is
+  // where the previous label finished
+  uint32_t prev = m_bounds & ~(1u << (m_len - 1));
+  return (prev == 0) ? 0 : (32 - __builtin_clz (prev));
+}
+
+inline uint64_t
+PackedNNNAddress::getLabel (uint8_t index) const
+{
+  uint32_t bounds = m_bounds;
+  uint8_t start = 0;
+
+  // Drop the bounds of the labels before index
+  for (uint8_t i = 0; i < index; i++)
+    {
+      start = __builtin_ctz (bounds) + 1;
+      bounds &= bounds - 1;
+    }
+
+  return extract (start, __builtin_ctz (bounds) + 1);
+}
+
+inline uint64_t
+PackedNNNAddress::getLastLabel () const
+{
+  if (isEmpty ())
+    return 0;
+
+  return extract (lastLabelStart (), m_len);
+}
+
+inline PackedNNNAddress
+PackedNNNAddress::getSectorName () const
+{
+  PackedNNNAddress sector;
+
+  if (isEmpty ())
+    return sector;
+
+  uint8_t start = lastLabelStart ();
+
+  sector.m_nibbles = (start == 0) ? 0 : m_nibbles & (~0ULL << (64 - 4 * start));
+  sector.m_bounds = m_bounds & ~(1u << (m_len - 1));
+  sector.m_len = start;
+  sector.m_labels = m_labels - 1;
+  return sector;
+}
+
+inline uint8_t
+PackedNNNAddress::commonLabels (const PackedNNNAddress &other) const
+{
+  // First nibble which differs
+  uint64_t nibdiff = m_nibbles ^ other.m_nibbles;
+  uint8_t pos = (nibdiff == 0) ? 16 : __builtin_clzll (nibdiff) / 4;
+
+  // First label boundary which differs
+  uint32_t bounddiff = m_bounds ^ other.m_bounds;
+  if (bounddiff != 0 && __builtin_ctz (bounddiff) < pos)
+    pos = __builtin_ctz (bounddiff);
+
+  if (m_len < pos)
+    pos = m_len;
+  if (other.m_len < pos)
+    pos = other.m_len;
+
+  // Every label finishing before the first difference is common
+  return __builtin_popcount (m_bounds & ((1u << pos) - 1));
+}
+
+inline bool
+PackedNNNAddress::isPrefixOf (const PackedNNNAddress &other) const
+{
+  return (m_labels <= other.m_labels && commonLabels (other) == m_labels);
+}
+
+inline int
+PackedNNNAddress::compare (const PackedNNNAddress &other) const
+{
+  uint8_t common = commonLabels (other);
+
+  if (common == m_labels && common == other.m_labels)
+    return 0;
+  if (common == m_labels)
+    return -1;
+  if (common == other.m_labels)
+    return +1;
+
+  return (getLabel (common) > other.getLabel (common)) ? +1 : -1;
+}
+
+inline int
+PackedNNNAddress::compareLabels (const PackedNNNAddress &other) const
+{
+  if (isEmpty () && other.isEmpty ())
+    return 0;
+  else if (isEmpty ())
+    return -1;
+  else if (other.isEmpty ())
+    return 1;
+
+  uint8_t common = commonLabels (other);
+
+  if (common == m_labels && common == other.m_labels)
+    return 0;
+
+  // Shorter names come after longer names with the same prefix
+  if (common == m_labels)
+    return +1;
+  if (common == other.m_labels)
+    return -1;
+
+  return (getLabel (common) > other.getLabel (common)) ? +1 : -1;
+}
+
+NNN_NAMESPACE_END
+
+#endif /* NNN_PACKED_ADDRESS_H */
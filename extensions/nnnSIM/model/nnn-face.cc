@@ -436,32 +436,34 @@ namespace ns3
 	  return false;
 	}
 
-      Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
       try
       {
-	  NNN_PDU_TYPE type = HeaderHelper::GetNNNHeaderType (packet);
-	  switch (type)
+	  // Classify and decode in a single pass, in whichever format p is
+	  // in. p is kept as the wire format of the PDU, upper layers get a
+	  // rw copy of the payload
+	  WirePDU pdu = Wire::ToPDU (p);
+	  switch (pdu.GetType ())
 	  {
 	    case nnn::NULL_NNN:
-	      return ReceiveNULLp (Wire::ToNULLp (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveNULLp (pdu.Get<NULLp> ());
 	    case nnn::SO_NNN:
-	      return ReceiveSO (Wire::ToSO (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveSO (pdu.Get<SO> ());
 	    case nnn::DO_NNN:
-	      return ReceiveDO (Wire::ToDO (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveDO (pdu.Get<DO> ());
 	    case nnn::EN_NNN:
-	      return ReceiveEN (Wire::ToEN (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveEN (pdu.Get<EN> ());
 	    case nnn::AEN_NNN:
-	      return ReceiveAEN (Wire::ToAEN (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveAEN (pdu.Get<AEN> ());
 	    case nnn::REN_NNN:
-	      return ReceiveREN (Wire::ToREN (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveREN (pdu.Get<REN> ());
 	    case nnn::OEN_NNN:
-	      return ReceiveOEN (Wire::ToOEN (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveOEN (pdu.Get<OEN> ());
 	    case nnn::DEN_NNN:
-	      return ReceiveDEN (Wire::ToDEN (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveDEN (pdu.Get<DEN> ());
 	    case nnn::INF_NNN:
-	      return ReceiveINF (Wire::ToINF (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveINF (pdu.Get<INF> ());
 	    case nnn::DU_NNN:
-	      return ReceiveDU (Wire::ToDU (packet, Wire::WIRE_FORMAT_NNNSIM));
+	      return ReceiveDU (pdu.Get<DU> ());
 	    default:
 	      NS_FATAL_ERROR ("Not supported NNN header");
 	      return false;
@@ -25,6 +25,7 @@
 #include "naming/error.h"
 #include "naming/name-component.h"
 #include "naming/nnn-address.h"
+#include "naming/nnn-packed-address.h"
 #include "naming/nnn-name-format.h"
 
 
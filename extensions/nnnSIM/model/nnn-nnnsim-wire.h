@@ -23,5 +23,7 @@
 #include "wire/nnn-wire.h"
 #include "wire/wire-nnnsim.h"
 #include "wire/nnnsim/nnnsim.h"
+#include "wire/wire-compact.h"
+#include "wire/compact/compact.h"
 
 #endif
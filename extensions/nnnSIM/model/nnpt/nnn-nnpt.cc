@@ -40,10 +40,15 @@ namespace ns3
       return tid;
     }
 
-    NNPT::NNPT() {
+    NNPT::NNPT()
+    : m_wheelClient (0)
+    , m_leaseTimer (LeaseWheel::INVALID_TIMER)
+    {
     }
 
     NNPT::~NNPT() {
+      if (m_wheel != 0)
+	m_wheel->Cancel (m_leaseTimer);
     }
 
     void
@@ -54,7 +59,7 @@ namespace ns3
       if (!foundOldName(oldName) && !foundOldName(newName))
         {
 	  // We assume that the lease time gives us the absolute expiry time
-	  // We need to calculate the relative time for the Schedule function
+	  // We need the relative time to check the lease is still valid
 	  Time now = Simulator::Now ();
 	  Time relativeExpireTime = lease_expire - now;
 
@@ -65,7 +70,7 @@ namespace ns3
             {
               NS_LOG_INFO ("addEntry : Adding entry for (" << *oldName << ") ->  (" << *newName  << ")");
               container.insert(nnpt::Entry(oldName, newName, lease_expire));
-              Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
+              ScheduleLease ();
             }
         }
       else
@@ -236,7 +241,7 @@ namespace ns3
 
 	      if (pair_index.replace(it, tmp))
 		{
-		  Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
+		  ScheduleLease ();
 		}
 	    }
 	}
@@ -279,20 +284,84 @@ namespace ns3
       pair_set_by_lease& lease_index = container.get<st_lease> ();
       Time now = Simulator::Now ();
 
-      pair_set_by_lease::iterator it = lease_index.begin();
+      // The index is ordered by lease, so expired pairs are all at the front
+      while (!lease_index.empty () && lease_index.begin ()->m_lease_expire <= now)
+	{
+	  pair_set_by_lease::iterator it = lease_index.begin ();
+	  NS_LOG_INFO ("cleanExpired : removing (" << *it->m_oldName << ") -> (" << *it->m_newName << ")");
+	  lease_index.erase (it);
+	}
+    }
+
+    void
+    NNPT::SetLeaseWheel (Ptr<LeaseWheel> wheel)
+    {
+      NS_LOG_FUNCTION (this << wheel);
+
+      if (m_wheel == wheel)
+	return;
+
+      if (m_wheel != 0)
+	m_wheel->Cancel (m_leaseTimer);
+      m_leaseTimer = LeaseWheel::INVALID_TIMER;
 
-      while (! isEmpty())
+      m_wheel = wheel;
+      if (m_wheel != 0)
 	{
-	  if (it->m_lease_expire <= now)
-	    {
-	      NS_LOG_INFO ("cleanExpired : removing (" << *it->m_oldName << ") -> (" << *it->m_newName << ")");
-	      deleteEntry(*it);
-	      break;
-	    }
-	  ++it;
+	  m_wheelClient = m_wheel->RegisterClient (MakeCallback (&NNPT::LeasesExpired, this));
+	  ScheduleLease ();
 	}
     }
 
+    Ptr<LeaseWheel>
+    NNPT::GetLeaseWheel ()
+    {
+      if (m_wheel == 0)
+	{
+	  Ptr<LeaseWheel> wheel = GetObject<LeaseWheel> ();
+	  SetLeaseWheel ((wheel != 0) ? wheel : CreateObject<LeaseWheel> ());
+	}
+
+      return m_wheel;
+    }
+
+    void
+    NNPT::ScheduleLease ()
+    {
+      if (container.empty ())
+	return;
+
+      Ptr<LeaseWheel> wheel = GetLeaseWheel ();
+      Time expire = container.get<st_lease> ().begin ()->m_lease_expire;
+
+      if (wheel->IsPending (m_leaseTimer))
+	wheel->Reschedule (m_leaseTimer, expire);
+      else
+	m_leaseTimer = wheel->Schedule (m_wheelClient, expire, 0);
+    }
+
+    void
+    NNPT::LeasesExpired (const std::vector<uint64_t> &cookies)
+    {
+      NS_LOG_FUNCTION (this);
+      m_leaseTimer = LeaseWheel::INVALID_TIMER;
+
+      cleanExpired ();
+      ScheduleLease ();
+    }
+
+    void
+    NNPT::DoDispose ()
+    {
+      if (m_wheel != 0)
+	m_wheel->Cancel (m_leaseTimer);
+      m_leaseTimer = LeaseWheel::INVALID_TIMER;
+      m_wheel = 0;
+
+      container.clear ();
+      Object::DoDispose ();
+    }
+
     void
     NNPT::Print (std::ostream &os) const
     {
@@ -33,6 +33,7 @@
 
 #include "nnn-nnpt-entry.h"
 #include "../nnn-naming.h"
+#include "../../utils/nnn-lease-wheel.h"
 
 #include <ns3-dev/ns3/object.h>
 #include <ns3-dev/ns3/ptr.h>
@@ -156,7 +157,38 @@ namespace ns3
       void
       printByLease ();
 
+      /**
+       * @brief Set the wheel used to expire the leases of the pairs
+       *
+       * If never called, the LeaseWheel aggregated to the node is used,
+       * or a private one created when there is none.
+       */
+      void
+      SetLeaseWheel (Ptr<LeaseWheel> wheel);
+
       pair_set container;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      Ptr<LeaseWheel>
+      GetLeaseWheel ();
+
+      /**
+       * @brief Schedule or move the single NNPT timer to the earliest lease
+       */
+      void
+      ScheduleLease ();
+
+      void
+      LeasesExpired (const std::vector<uint64_t> &cookies);
+
+    private:
+      Ptr<LeaseWheel> m_wheel;
+      uint32_t m_wheelClient;
+      LeaseWheel::TimerId m_leaseTimer;
     };
 
     std::ostream& operator<< (std::ostream& os, const NNPT &nnpt);
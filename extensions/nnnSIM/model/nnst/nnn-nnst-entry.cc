@@ -45,12 +45,14 @@ namespace ns3
     namespace nnst
     {
       Entry::Entry()
+      : m_leaseTimer  (LeaseWheel::INVALID_TIMER)
       {
       }
 
       Entry::Entry(Ptr<NNST> nnst, const Ptr<const NNNAddress> &name)
       : m_nnst        (nnst)
       , m_address     (name)
+      , m_leaseTimer  (LeaseWheel::INVALID_TIMER)
       , item_         (0)
       {
       }
@@ -315,17 +317,20 @@ namespace ns3
 	fmtr_set_by_lease& lease_index = m_faces.get<i_lease> ();
 	Time now = Simulator::Now ();
 
-	fmtr_set_by_lease::iterator it = lease_index.begin ();
-	for (; it != lease_index.end ();)
-	  {
-	    if (it->GetExpireTime() <= now)
-	      it = lease_index.erase (it);
-	    else
-	      ++it;
+	// The index is ordered by lease, so expired faces are all at the front
+	while (!lease_index.empty () && lease_index.begin ()->GetExpireTime () <= now)
+	  lease_index.erase (lease_index.begin ());
+      }
 
-	    if (it->GetExpireTime () > now)
-	      break;
-	  }
+      Time
+      Entry::GetEarliestLease () const
+      {
+	const fmtr_set_by_lease& lease_index = m_faces.get<i_lease> ();
+
+	if (lease_index.empty ())
+	  return Time (0);
+
+	return lease_index.begin ()->GetExpireTime ();
       }
 
       void
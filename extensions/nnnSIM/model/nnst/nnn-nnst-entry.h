@@ -217,6 +217,12 @@ namespace ns3
 	void
 	cleanExpired();
 
+	/**
+	 * \brief Earliest lease expiry time of all the faces in the entry
+	 */
+	Time
+	GetEarliestLease () const;
+
 	void
 	printByAddress () const;
 
@@ -236,6 +242,7 @@ namespace ns3
 	Ptr<NNST> m_nnst;             ///< \brief NNST to which entry is added
 	Ptr<const NNNAddress> m_address;    ///< \brief Address used for the NNST Entry
 	fmtr_set m_faces;
+	LeaseWheel::TimerId m_leaseTimer;   ///< \brief Timer of the earliest lease, kept by the NNST
 
       private:
 	trie::iterator item_;
@@ -46,10 +46,13 @@ namespace ns3
       return tid;
     }
 
-    NNST::NNST() {
+    NNST::NNST()
+    : m_wheelClient (0)
+    {
     }
 
     NNST::~NNST() {
+      CancelLeases ();
     }
 
     Ptr<nnst::Entry>
@@ -60,18 +63,11 @@ namespace ns3
 
       if (item == super::end ())
 	{
-	  // We don't have a longest prefix with with the given address, attempt to order by distance
-	  Ptr<nnst::Entry> curr;
-	  Ptr<nnst::Entry> closest = Begin ();
-	  for (curr = Begin(); curr != End (); curr = Next(curr))
-	    {
-	      if (curr->GetAddressPtr ()->distance(prefix) < closest->GetAddressPtr ()->distance (prefix))
-		{
-                  NS_LOG_INFO ("Found (" << *curr->GetAddressPtr () << ") to be closer to (" << prefix << ")");
-		  closest = curr;
-		}
-	    }
-          NS_LOG_INFO ("Returning closest prefix (" << *closest->GetAddressPtr () << ")");
+	  // We don't have a longest prefix with with the given address, walk
+	  // the trie outwards from the deepest node matching the address
+	  Ptr<nnst::Entry> closest = ClosestByDistance (prefix);
+	  if (closest != 0)
+	    NS_LOG_INFO ("Returning closest prefix (" << *closest->GetAddressPtr () << ")");
 	  return closest;
 	}
       else
@@ -82,6 +78,88 @@ namespace ns3
 	}
     }
 
+    Ptr<nnst::Entry>
+    NNST::ClosestByDistance (const NNNAddress &prefix)
+    {
+      super::iterator foundItem, lastItem;
+      bool reachLast;
+      boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (prefix);
+
+      // Depth of the deepest node matching the address
+      uint32_t depth = 0;
+      for (super::iterator i = lastItem; i->parent () != 0; i = i->parent ())
+	depth++;
+
+      // The distance from prefix to an entry of size m sharing j labels is
+      // prefix.size () + m - 2j (one less if j is 0). Entries under the
+      // node at depth j, but not under the node at depth j+1 on the path,
+      // share exactly j labels, so the best candidate of each level is the
+      // shallowest entry in that region.
+      int n = prefix.size ();
+      int bestDistance = -1;
+      super::iterator best = 0;
+      super::iterator skip = 0;
+
+      for (super::iterator node = lastItem; node != 0; skip = node, node = node->parent (), depth--)
+	{
+	  int j = depth;
+
+	  // No entry found from this level upwards can do better than this
+	  int bound = (j == 0) ? n : n - j + 1;
+	  if (bestDistance >= 0 && bestDistance <= bound)
+	    break;
+
+	  super::iterator candidate = 0;
+	  uint32_t candidateDepth = 0;
+	  ShallowestEntry (node, skip, depth, candidate, candidateDepth);
+
+	  if (candidate == 0)
+	    continue;
+
+	  int dist = n + static_cast<int> (candidateDepth) - 2 * j;
+	  if (j == 0 && dist > 0)
+	    dist--;
+
+	  if (bestDistance < 0 || dist < bestDistance)
+	    {
+	      NS_LOG_INFO ("Found (" << *candidate->payload ()->GetAddressPtr () << ") to be closer to (" << prefix << ")");
+	      bestDistance = dist;
+	      best = candidate;
+	    }
+	}
+
+      if (best == 0)
+	return 0;
+      else
+	return best->payload ();
+    }
+
+    void
+    NNST::ShallowestEntry (super::iterator node, super::iterator skip, uint32_t depth,
+                           super::iterator &best, uint32_t &bestDepth)
+    {
+      // Nothing below this depth can improve on what we have
+      if (best != 0 && depth >= bestDepth)
+	return;
+
+      if (node->payload () != 0)
+	{
+	  best = node;
+	  bestDepth = depth;
+	  return;
+	}
+
+      super::parent_trie::point_iterator child (*node);
+      super::parent_trie::point_iterator end (0);
+      for (; child != end; child++)
+	{
+	  if (&(*child) == skip)
+	    continue;
+
+	  ShallowestEntry (&(*child), 0, depth + 1, best, bestDepth);
+	}
+    }
+
     Ptr<const NNNAddress>
     NNST::ClosestSectorNameInfo (const NNNAddress &prefix)
     {
@@ -120,21 +198,166 @@ namespace ns3
         return ClosestSectorFaceInfo(*prefix, skip);
     }
 
-    std::vector<Ptr<const NNNAddress> >
-    NNST::OneHopNameInfo (const NNNAddress &prefix)
+    namespace
     {
-      NS_LOG_FUNCTION (this << prefix);
-      Ptr<nnst::Entry> curr;
-      std::vector<Ptr<const NNNAddress> > ret;
+      // Visitors used with NNST::WalkOneHop. Each returns false once it
+      // does not want to see more entries.
+      struct NameCollector
+      {
+	NameCollector (std::vector<Ptr<const NNNAddress> > &ret)
+	: m_ret (ret)
+	{
+	}
+
+	bool
+	operator() (Ptr<nnst::Entry> entry)
+	{
+	  m_ret.push_back (entry->GetAddressPtr ());
+	  return true;
+	}
+
+	std::vector<Ptr<const NNNAddress> > &m_ret;
+      };
+
+      struct FaceCollector
+      {
+	FaceCollector (std::vector<std::pair<Ptr<Face>, Address> > &ret, uint32_t skip)
+	: m_ret (ret)
+	, m_skip (skip)
+	{
+	}
+
+	bool
+	operator() (Ptr<nnst::Entry> entry)
+	{
+	  m_ret.push_back (entry->FindBestCandidateFaceInfo (m_skip));
+	  return true;
+	}
+
+	std::vector<std::pair<Ptr<Face>, Address> > &m_ret;
+	uint32_t m_skip;
+      };
+
+      struct FaceBufferFiller
+      {
+	FaceBufferFiller (std::pair<Ptr<Face>, Address> *buf, uint32_t len, uint32_t skip)
+	: m_buf (buf)
+	, m_len (len)
+	, m_skip (skip)
+	, m_count (0)
+	{
+	}
+
+	bool
+	operator() (Ptr<nnst::Entry> entry)
+	{
+	  m_buf[m_count++] = entry->FindBestCandidateFaceInfo (m_skip);
+	  return (m_count < m_len);
+	}
+
+	std::pair<Ptr<Face>, Address> *m_buf;
+	uint32_t m_len;
+	uint32_t m_skip;
+	uint32_t m_count;
+      };
+
+      struct CallbackVisitor
+      {
+	CallbackVisitor (NNST::OneHopVisitor visitor)
+	: m_visitor (visitor)
+	{
+	}
+
+	bool
+	operator() (Ptr<nnst::Entry> entry)
+	{
+	  return m_visitor (entry);
+	}
+
+	NNST::OneHopVisitor m_visitor;
+      };
+    }
+
+    template<class Visitor>
+    void
+    NNST::WalkOneHop (const NNNAddress &prefix, uint8_t relations, Visitor &visit)
+    {
+      // Entries one hop away are, structurally, the parent node of the
+      // address, its direct children and, for top level addresses, the
+      // other top level nodes
+      size_t n = prefix.size ();
+      if (n == 0)
+	return;
+
+      super::iterator foundItem, lastItem;
+      bool reachLast;
+      boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (prefix);
+
+      size_t depth = 0;
+      if (reachLast)
+	depth = n;
+      else
+	{
+	  for (super::iterator i = lastItem; i->parent () != 0; i = i->parent ())
+	    depth++;
+	}
+
+      if ((relations & ONEHOP_PARENT) && n >= 2 && depth >= n - 1)
+	{
+	  super::iterator parent = reachLast ? lastItem->parent () : lastItem;
+	  if (parent->payload () != 0)
+	    {
+	      if (!visit (parent->payload ()))
+		return;
+	    }
+	}
+
+      if ((relations & ONEHOP_SUBSECTOR) && reachLast)
+	{
+	  super::parent_trie::point_iterator child (*lastItem);
+	  super::parent_trie::point_iterator end (0);
+	  for (; child != end; child++)
+	    {
+	      if (child->payload () == 0)
+		continue;
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
+	      if (!visit (child->payload ()))
+		return;
+	    }
+	}
+
+      if ((relations & ONEHOP_TOPLEVEL) && n == 1)
 	{
-	  if (curr->GetAddress().distance(prefix) == 1)
+	  super::parent_trie::point_iterator sibling (super::getTrie ());
+	  super::parent_trie::point_iterator end (0);
+	  for (; sibling != end; sibling++)
 	    {
-	      ret.push_back(curr->GetAddressPtr());
+	      if ((reachLast && &(*sibling) == lastItem) || sibling->payload () == 0)
+		continue;
+
+	      if (!visit (sibling->payload ()))
+		return;
 	    }
 	}
+    }
+
+    void
+    NNST::VisitOneHop (const NNNAddress &prefix, uint8_t relations, OneHopVisitor visitor)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      CallbackVisitor visit (visitor);
+
+      WalkOneHop (prefix, relations, visit);
+    }
 
+    std::vector<Ptr<const NNNAddress> >
+    NNST::OneHopNameInfo (const NNNAddress &prefix)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      std::vector<Ptr<const NNNAddress> > ret;
+      NameCollector collect (ret);
+
+      WalkOneHop (prefix, ONEHOP_ALL, collect);
       return ret;
     }
 
@@ -149,18 +372,10 @@ namespace ns3
     NNST::OneHopFaceInfo (const NNNAddress &prefix, uint32_t skip)
     {
       NS_LOG_FUNCTION (this << prefix);
-
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      FaceCollector collect (ret, skip);
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
-	{
-	  if (curr->GetAddress().distance(prefix) == 1)
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
-	}
-
+      WalkOneHop (prefix, ONEHOP_ALL, collect);
       return ret;
     }
 
@@ -171,22 +386,26 @@ namespace ns3
       return OneHopFaceInfo(*prefix, skip);
     }
 
+    uint32_t
+    NNST::OneHopFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                      std::pair<Ptr<Face>, Address> *buf, uint32_t len)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      FaceBufferFiller fill (buf, len, skip);
+
+      if (len > 0)
+	WalkOneHop (prefix, ONEHOP_ALL, fill);
+      return fill.m_count;
+    }
+
     std::vector<Ptr<const NNNAddress> >
     NNST::OneHopSubSectorNameInfo (const NNNAddress &prefix)
     {
       NS_LOG_FUNCTION (this << prefix);
-
-      Ptr<nnst::Entry> curr;
       std::vector<Ptr<const NNNAddress> > ret;
+      NameCollector collect (ret);
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
-	{
-	  if (curr->GetAddress().distance(prefix) == 1 && prefix.isParentSector(curr->GetAddress()))
-	    {
-	      ret.push_back(curr->GetAddressPtr());
-	    }
-	}
-
+      WalkOneHop (prefix, ONEHOP_SUBSECTOR, collect);
       return ret;
     }
 
@@ -201,18 +420,10 @@ namespace ns3
     NNST::OneHopSubSectorFaceInfo (const NNNAddress &prefix, uint32_t skip)
     {
       NS_LOG_FUNCTION (this << prefix);
-
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      FaceCollector collect (ret, skip);
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
-	{
-	  if (curr->GetAddress().distance(prefix) == 1 && prefix.isParentSector(curr->GetAddress()))
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
-	}
-
+      WalkOneHop (prefix, ONEHOP_SUBSECTOR, collect);
       return ret;
     }
 
@@ -223,22 +434,26 @@ namespace ns3
       return OneHopSubSectorFaceInfo(*prefix, skip);
     }
 
+    uint32_t
+    NNST::OneHopSubSectorFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                      std::pair<Ptr<Face>, Address> *buf, uint32_t len)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      FaceBufferFiller fill (buf, len, skip);
+
+      if (len > 0)
+	WalkOneHop (prefix, ONEHOP_SUBSECTOR, fill);
+      return fill.m_count;
+    }
+
     std::vector<Ptr<const NNNAddress> >
     NNST::OneHopParentSectorNameInfo (const NNNAddress &prefix)
     {
       NS_LOG_FUNCTION (this << prefix);
-
-      Ptr<nnst::Entry> curr;
       std::vector<Ptr<const NNNAddress> > ret;
+      NameCollector collect (ret);
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
-	{
-	  if (curr->GetAddress().distance(prefix) == 1 && curr->GetAddress().isParentSector(prefix))
-	    {
-	      ret.push_back(curr->GetAddressPtr ());
-	    }
-	}
-
+      WalkOneHop (prefix, ONEHOP_PARENT, collect);
       return ret;
     }
 
@@ -253,18 +468,10 @@ namespace ns3
     NNST::OneHopParentSectorFaceInfo (const NNNAddress &prefix, uint32_t skip)
     {
       NS_LOG_FUNCTION (this << prefix);
-
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      FaceCollector collect (ret, skip);
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
-	{
-	  if (curr->GetAddress().distance(prefix) == 1 && curr->GetAddress().isParentSector(prefix))
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
-	}
-
+      WalkOneHop (prefix, ONEHOP_PARENT, collect);
       return ret;
     }
 
@@ -275,6 +482,18 @@ namespace ns3
       return OneHopParentSectorFaceInfo(*prefix, skip);
     }
 
+    uint32_t
+    NNST::OneHopParentSectorFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                      std::pair<Ptr<Face>, Address> *buf, uint32_t len)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      FaceBufferFiller fill (buf, len, skip);
+
+      if (len > 0)
+	WalkOneHop (prefix, ONEHOP_PARENT, fill);
+      return fill.m_count;
+    }
+
     Ptr<nnst::Entry>
     NNST::Find (const NNNAddress &prefix)
     {
@@ -292,7 +511,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION ("const NNNAddress Add" << name << lease_expire);
       // We assume that the lease time gives us the absolute expiry time
-      // We need to calculate the relative time for the Schedule function
+      // We need the relative time to check the lease is still valid
       Time now = Simulator::Now ();
       Time relativeExpireTime = lease_expire - now;
 
@@ -304,7 +523,7 @@ namespace ns3
 	  char c;
 	  Ptr<nnst::Entry> tmp = Add (Create<NNNAddress> (name), face, poa, lease_expire, metric, c);
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  ScheduleLease (tmp);
 	  return tmp;
 	}
       else
@@ -330,7 +549,7 @@ namespace ns3
 	      tmp = Add(prefix, *i, poa, lease_expire, metric, c);
 	    }
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  ScheduleLease (tmp);
 	  return tmp;
 	}
       else
@@ -356,7 +575,7 @@ namespace ns3
 	      tmp = Add(prefix, face, *i, lease_expire, metric, c);
 	    }
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  ScheduleLease (tmp);
 	  return tmp;
 	}
       else
@@ -378,7 +597,7 @@ namespace ns3
 	  char c;
 	  Ptr<nnst::Entry> tmp = Add(name, face, poa, lease_expire, metric, c);
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  ScheduleLease (tmp);
 	  return tmp;
 	}
       else
@@ -417,7 +636,7 @@ namespace ns3
 	      if (ok)
 		{
 		  Ptr<nnst::Entry> tmp = item->payload ();
-		  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+		  ScheduleLease (tmp);
 		}
 	    }
 	}
@@ -472,7 +691,7 @@ namespace ns3
 	  //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	  //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (nnstEntry->payload ());
 
-	  super::erase (nnstEntry);
+	  EraseEntry (nnstEntry);
 	}
     }
 
@@ -493,7 +712,7 @@ namespace ns3
 	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
 
-	      super::erase (StaticCast<nnst::Entry> (entry)->to_iterator ());
+	      EraseEntry (StaticCast<nnst::Entry> (entry)->to_iterator ());
 	      entry = nextEntry;
 	    }
 	  else
@@ -520,7 +739,7 @@ namespace ns3
 	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
 
-	      super::erase (entry->to_iterator ());
+	      EraseEntry (entry->to_iterator ());
 	      entry = nextEntry;
 	    }
 	  else
@@ -725,6 +944,8 @@ namespace ns3
     void
     NNST::DoDispose (void)
     {
+      CancelLeases ();
+      m_wheel = 0;
       clear ();
       Object::DoDispose ();
     }
@@ -799,6 +1020,110 @@ namespace ns3
 
       if (item->isEmpty ())
 	Remove (name);
+      else
+	ScheduleLease (item);
+    }
+
+    void
+    NNST::SetLeaseWheel (Ptr<LeaseWheel> wheel)
+    {
+      NS_LOG_FUNCTION (this << wheel);
+
+      if (m_wheel == wheel)
+	return;
+
+      CancelLeases ();
+
+      m_wheel = wheel;
+      if (m_wheel == 0)
+	return;
+
+      m_wheelClient = m_wheel->RegisterClient (MakeCallback (&NNST::LeasesExpired, this));
+
+      // Move the leases of the entries already present to the new wheel
+      super::parent_trie::recursive_iterator item (super::getTrie ());
+      super::parent_trie::recursive_iterator end (0);
+      for (; item != end; item++)
+	{
+	  if (item->payload () == 0) continue;
+
+	  ScheduleLease (item->payload ());
+	}
+    }
+
+    Ptr<LeaseWheel>
+    NNST::GetLeaseWheel ()
+    {
+      if (m_wheel == 0)
+	{
+	  Ptr<LeaseWheel> wheel = GetObject<LeaseWheel> ();
+	  SetLeaseWheel ((wheel != 0) ? wheel : CreateObject<LeaseWheel> ());
+	}
+
+      return m_wheel;
+    }
+
+    void
+    NNST::ScheduleLease (Ptr<nnst::Entry> item)
+    {
+      if (item == 0 || item->m_faces.empty ())
+	return;
+
+      Ptr<LeaseWheel> wheel = GetLeaseWheel ();
+      Time expire = item->GetEarliestLease ();
+
+      if (wheel->IsPending (item->m_leaseTimer))
+	wheel->Reschedule (item->m_leaseTimer, expire);
+      else
+	item->m_leaseTimer = wheel->Schedule (m_wheelClient, expire,
+	                                      reinterpret_cast<uint64_t> (PeekPointer (item)));
+    }
+
+    void
+    NNST::LeasesExpired (const std::vector<uint64_t> &cookies)
+    {
+      NS_LOG_FUNCTION (this << cookies.size ());
+
+      // Entries cancel their timer when leaving the trie, so every cookie
+      // still points to an entry held by it
+      for (std::vector<uint64_t>::const_iterator i = cookies.begin (); i != cookies.end (); ++i)
+	{
+	  Ptr<nnst::Entry> item (reinterpret_cast<nnst::Entry *> (*i));
+	  item->m_leaseTimer = LeaseWheel::INVALID_TIMER;
+
+	  cleanExpired (item);
+	}
+    }
+
+    void
+    NNST::EraseEntry (super::iterator item)
+    {
+      Ptr<nnst::Entry> entry = item->payload ();
+
+      if (entry != 0 && m_wheel != 0)
+	{
+	  m_wheel->Cancel (entry->m_leaseTimer);
+	  entry->m_leaseTimer = LeaseWheel::INVALID_TIMER;
+	}
+
+      super::erase (item);
+    }
+
+    void
+    NNST::CancelLeases ()
+    {
+      if (m_wheel == 0)
+	return;
+
+      super::parent_trie::recursive_iterator item (super::getTrie ());
+      super::parent_trie::recursive_iterator end (0);
+      for (; item != end; item++)
+	{
+	  if (item->payload () == 0) continue;
+
+	  m_wheel->Cancel (item->payload ()->m_leaseTimer);
+	  item->payload ()->m_leaseTimer = LeaseWheel::INVALID_TIMER;
+	}
     }
 
     std::ostream&
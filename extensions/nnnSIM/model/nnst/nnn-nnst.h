@@ -46,6 +46,7 @@ using namespace ::boost::multi_index;
 #include "../../utils/trie/trie.h"
 #include "../../utils/trie/counting-policy.h"
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/nnn-lease-wheel.h"
 
 namespace ns3
 {
@@ -74,6 +75,22 @@ namespace ns3
 	  nnnSIM::counting_policy_traits
 	  > super;
 
+      /**
+       * @brief Structural relations of the entries one hop away from an address
+       */
+      enum OneHopRelation
+      {
+	ONEHOP_PARENT = 1,     ///< @brief Parent sector of the address
+	ONEHOP_SUBSECTOR = 2,  ///< @brief Direct sub-sectors of the address
+	ONEHOP_TOPLEVEL = 4,   ///< @brief Other top level sectors, for top level addresses
+	ONEHOP_ALL = 7
+      };
+
+      /**
+       * @brief Visitor for VisitOneHop, returns false to stop the walk
+       */
+      typedef Callback<bool, Ptr<nnst::Entry> > OneHopVisitor;
+
       static TypeId GetTypeId ();
 
       NNST();
@@ -107,6 +124,13 @@ namespace ns3
       std::vector<std::pair<Ptr<Face>, Address> >
       OneHopFaceInfo (Ptr<const NNNAddress> prefix, uint32_t skip);
 
+      /**
+       * @brief Fill buf with at most len entries, returns the number of entries written
+       */
+      uint32_t
+      OneHopFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                  std::pair<Ptr<Face>, Address> *buf, uint32_t len);
+
       std::vector<Ptr<const NNNAddress> >
       OneHopSubSectorNameInfo (const NNNAddress &prefix);
 
@@ -119,6 +143,13 @@ namespace ns3
       std::vector<std::pair<Ptr<Face>, Address> >
       OneHopSubSectorFaceInfo (Ptr<const NNNAddress> prefix, uint32_t skip);
 
+      /**
+       * @brief Fill buf with at most len entries, returns the number of entries written
+       */
+      uint32_t
+      OneHopSubSectorFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                  std::pair<Ptr<Face>, Address> *buf, uint32_t len);
+
       std::vector<Ptr<const NNNAddress> >
       OneHopParentSectorNameInfo (const NNNAddress &prefix);
 
@@ -131,6 +162,20 @@ namespace ns3
       std::vector<std::pair<Ptr<Face>, Address> >
       OneHopParentSectorFaceInfo (Ptr<const NNNAddress> prefix, uint32_t skip);
 
+      /**
+       * @brief Fill buf with at most len entries, returns the number of entries written
+       */
+      uint32_t
+      OneHopParentSectorFaceInfo (const NNNAddress &prefix, uint32_t skip,
+                  std::pair<Ptr<Face>, Address> *buf, uint32_t len);
+
+      /**
+       * @brief Call visitor for every entry one hop away from prefix whose
+       * relation to prefix is in relations (a mask of OneHopRelation)
+       */
+      void
+      VisitOneHop (const NNNAddress &prefix, uint8_t relations, OneHopVisitor visitor);
+
       Ptr<nnst::Entry>
       Find (const NNNAddress &prefix);
 
@@ -223,6 +268,16 @@ namespace ns3
       std::vector<Address>
       GetAllPoas (const NNNAddress &prefix);
 
+      /**
+       * @brief Set the wheel used to expire the leases of the entries
+       *
+       * Must be called before any entry is added. If never called, the
+       * LeaseWheel aggregated to the node is used, or a private one
+       * created when there is none.
+       */
+      void
+      SetLeaseWheel (Ptr<LeaseWheel> wheel);
+
     protected:
       // inherited from Object class
       virtual void NotifyNewAggregate (); ///< @brief Notify when object is aggregated
@@ -244,6 +299,57 @@ namespace ns3
 
       void
       cleanExpired(Ptr<nnst::Entry> item);
+
+      Ptr<LeaseWheel>
+      GetLeaseWheel ();
+
+      /**
+       * @brief Schedule or move the timer of the entry to its earliest lease
+       */
+      void
+      ScheduleLease (Ptr<nnst::Entry> item);
+
+      /**
+       * @brief Called by the wheel with the entries whose earliest lease expired
+       */
+      void
+      LeasesExpired (const std::vector<uint64_t> &cookies);
+
+      /**
+       * @brief Erase a trie node, cancelling the lease timer of its entry
+       */
+      void
+      EraseEntry (super::iterator item);
+
+      void
+      CancelLeases ();
+
+      /**
+       * @brief Find the entry with the smallest distance to prefix, walking
+       * the trie outwards from the deepest node matching prefix
+       */
+      Ptr<nnst::Entry>
+      ClosestByDistance (const NNNAddress &prefix);
+
+      /**
+       * @brief Find the shallowest node with a payload under node, ignoring
+       * the child skip
+       */
+      void
+      ShallowestEntry (super::iterator node, super::iterator skip, uint32_t depth,
+                       super::iterator &best, uint32_t &bestDepth);
+
+      /**
+       * @brief Walk the trie nodes one hop away from prefix, calling visit
+       * on each entry found until it returns false
+       */
+      template<class Visitor>
+      void
+      WalkOneHop (const NNNAddress &prefix, uint8_t relations, Visitor &visit);
+
+    private:
+      Ptr<LeaseWheel> m_wheel;
+      uint32_t m_wheelClient;
     };
 
     std::ostream& operator<< (std::ostream& os, const NNST &nnst);
@@ -30,21 +30,18 @@ namespace ns3
   namespace nnn
   {
     AEN::AEN ()
-    : NNNPDU (AEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (AEN_NNN, Seconds (0))
     {
     }
 
     AEN::AEN (Ptr<NNNAddress> name)
-    : NNNPDU (AEN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (AEN_NNN, Seconds (0))
     , m_name     (name)
     {
     }
 
     AEN::AEN (const NNNAddress &name)
-    : NNNPDU (AEN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (AEN_NNN, Seconds (0))
     , m_name     (Create<NNNAddress> (name))
     {
     }
@@ -28,21 +28,18 @@ namespace ns3
   namespace nnn
   {
     DEN::DEN ()
-    : NNNPDU (DEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (DEN_NNN, Seconds (0))
     {
     }
 
     DEN::DEN (Ptr<NNNAddress> name)
-    : NNNPDU (DEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (DEN_NNN, Seconds (0))
     {
       SetName (name);
     }
 
     DEN::DEN (const NNNAddress &name)
-    : NNNPDU (DEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (DEN_NNN, Seconds (0))
     {
       SetName (name);
     }
@@ -29,29 +29,26 @@ namespace ns3
   namespace nnn
   {
     DO::DO ()
-    : NNNPDU (DO_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (DO_NNN, Seconds (0))
     , m_name (Create<NNNAddress> ())
     {
     }
 
     DO::DO (Ptr<NNNAddress> name, Ptr<Packet> payload)
-    : NNNPDU (DO_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (DO_NNN, Seconds (0))
     , m_name (name)
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
     }
 
     DO::DO (const NNNAddress &name, Ptr<Packet> payload)
-    : NNNPDU (DO_NNN, Seconds(0))
-    , DATAPDU ()
+    : DATAPDU (DO_NNN, Seconds (0))
     , m_name (Create<NNNAddress> (name))
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
@@ -65,7 +62,7 @@ namespace ns3
       SetLifetime (do_p.GetLifetime ());
       SetName (do_p.GetName());
       SetPDUPayloadType (do_p.GetPDUPayloadType ());
-      SetPayload (do_p.GetPayload()->Copy ());
+      SetPayload (do_p.GetPayload());
       SetWire (do_p.GetWire ());
     }
 
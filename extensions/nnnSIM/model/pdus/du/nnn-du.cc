@@ -27,32 +27,29 @@ namespace ns3
   namespace nnn
   {
     DU::DU ()
-    : NNNPDU (DU_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (DU_NNN, Seconds (0))
     , m_src (Create<NNNAddress> ())
     , m_dst (Create<NNNAddress> ())
     {
     }
 
     DU::DU (Ptr<NNNAddress> src, Ptr<NNNAddress> dst, Ptr<Packet> payload)
-    : NNNPDU (DU_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (DU_NNN, Seconds (0))
     , m_src (src)
     , m_dst (dst)
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
     }
 
     DU::DU (const NNNAddress &src, const NNNAddress &dst, Ptr<Packet> payload)
-    : NNNPDU (DU_NNN, Seconds(0))
-    , DATAPDU ()
+    : DATAPDU (DU_NNN, Seconds (0))
     , m_src     (Create<NNNAddress> (src))
     , m_dst      (Create<NNNAddress> (dst))
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
@@ -67,7 +64,7 @@ namespace ns3
       SetSrcName (du_p.GetSrcName ());
       SetDstName (du_p.GetDstName ());
       SetPDUPayloadType (du_p.GetPDUPayloadType ());
-      SetPayload (du_p.GetPayload()->Copy ());
+      SetPayload (du_p.GetPayload());
       SetWire (du_p.GetWire ());
     }
 
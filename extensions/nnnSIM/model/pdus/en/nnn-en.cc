@@ -29,14 +29,12 @@ namespace ns3
   namespace nnn
   {
     EN::EN ()
-    : NNNPDU (EN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (EN_NNN, Seconds (0))
     {
     }
 
     EN::EN (std::vector<Address> signatures)
-    : NNNPDU (EN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (EN_NNN, Seconds (0))
     {
     }
 
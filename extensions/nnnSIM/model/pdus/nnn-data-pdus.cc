@@ -23,8 +23,9 @@ namespace ns3
 {
   namespace nnn
   {
-    DATAPDU::DATAPDU ()
-    : m_PDUdatatype (NDN_NNN)
+    DATAPDU::DATAPDU (uint32_t pkt_id, Time ttl)
+    : NNNPDU (pkt_id, ttl)
+    , m_PDUdatatype (NDN_NNN)
     {
     }
 
@@ -45,7 +46,7 @@ namespace ns3
     }
 
     void
-    DATAPDU::SetPayload (Ptr<Packet> payload)
+    DATAPDU::SetPayload (Ptr<const Packet> payload)
     {
       m_payload = payload;
       SetWire(0);
@@ -25,10 +25,16 @@ namespace ns3
 {
   namespace nnn
   {
-    class DATAPDU : public virtual NNNPDU
+    /**
+     * @brief Common base of the PDUs carrying ICN payloads
+     *
+     * NNNPDU is not a virtual base, so forwarding code can StaticCast to
+     * the concrete type once GetPacketId () has identified it
+     */
+    class DATAPDU : public NNNPDU
     {
     public:
-      DATAPDU ();
+      DATAPDU (uint32_t pkt_id, Time ttl);
       virtual
       ~DATAPDU ();
 
@@ -40,9 +46,12 @@ namespace ns3
 
       /**
        * @brief Sets the payload of the DO packet
+       *
+       * The payload is never modified, so the same packet can be shared
+       * between the incoming and outgoing PDUs carrying it
        */
       void
-      SetPayload (Ptr<Packet> payload);
+      SetPayload (Ptr<const Packet> payload);
 
       /**
        * @brief Get the PDU type in DO
@@ -63,7 +72,7 @@ namespace ns3
 
     protected:
       uint16_t m_PDUdatatype;   ///< @brief Type of payload held in PDU
-      Ptr<Packet> m_payload;    ///< @brief Payload
+      Ptr<const Packet> m_payload;    ///< @brief Payload, shared copy-on-write
     };
   } /* namespace nnn */
 } /* namespace ns3 */
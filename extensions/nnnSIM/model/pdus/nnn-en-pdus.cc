@@ -23,9 +23,10 @@ namespace ns3
   namespace nnn
   {
 
-    ENPDU::ENPDU ()
-    : NNNPDU ()
+    ENPDU::ENPDU (uint32_t pkt_id, Time ttl)
+    : NNNPDU (pkt_id, ttl)
     , m_poas (std::vector<Address> ())
+    , m_poa_size (0)
     {
     }
 
@@ -37,12 +38,23 @@ namespace ns3
     ENPDU::AddPoa (Address signature)
     {
       m_poas.push_back(signature);
+      m_poa_size += signature.GetSerializedSize ();
+      SetWire (0);
     }
 
     void
     ENPDU::AddPoa (std::vector<Address> signatures)
     {
       m_poas.insert(m_poas.end (), signatures.begin (), signatures.end ());
+      for (std::vector<Address>::const_iterator it = signatures.begin (); it != signatures.end (); ++it)
+	m_poa_size += it->GetSerializedSize ();
+      SetWire (0);
+    }
+
+    uint32_t
+    ENPDU::GetPoaSerializedSize () const
+    {
+      return m_poa_size;
     }
 
     uint32_t
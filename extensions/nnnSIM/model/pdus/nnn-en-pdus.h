@@ -29,10 +29,16 @@ namespace ns3
 {
   namespace nnn
   {
-    class ENPDU : virtual public NNNPDU
+    /**
+     * @brief Common base of the enrollment PDUs
+     *
+     * NNNPDU is not a virtual base, so received PDUs can be StaticCast to
+     * their concrete type once it is known
+     */
+    class ENPDU : public NNNPDU
     {
     public:
-      ENPDU ();
+      ENPDU (uint32_t pkt_id, Time ttl);
 
       virtual
       ~ENPDU ();
@@ -74,6 +80,15 @@ namespace ns3
       void
       AddPoa (std::vector<Address> poas);
 
+      /**
+       * \brief Total serialized size of the PoA names attached
+       *
+       * Kept up to date as PoAs are added, so encoders do not have to walk
+       * the PoA list to size the PDU
+       **/
+      uint32_t
+      GetPoaSerializedSize () const;
+
       /**
        * @brief Print ENPDU in plain-text to the specified output stream
        */
@@ -82,6 +97,7 @@ namespace ns3
 
     protected:
       std::vector<Address> m_poas;  ///<@brief vector of PoA names
+      uint32_t m_poa_size;          ///<@brief Serialized size of m_poas
     };
 
   } /* namespace nnn */
@@ -24,6 +24,7 @@ namespace ns3
   namespace nnn
   {
     NNNPDU::NNNPDU ()
+    : m_stale_lifetime (false)
     {
     }
 
@@ -32,6 +33,7 @@ namespace ns3
     , m_ttl         (ttl)
     , m_version     (A_NNN)
     , m_wire        (0)
+    , m_stale_lifetime (false)
     {
     }
 
@@ -40,6 +42,7 @@ namespace ns3
     , m_ttl         (ttl)
     , m_version     (ver)
     , m_wire        (0)
+    , m_stale_lifetime (false)
     {
     }
 
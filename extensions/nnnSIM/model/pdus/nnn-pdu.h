@@ -112,6 +112,16 @@ namespace ns3
       inline void
       SetWire (Ptr<const Packet> packet) const;
 
+      /**
+       * @brief Get wire formatted packet whose lifetime is out of date
+       *
+       * SetLifetime keeps the cached wire formatted packet, as the lifetime
+       * can be patched in without encoding the whole PDU again. Until it is
+       * patched, GetWire returns 0 and the packet is only returned here
+       */
+      inline Ptr<const Packet>
+      GetStaleWire () const;
+
       virtual void
       Print (std::ostream &os) const;
 
@@ -120,6 +130,7 @@ namespace ns3
       Time m_ttl;                           ///< @brief Packet life time (TTL)
       uint16_t m_version;                   ///< @brief NNN Packet version
       mutable Ptr<const Packet> m_wire;
+      mutable bool m_stale_lifetime;        ///< @brief m_wire has an outdated lifetime
     };
 
     inline uint32_t
@@ -150,19 +161,26 @@ namespace ns3
     NNNPDU::SetLifetime (Time ttl)
     {
       m_ttl = ttl;
-      m_wire = 0;
+      m_stale_lifetime = (m_wire != 0);
     }
 
     inline Ptr<const Packet>
     NNNPDU::GetWire () const
     {
-      return m_wire;
+      return m_stale_lifetime ? 0 : m_wire;
     }
 
     inline void
     NNNPDU::SetWire (Ptr<const Packet> packet) const
     {
       m_wire = packet;
+      m_stale_lifetime = false;
+    }
+
+    inline Ptr<const Packet>
+    NNNPDU::GetStaleWire () const
+    {
+      return m_stale_lifetime ? m_wire : 0;
     }
 
   } /* namespace nnn */
@@ -29,16 +29,14 @@ namespace ns3
   namespace nnn
   {
     NULLp::NULLp ()
-    : NNNPDU (NULL_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (NULL_NNN, Seconds (0))
     {
     }
 
     NULLp::NULLp (Ptr<Packet> payload)
-    : NNNPDU (NULL_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (NULL_NNN, Seconds (0))
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
@@ -51,7 +49,7 @@ namespace ns3
       SetVersion (nullp.GetVersion ());
       SetLifetime (nullp.GetLifetime ());
       SetPDUPayloadType (nullp.GetPDUPayloadType ());
-      SetPayload (nullp.GetPayload()->Copy ());
+      SetPayload (nullp.GetPayload());
       SetWire (nullp.GetWire ());
     }
 
@@ -27,21 +27,21 @@ namespace ns3
   namespace nnn
   {
     OEN::OEN ()
-    : NNNPDU (OEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (OEN_NNN, Seconds (0))
+    , m_personal_poa_size (0)
     {
     }
 
     OEN::OEN (Ptr<NNNAddress> name)
-    : NNNPDU (OEN_NNN, Seconds(0))
-    , ENPDU ()
+    : ENPDU (OEN_NNN, Seconds (0))
+    , m_personal_poa_size (0)
     {
       SetName (name);
     }
 
     OEN::OEN (const NNNAddress &name)
-    : NNNPDU (OEN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (OEN_NNN, Seconds (0))
+    , m_personal_poa_size (0)
     {
       SetName (name);
     }
@@ -51,6 +51,7 @@ namespace ns3
     }
 
     OEN::OEN (const OEN &oen_p)
+    : m_personal_poa_size (0)
     {
       NS_LOG_FUNCTION("OEN correct copy constructor");
       OEN ();
@@ -154,12 +155,23 @@ namespace ns3
     OEN::AddPersonalPoa (Address signature)
     {
       m_personal_poas.push_back(signature);
+      m_personal_poa_size += signature.GetSerializedSize ();
+      SetWire (0);
     }
 
     void
     OEN::AddPersonalPoa (std::vector<Address> signatures)
     {
       m_personal_poas.insert(m_personal_poas.end (), signatures.begin (), signatures.end ());
+      for (std::vector<Address>::const_iterator it = signatures.begin (); it != signatures.end (); ++it)
+	m_personal_poa_size += it->GetSerializedSize ();
+      SetWire (0);
+    }
+
+    uint32_t
+    OEN::GetPersonalPoaSerializedSize () const
+    {
+      return m_personal_poa_size;
     }
 
     uint32_t
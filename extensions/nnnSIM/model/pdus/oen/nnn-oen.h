@@ -124,6 +124,12 @@ namespace ns3
       void
       AddPersonalPoa (std::vector<Address> poas);
 
+      /**
+       * @brief Total serialized size of the personal PoA names attached
+       */
+      uint32_t
+      GetPersonalPoaSerializedSize () const;
+
     private:
       // NO_ASSIGN
       OEN &
@@ -134,6 +140,7 @@ namespace ns3
 
       Ptr<NNNAddress> m_src_name;            ///< @brief Name of Node sending the OEN
       std::vector<Address> m_personal_poas;  ///<@brief vector of PoA names
+      uint32_t m_personal_poa_size;          ///<@brief Serialized size of m_personal_poas
     };
 
     inline std::ostream &
@@ -30,23 +30,20 @@ namespace ns3
   namespace nnn
   {
     REN::REN ()
-    : NNNPDU (REN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (REN_NNN, Seconds (0))
     , m_re_lease (Seconds (0))
     {
     }
 
     REN::REN (Ptr<NNNAddress> name)
-    : NNNPDU (REN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (REN_NNN, Seconds (0))
     , m_name     (name)
     , m_re_lease (Seconds (0))
     {
     }
 
     REN::REN (const NNNAddress &name)
-    : NNNPDU (REN_NNN, Seconds (0))
-    , ENPDU ()
+    : ENPDU (REN_NNN, Seconds (0))
     , m_re_lease (Seconds (0))
     {
       SetName (name);
@@ -29,29 +29,26 @@ namespace ns3
   namespace nnn
   {
     SO::SO ()
-    : NNNPDU (SO_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (SO_NNN, Seconds (0))
     , m_name (Create<NNNAddress> ())
     {
     }
 
     SO::SO (Ptr<NNNAddress> name, Ptr<Packet> payload)
-    : NNNPDU (SO_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (SO_NNN, Seconds (0))
     , m_name (name)
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
     }
 
     SO::SO (const NNNAddress &name, Ptr<Packet> payload)
-    : NNNPDU (SO_NNN, Seconds (0))
-    , DATAPDU ()
+    : DATAPDU (SO_NNN, Seconds (0))
     , m_name     (Create<NNNAddress> (name))
     {
-      if (m_payload == 0)
+      if (payload == 0)
 	m_payload = Create<Packet> ();
       else
 	m_payload = payload;
@@ -65,7 +62,7 @@ namespace ns3
       SetLifetime (so_p.GetLifetime ());
       SetName (so_p.GetName());
       SetPDUPayloadType (so_p.GetPDUPayloadType ());
-      SetPayload (so_p.GetPayload()->Copy ());
+      SetPayload (so_p.GetPayload());
       SetWire (so_p.GetWire ());
     }
 
@@ -33,43 +33,132 @@ namespace ns3
     {
       IncomingFace::IncomingFace (Ptr<Face> face)
       : m_face (face)
+      , m_numInline (0)
       , m_arrivalTime (Simulator::Now ())
-      , m_addrs (Create<NNNAddrAggregator> ())
       // , m_nonce (nonce)
       {
       }
 
       IncomingFace::IncomingFace (Ptr<Face> face, Ptr<const NNNAddress> addr)
       : m_face (face)
+      , m_numInline (0)
       , m_arrivalTime (Simulator::Now ())
-      , m_addrs (Create<NNNAddrAggregator> ())
       {
-	m_addrs->AddDestination(addr);
+	AddDestination(addr);
       }
 
       IncomingFace::IncomingFace ()
       : m_face (0)
+      , m_numInline (0)
       , m_arrivalTime (0)
-      , m_addrs (Create<NNNAddrAggregator> ())
       {
       }
 
       void
       IncomingFace::AddDestination(Ptr<const NNNAddress> addr)
       {
+	if (m_addrs != 0)
+	  {
+	    m_addrs->AddDestination(addr);
+	    return;
+	  }
+
+	for (uint8_t i = 0; i < m_numInline; i++)
+	  {
+	    if (*m_inline[i] == *addr)
+	      return;
+	  }
+
+	if (m_numInline < INLINE_ADDRS)
+	  {
+	    m_inline[m_numInline++] = addr;
+	    return;
+	  }
+
+	// Out of inline space, move everything to the aggregator
+	m_addrs = Create<NNNAddrAggregator> ();
+	for (uint8_t i = 0; i < m_numInline; i++)
+	  {
+	    m_addrs->AddDestination(m_inline[i]);
+	    m_inline[i] = 0;
+	  }
+	m_numInline = 0;
+
 	m_addrs->AddDestination(addr);
       }
 
       void
       IncomingFace::RemoveDestination(Ptr<const NNNAddress> addr)
       {
-	m_addrs->RemoveDestination(addr);
+	if (m_addrs != 0)
+	  {
+	    m_addrs->RemoveDestination(addr);
+	    return;
+	  }
+
+	for (uint8_t i = 0; i < m_numInline; i++)
+	  {
+	    if (*m_inline[i] == *addr)
+	      {
+		for (uint8_t j = i + 1; j < m_numInline; j++)
+		  m_inline[j - 1] = m_inline[j];
+
+		m_inline[--m_numInline] = 0;
+		return;
+	      }
+	  }
       }
 
       bool
-      IncomingFace::NoAddresses()
+      IncomingFace::NoAddresses() const
       {
-	return m_addrs->isEmpty();
+	if (m_addrs != 0)
+	  return m_addrs->isEmpty();
+	else
+	  return (m_numInline == 0);
+      }
+
+      std::vector<Ptr<NNNAddress> >
+      IncomingFace::GetDistinctDestinations () const
+      {
+	if (m_addrs != 0)
+	  return m_addrs->GetDistinctDestinations ();
+
+	std::vector<Ptr<NNNAddress> > distinct;
+
+	for (uint8_t i = 0; i < m_numInline; i++)
+	  {
+	    Ptr<NNNAddress> sector = Create<NNNAddress> (m_inline[i]->getSectorName ());
+
+	    bool seen = false;
+	    for (size_t j = 0; j < distinct.size (); j++)
+	      {
+		if (*distinct[j] == *sector)
+		  seen = true;
+	      }
+
+	    if (!seen)
+	      distinct.push_back (sector);
+	  }
+
+	return distinct;
+      }
+
+      std::vector<Ptr<NNNAddress> >
+      IncomingFace::GetCompleteDestinations (Ptr<NNNAddress> sector) const
+      {
+	if (m_addrs != 0)
+	  return m_addrs->GetCompleteDestinations (sector);
+
+	std::vector<Ptr<NNNAddress> > complete;
+
+	for (uint8_t i = 0; i < m_numInline; i++)
+	  {
+	    if (m_inline[i]->getSectorName () == *sector)
+	      complete.push_back (Create<NNNAddress> (*m_inline[i]));
+	  }
+
+	return complete;
       }
 
       /**
@@ -80,6 +169,9 @@ namespace ns3
       {
 	m_face = other.m_face;
 	m_addrs = other.m_addrs;
+	for (uint8_t i = 0; i < INLINE_ADDRS; i++)
+	  m_inline[i] = other.m_inline[i];
+	m_numInline = other.m_numInline;
 	m_arrivalTime = other.m_arrivalTime;
 	return *this;
       }
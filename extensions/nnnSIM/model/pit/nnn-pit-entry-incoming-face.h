@@ -22,6 +22,8 @@
 #ifndef _NNN_PIT_ENTRY_INCOMING_FACE_H_
 #define	_NNN_PIT_ENTRY_INCOMING_FACE_H_
 
+#include <vector>
+
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/ptr.h>
 
@@ -39,11 +41,19 @@ namespace ns3
       /**
        * @ingroup nnn-pit
        * @brief PIT state component for each incoming interest (not including duplicates)
+       *
+       * Most incoming faces see no 3N names at all or only one or two, so
+       * these are kept inline. The NNNAddrAggregator is only created once
+       * more names than that have to be aggregated.
        */
       struct IncomingFace
       {
+	static const uint8_t INLINE_ADDRS = 2; ///< \brief 3N names stored before falling back to the aggregator
+
 	Ptr<Face> m_face; ///< \brief face of the incoming Interest
-	Ptr<NNNAddrAggregator> m_addrs; ///< \brief 3N names seen in incoming Interests
+	Ptr<NNNAddrAggregator> m_addrs; ///< \brief 3N names seen in incoming Interests, 0 while they fit inline
+	Ptr<const NNNAddress> m_inline[INLINE_ADDRS]; ///< \brief 3N names seen in incoming Interests
+	uint8_t m_numInline; ///< \brief Number of valid entries in m_inline
 	Time m_arrivalTime;   ///< \brief arrival time of the incoming Interest
 
       public:
@@ -80,7 +90,20 @@ namespace ns3
 	RemoveDestination (Ptr<const NNNAddress> addr);
 
 	bool
-	NoAddresses ();
+	NoAddresses () const;
+
+	/**
+	 * \brief Obtain the distinct sectors of the 3N names aggregated
+	 */
+	std::vector<Ptr<NNNAddress> >
+	GetDistinctDestinations () const;
+
+	/**
+	 * \brief Obtain the complete 3N names aggregated under sector
+	 * \param sector sector as given by GetDistinctDestinations
+	 */
+	std::vector<Ptr<NNNAddress> >
+	GetCompleteDestinations (Ptr<NNNAddress> sector) const;
 
 	/**
 	 * @brief Copy operator
@@ -159,12 +159,12 @@ namespace ns3
 
 	if (it != m_incoming.end())
 	  {
-	    IncomingFace inface = const_cast<IncomingFace&>(*it);
+	    IncomingFace &inface = const_cast<IncomingFace&>(*it);
 
 	    inface.RemoveDestination(addr);
 
 	    if (inface.NoAddresses())
-	      m_incoming.erase(face);
+	      m_incoming.erase(it);
 	  }
       }
 
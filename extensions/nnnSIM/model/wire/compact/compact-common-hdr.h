@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-common-hdr.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-common-hdr.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-common-hdr.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPACT_COMMON_HDR_H_
+#define COMPACT_COMMON_HDR_H_
+
+#include <ns3-dev/ns3/ptr.h>
+
+#include "compact-common.h"
+#include "../nnn-wire.h"
+#include "../../../helper/nnn-header-helper.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace wire
+    {
+      namespace compact
+      {
+
+	/**
+	 * @brief Fields shared by all PDUs in compact format
+	 *
+	 * A type byte, with Compact::TypeFlag set, followed by the TTL in
+	 * seconds and the version as varints. There is no length field, all
+	 * the fields which follow are self delimiting and the payload of
+	 * data PDUs takes the rest of the packet
+	 */
+	template <class T>
+	class CommonHeader : public Header
+	{
+	  public:
+
+	  CommonHeader ()
+	  : m_ptr (Create<T> ())
+	  {
+	  }
+
+	  CommonHeader (Ptr<T> t_p)
+	  : m_ptr (t_p)
+	  {
+	  }
+
+	  virtual
+	  ~CommonHeader ()
+	  {
+	  }
+
+	  Ptr<T>
+	  GetPtr()
+	  {
+	    return m_ptr;
+	  }
+
+	  size_t
+	  CommonGetSerializedSize () const
+	  {
+	    return (1 +                                                 /* PacketId */
+		Compact::SerializedSizeVarint (CommonLifetime ()) +     /* TTL */
+		Compact::SerializedSizeVarint (m_ptr->GetVersion ())    /* Version */
+	    );
+	  }
+
+	  /**
+	   * @brief Serialize the common fields, leaving start after them
+	   */
+	  void
+	  CommonSerialize (Buffer::Iterator &start) const
+	  {
+	    start.WriteU8 (static_cast<uint8_t> (Compact::TypeFlag | m_ptr->GetPacketId ()));
+	    Compact::SerializeVarint (start, CommonLifetime ());
+	    Compact::SerializeVarint (start, m_ptr->GetVersion ());
+	  }
+
+	  /**
+	   * @brief Deserialize the common fields, leaving start after them
+	   * @returns the PDU type read
+	   */
+	  uint32_t
+	  CommonDeserialize (Buffer::Iterator &start)
+	  {
+	    uint32_t type = start.ReadU8 () & ~Compact::TypeFlag;
+	    m_ptr->SetLifetime (Seconds (Compact::DeserializeVarint (start)));
+	    m_ptr->SetVersion (static_cast<uint16_t> (Compact::DeserializeVarint (start)));
+
+	    return type;
+	  }
+
+	  /**
+	   * @brief Cached wire format of t_p, 0 if it has to be encoded
+	   *
+	   * Only a cached wire in compact format is returned. A change of
+	   * lifetime can change the width of its varint, so stale wires are
+	   * encoded again instead of being patched
+	   */
+	  static Ptr<const Packet>
+	  CachedWire (Ptr<const T> t_p)
+	  {
+	    Ptr<const Packet> wire = t_p->GetWire ();
+	    if (wire != 0 && HeaderHelper::GetWireFormat (wire) != Wire::WIRE_FORMAT_COMPACT)
+	      return 0;
+
+	    return wire;
+	  }
+
+	  void Print (std::ostream &os) const
+	  {
+	    m_ptr->Print(os);
+	  }
+
+	  protected:
+	  Ptr<T> m_ptr;
+
+	  private:
+	  uint64_t
+	  CommonLifetime () const
+	  {
+	    int64_t lifetime = m_ptr->GetLifetime ().ToInteger (Time::S);
+	    NS_ASSERT_MSG (0 <= lifetime, "Incorrect Lifetime (should not be smaller than 0)");
+	    return static_cast<uint64_t> (lifetime);
+	  }
+	};
+
+      } /* namespace compact */
+    } /* namespace wire */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* COMPACT_COMMON_HDR_H_ */
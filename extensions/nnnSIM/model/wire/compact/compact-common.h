@@ -0,0 +1,31 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-common.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-common.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-common.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_WIRE_COMPACT_COMMON_H
+#define NNN_WIRE_COMPACT_COMMON_H
+
+#include <ns3-dev/ns3/header.h>
+#include <ns3-dev/ns3/packet.h>
+#include <ns3-dev/ns3/log.h>
+
+#include "../wire-compact.h"
+#include "../../nnn-common.h"
+#include "../../nnn-pdus.h"
+
+#endif // NNN_WIRE_COMPACT_COMMON_H
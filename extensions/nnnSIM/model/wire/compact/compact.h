@@ -0,0 +1,34 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_WIRE_COMPACT_H
+#define NNN_WIRE_COMPACT_H
+
+#include "nullp/compact-nullp.h"
+#include "so/compact-so.h"
+#include "do/compact-do.h"
+#include "du/compact-du.h"
+#include "en/compact-en.h"
+#include "oen/compact-oen.h"
+#include "aen/compact-aen.h"
+#include "ren/compact-ren.h"
+#include "den/compact-den.h"
+#include "inf/compact-inf.h"
+
+#endif // NNN_WIRE_COMPACT_H
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-den.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-den.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-den.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-den.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (DEN);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.DEN");
+
+    DEN::DEN ()
+    : CommonHeader<nnn::DEN> ()
+    {
+    }
+
+    DEN::DEN (Ptr<nnn::DEN> den_p)
+    : CommonHeader<nnn::DEN> (den_p)
+    {
+    }
+
+    TypeId
+    DEN::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::DEN::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<DEN> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    DEN::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    DEN::ToWire (Ptr<const nnn::DEN> den_p)
+    {
+      Ptr<const Packet> p = CachedWire (den_p);
+      if (!p)
+	{
+	  // Mechanism packets have no payload, make an empty packet
+	  Ptr<Packet> packet = Create<Packet> ();
+	  DEN wireEncoding (ConstCast<nnn::DEN> (den_p));
+	  packet->AddHeader (wireEncoding);
+	  den_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::DEN>
+    DEN::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::DEN> den_p = Create<nnn::DEN> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      DEN wireEncoding (den_p);
+      packet->RemoveHeader (wireEncoding);
+
+      den_p->SetWire (wire);
+
+      return den_p;
+    }
+
+    Ptr<nnn::DEN>
+    DEN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DEN> den_p = Create<nnn::DEN> ();
+
+      DEN wireEncoding (den_p);
+      wire->PeekHeader (wireEncoding);
+
+      den_p->SetWire (wire);
+
+      return den_p;
+    }
+
+    uint32_t
+    DEN::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                           /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetNumPoa ()) +  /* Number of PoAs */
+	  m_ptr->GetPoaSerializedSize () +                       /* Total size of PoAs */
+	  Compact::SerializedSizeName (m_ptr->GetName ())        /* Name size */
+	  ;
+      return size;
+    }
+
+    void
+    DEN::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PoAs
+      Compact::SerializeVarint (start, m_ptr->GetNumPoa ());
+      for (uint32_t i = 0; i < m_ptr->GetNumPoa (); i++)
+	Compact::SerializeAddress (start, m_ptr->GetOnePoa (i));
+
+      // Serialize the name
+      Compact::SerializeName (start, m_ptr->GetName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    DEN::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::DEN_NNN)
+	throw new DENException ();
+
+      // Deserialize the PoAs
+      uint64_t totalpoas = Compact::DeserializeVarint (i);
+      for (uint64_t k = 0; k < totalpoas; k++)
+	m_ptr->AddPoa (Compact::DeserializeAddress (i));
+
+      // Deserialize the name
+      m_ptr->SetName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
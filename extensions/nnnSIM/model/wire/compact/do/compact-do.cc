@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-do.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-do.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-do.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-do.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (DO);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.DO");
+
+    DO::DO ()
+    : CommonHeader<nnn::DO> ()
+    {
+    }
+
+    DO::DO (Ptr<nnn::DO> do_p)
+    : CommonHeader<nnn::DO> (do_p)
+    {
+    }
+
+    TypeId
+    DO::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::DO::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<DO> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    DO::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    DO::ToWire (Ptr<const nnn::DO> do_p)
+    {
+      Ptr<const Packet> p = CachedWire (do_p);
+      if (!p)
+	{
+	  Ptr<Packet> packet = Create<Packet> (*do_p->GetPayload ());
+	  DO wireEncoding (ConstCast<nnn::DO> (do_p));
+	  packet->AddHeader (wireEncoding);
+	  do_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::DO>
+    DO::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::DO> do_p = Create<nnn::DO> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      DO wireEncoding (do_p);
+      packet->RemoveHeader (wireEncoding);
+
+      do_p->SetPayload (packet);
+      do_p->SetWire (wire);
+
+      return do_p;
+    }
+
+    Ptr<nnn::DO>
+    DO::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DO> do_p = Create<nnn::DO> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      DO wireEncoding (do_p);
+      packet->RemoveHeader (wireEncoding);
+
+      do_p->SetPayload (packet);
+      do_p->SetWire (wire);
+
+      return do_p;
+    }
+
+    uint32_t
+    DO::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                                   /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetPDUPayloadType ()) +  /* PDU Data type */
+	  Compact::SerializedSizeName (m_ptr->GetName ())                /* Name size */
+	  ;
+      return size;
+    }
+
+    void
+    DO::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PDU Data type
+      Compact::SerializeVarint (start, m_ptr->GetPDUPayloadType ());
+
+      // Serialize the name
+      Compact::SerializeName (start, m_ptr->GetName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    DO::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::DO_NNN)
+	throw new DOException ();
+
+      // Deserialize the PDU Data type
+      m_ptr->SetPDUPayloadType (static_cast<uint16_t> (Compact::DeserializeVarint (i)));
+
+      // Deserialize the name
+      m_ptr->SetName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-du.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-du.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-du.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-du.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (DU);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.DU");
+
+    DU::DU ()
+    : CommonHeader<nnn::DU> ()
+    {
+    }
+
+    DU::DU (Ptr<nnn::DU> du_p)
+    : CommonHeader<nnn::DU> (du_p)
+    {
+    }
+
+    TypeId
+    DU::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::DU::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<DU> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    DU::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    DU::ToWire (Ptr<const nnn::DU> du_p)
+    {
+      Ptr<const Packet> p = CachedWire (du_p);
+      if (!p)
+	{
+	  Ptr<Packet> packet = Create<Packet> (*du_p->GetPayload ());
+	  DU wireEncoding (ConstCast<nnn::DU> (du_p));
+	  packet->AddHeader (wireEncoding);
+	  du_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::DU>
+    DU::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::DU> du_p = Create<nnn::DU> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      DU wireEncoding (du_p);
+      packet->RemoveHeader (wireEncoding);
+
+      du_p->SetPayload (packet);
+      du_p->SetWire (wire);
+
+      return du_p;
+    }
+
+    Ptr<nnn::DU>
+    DU::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DU> du_p = Create<nnn::DU> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      DU wireEncoding (du_p);
+      packet->RemoveHeader (wireEncoding);
+
+      du_p->SetPayload (packet);
+      du_p->SetWire (wire);
+
+      return du_p;
+    }
+
+    uint32_t
+    DU::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                                   /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetPDUPayloadType ()) +  /* PDU Data type */
+	  Compact::SerializedSizeName (m_ptr->GetSrcName ()) +           /* Source name size */
+	  Compact::SerializedSizeName (m_ptr->GetDstName ())             /* Destination name size */
+	  ;
+      return size;
+    }
+
+    void
+    DU::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PDU Data type
+      Compact::SerializeVarint (start, m_ptr->GetPDUPayloadType ());
+
+      // Serialize the source name
+      Compact::SerializeName (start, m_ptr->GetSrcName ());
+
+      // Serialize the destination name
+      Compact::SerializeName (start, m_ptr->GetDstName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    DU::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::DU_NNN)
+	throw new DUException ();
+
+      // Deserialize the PDU Data type
+      m_ptr->SetPDUPayloadType (static_cast<uint16_t> (Compact::DeserializeVarint (i)));
+
+      // Deserialize the source name
+      m_ptr->SetSrcName (Compact::DeserializeName (i));
+
+      // Deserialize the destination name
+      m_ptr->SetDstName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
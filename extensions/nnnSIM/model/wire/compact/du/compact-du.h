@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-du.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-du.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-du.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_WIRE_COMPACT_DU_H
+#define NNN_WIRE_COMPACT_DU_H
+
+#include "../compact-common-hdr.h"
+#include "../compact-common.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+
+  /**
+   * @brief Namespace for compact wire format operations
+   */
+  namespace compact {
+
+    /**
+     * @brief Routines to serialize/deserialize DU packets in compact format
+     */
+    class DU : public CommonHeader<nnn::DU>
+    {
+    public:
+      DU ();
+      DU (Ptr<nnn::DU> du_p);
+
+      static Ptr<Packet>
+      ToWire (Ptr<const nnn::DU> du_p);
+
+      static Ptr<nnn::DU>
+      FromWire (Ptr<Packet> packet);
+
+      /**
+       * @brief Decode wire without modifying it, wire is kept as the
+       * cached wire format of the PDU
+       */
+      static Ptr<nnn::DU>
+      FromWire (Ptr<const Packet> wire);
+
+      // from Header
+      static TypeId GetTypeId (void);
+      TypeId GetInstanceTypeId (void) const;
+      uint32_t GetSerializedSize (void) const;
+      void Serialize (Buffer::Iterator start) const;
+      uint32_t Deserialize (Buffer::Iterator start);
+    };
+
+  }
+}
+
+NNN_NAMESPACE_END
+
+#endif // NNN_WIRE_COMPACT_DU_H
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-en.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-en.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-en.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-en.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (EN);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.EN");
+
+    EN::EN ()
+    : CommonHeader<nnn::EN> ()
+    {
+    }
+
+    EN::EN (Ptr<nnn::EN> en_p)
+    : CommonHeader<nnn::EN> (en_p)
+    {
+    }
+
+    TypeId
+    EN::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::EN::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<EN> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    EN::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    EN::ToWire (Ptr<const nnn::EN> en_p)
+    {
+      Ptr<const Packet> p = CachedWire (en_p);
+      if (!p)
+	{
+	  // Mechanism packets have no payload, make an empty packet
+	  Ptr<Packet> packet = Create<Packet> ();
+	  EN wireEncoding (ConstCast<nnn::EN> (en_p));
+	  packet->AddHeader (wireEncoding);
+	  en_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::EN>
+    EN::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::EN> en_p = Create<nnn::EN> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      EN wireEncoding (en_p);
+      packet->RemoveHeader (wireEncoding);
+
+      en_p->SetWire (wire);
+
+      return en_p;
+    }
+
+    Ptr<nnn::EN>
+    EN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::EN> en_p = Create<nnn::EN> ();
+
+      EN wireEncoding (en_p);
+      wire->PeekHeader (wireEncoding);
+
+      en_p->SetWire (wire);
+
+      return en_p;
+    }
+
+    uint32_t
+    EN::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                           /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetNumPoa ()) +  /* Number of PoAs */
+	  m_ptr->GetPoaSerializedSize ()                         /* Total size of PoAs */
+	  ;
+      return size;
+    }
+
+    void
+    EN::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PoAs
+      Compact::SerializeVarint (start, m_ptr->GetNumPoa ());
+      for (uint32_t i = 0; i < m_ptr->GetNumPoa (); i++)
+	Compact::SerializeAddress (start, m_ptr->GetOnePoa (i));
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    EN::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::EN_NNN)
+	throw new ENException ();
+
+      // Deserialize the PoAs
+      uint64_t totalpoas = Compact::DeserializeVarint (i);
+      for (uint64_t k = 0; k < totalpoas; k++)
+	m_ptr->AddPoa (Compact::DeserializeAddress (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
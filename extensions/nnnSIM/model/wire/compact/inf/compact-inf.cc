@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-inf.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-inf.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-inf.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-inf.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (INF);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.INF");
+
+    INF::INF ()
+    : CommonHeader<nnn::INF> ()
+    {
+    }
+
+    INF::INF (Ptr<nnn::INF> inf_p)
+    : CommonHeader<nnn::INF> (inf_p)
+    {
+    }
+
+    TypeId
+    INF::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::INF::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<INF> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    INF::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    INF::ToWire (Ptr<const nnn::INF> inf_p)
+    {
+      Ptr<const Packet> p = CachedWire (inf_p);
+      if (!p)
+	{
+	  // Mechanism packets have no payload, make an empty packet
+	  Ptr<Packet> packet = Create<Packet> ();
+	  INF wireEncoding (ConstCast<nnn::INF> (inf_p));
+	  packet->AddHeader (wireEncoding);
+	  inf_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::INF>
+    INF::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::INF> inf_p = Create<nnn::INF> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      INF wireEncoding (inf_p);
+      packet->RemoveHeader (wireEncoding);
+
+      inf_p->SetWire (wire);
+
+      return inf_p;
+    }
+
+    Ptr<nnn::INF>
+    INF::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::INF> inf_p = Create<nnn::INF> ();
+
+      INF wireEncoding (inf_p);
+      wire->PeekHeader (wireEncoding);
+
+      inf_p->SetWire (wire);
+
+      return inf_p;
+    }
+
+    uint32_t
+    INF::GetSerializedSize (void) const
+    {
+      uint64_t lease = static_cast<uint64_t> (m_ptr->GetRemainLease ().ToInteger (Time::S));
+
+      size_t size =
+	  CommonGetSerializedSize () +                          /* Common header */
+	  Compact::SerializedSizeVarint (lease) +               /* Lease time */
+	  Compact::SerializedSizeName (m_ptr->GetOldName ()) +  /* Old name size */
+	  Compact::SerializedSizeName (m_ptr->GetNewName ())    /* New name size */
+	  ;
+      return size;
+    }
+
+    void
+    INF::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the lease time
+      int64_t lease = m_ptr->GetRemainLease ().ToInteger (Time::S);
+      NS_ASSERT_MSG (0 <= lease, "Incorrect Lease time (should not be smaller than 0)");
+      Compact::SerializeVarint (start, static_cast<uint64_t> (lease));
+
+      // Serialize the old name
+      Compact::SerializeName (start, m_ptr->GetOldName ());
+
+      // Serialize the new name
+      Compact::SerializeName (start, m_ptr->GetNewName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    INF::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::INF_NNN)
+	throw new INFException ();
+
+      // Deserialize the lease time
+      m_ptr->SetRemainLease (Seconds (Compact::DeserializeVarint (i)));
+
+      // Deserialize the old name
+      m_ptr->SetOldName (Compact::DeserializeName (i));
+
+      // Deserialize the new name
+      m_ptr->SetNewName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
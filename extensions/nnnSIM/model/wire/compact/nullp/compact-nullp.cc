@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-nullp.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-nullp.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-nullp.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-nullp.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (NULLp);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.NULLp");
+
+    NULLp::NULLp ()
+    : CommonHeader<nnn::NULLp> ()
+    {
+    }
+
+    NULLp::NULLp (Ptr<nnn::NULLp> null_p)
+    : CommonHeader<nnn::NULLp> (null_p)
+    {
+    }
+
+    TypeId
+    NULLp::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::NULLp::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<NULLp> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    NULLp::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    NULLp::ToWire (Ptr<const nnn::NULLp> null_p)
+    {
+      Ptr<const Packet> p = CachedWire (null_p);
+      if (!p)
+	{
+	  Ptr<Packet> packet = Create<Packet> (*null_p->GetPayload ());
+	  NULLp wireEncoding (ConstCast<nnn::NULLp> (null_p));
+	  packet->AddHeader (wireEncoding);
+	  null_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::NULLp>
+    NULLp::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::NULLp> null_p = Create<nnn::NULLp> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      NULLp wireEncoding (null_p);
+      packet->RemoveHeader (wireEncoding);
+
+      null_p->SetPayload (packet);
+      null_p->SetWire (wire);
+
+      return null_p;
+    }
+
+    Ptr<nnn::NULLp>
+    NULLp::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::NULLp> null_p = Create<nnn::NULLp> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      NULLp wireEncoding (null_p);
+      packet->RemoveHeader (wireEncoding);
+
+      null_p->SetPayload (packet);
+      null_p->SetWire (wire);
+
+      return null_p;
+    }
+
+    uint32_t
+    NULLp::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                                 /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetPDUPayloadType ())  /* PDU Data type */
+	  ;
+      return size;
+    }
+
+    void
+    NULLp::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PDU Data type
+      Compact::SerializeVarint (start, m_ptr->GetPDUPayloadType ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    NULLp::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::NULL_NNN)
+	throw new NULLpException ();
+
+      // Deserialize the PDU Data type
+      m_ptr->SetPDUPayloadType (static_cast<uint16_t> (Compact::DeserializeVarint (i)));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-oen.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-oen.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-oen.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-oen.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (OEN);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.OEN");
+
+    OEN::OEN ()
+    : CommonHeader<nnn::OEN> ()
+    {
+    }
+
+    OEN::OEN (Ptr<nnn::OEN> oen_p)
+    : CommonHeader<nnn::OEN> (oen_p)
+    {
+    }
+
+    TypeId
+    OEN::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::OEN::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<OEN> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    OEN::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    OEN::ToWire (Ptr<const nnn::OEN> oen_p)
+    {
+      Ptr<const Packet> p = CachedWire (oen_p);
+      if (!p)
+	{
+	  // Mechanism packets have no payload, make an empty packet
+	  Ptr<Packet> packet = Create<Packet> ();
+	  OEN wireEncoding (ConstCast<nnn::OEN> (oen_p));
+	  packet->AddHeader (wireEncoding);
+	  oen_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::OEN>
+    OEN::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::OEN> oen_p = Create<nnn::OEN> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      OEN wireEncoding (oen_p);
+      packet->RemoveHeader (wireEncoding);
+
+      oen_p->SetWire (wire);
+
+      return oen_p;
+    }
+
+    Ptr<nnn::OEN>
+    OEN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::OEN> oen_p = Create<nnn::OEN> ();
+
+      OEN wireEncoding (oen_p);
+      wire->PeekHeader (wireEncoding);
+
+      oen_p->SetWire (wire);
+
+      return oen_p;
+    }
+
+    uint32_t
+    OEN::GetSerializedSize (void) const
+    {
+      uint64_t lease = static_cast<uint64_t> (m_ptr->GetLeasetime ().ToInteger (Time::S));
+
+      size_t size =
+	  CommonGetSerializedSize () +                                   /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetNumPoa ()) +          /* Number of PoAs */
+	  m_ptr->GetPoaSerializedSize () +                               /* Total size of PoAs */
+	  Compact::SerializedSizeVarint (lease) +                        /* Lease time */
+	  Compact::SerializedSizeName (m_ptr->GetName ()) +              /* Name size */
+	  Compact::SerializedSizeVarint (m_ptr->GetPersonalNumPoa ()) +  /* Number of personal PoAs */
+	  m_ptr->GetPersonalPoaSerializedSize () +                       /* Total size of personal PoAs */
+	  Compact::SerializedSizeName (m_ptr->GetSrcName ())             /* Source name size */
+	  ;
+      return size;
+    }
+
+    void
+    OEN::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PoAs
+      Compact::SerializeVarint (start, m_ptr->GetNumPoa ());
+      for (uint32_t i = 0; i < m_ptr->GetNumPoa (); i++)
+	Compact::SerializeAddress (start, m_ptr->GetOnePoa (i));
+
+      // Serialize the lease time
+      int64_t lease = m_ptr->GetLeasetime ().ToInteger (Time::S);
+      NS_ASSERT_MSG (0 <= lease, "Incorrect Lease time (should not be smaller than 0)");
+      Compact::SerializeVarint (start, static_cast<uint64_t> (lease));
+
+      // Serialize the name
+      Compact::SerializeName (start, m_ptr->GetName ());
+
+      // Serialize the personal PoAs
+      Compact::SerializeVarint (start, m_ptr->GetPersonalNumPoa ());
+      for (uint32_t i = 0; i < m_ptr->GetPersonalNumPoa (); i++)
+	Compact::SerializeAddress (start, m_ptr->GetPersonalOnePoa (i));
+
+      // Serialize the source name
+      Compact::SerializeName (start, m_ptr->GetSrcName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    OEN::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::OEN_NNN)
+	throw new OENException ();
+
+      // Deserialize the PoAs
+      uint64_t totalpoas = Compact::DeserializeVarint (i);
+      for (uint64_t k = 0; k < totalpoas; k++)
+	m_ptr->AddPoa (Compact::DeserializeAddress (i));
+
+      // Deserialize the lease time
+      m_ptr->SetLeasetime (Seconds (Compact::DeserializeVarint (i)));
+
+      // Deserialize the name
+      m_ptr->SetName (Compact::DeserializeName (i));
+
+      // Deserialize the personal PoAs
+      uint64_t personal_totalpoas = Compact::DeserializeVarint (i);
+      for (uint64_t k = 0; k < personal_totalpoas; k++)
+	m_ptr->AddPersonalPoa (Compact::DeserializeAddress (i));
+
+      // Deserialize the source name
+      m_ptr->SetSrcName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-ren.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-ren.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-ren.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-ren.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (REN);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.REN");
+
+    REN::REN ()
+    : CommonHeader<nnn::REN> ()
+    {
+    }
+
+    REN::REN (Ptr<nnn::REN> ren_p)
+    : CommonHeader<nnn::REN> (ren_p)
+    {
+    }
+
+    TypeId
+    REN::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::REN::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<REN> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    REN::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    REN::ToWire (Ptr<const nnn::REN> ren_p)
+    {
+      Ptr<const Packet> p = CachedWire (ren_p);
+      if (!p)
+	{
+	  // Mechanism packets have no payload, make an empty packet
+	  Ptr<Packet> packet = Create<Packet> ();
+	  REN wireEncoding (ConstCast<nnn::REN> (ren_p));
+	  packet->AddHeader (wireEncoding);
+	  ren_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::REN>
+    REN::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::REN> ren_p = Create<nnn::REN> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      REN wireEncoding (ren_p);
+      packet->RemoveHeader (wireEncoding);
+
+      ren_p->SetWire (wire);
+
+      return ren_p;
+    }
+
+    Ptr<nnn::REN>
+    REN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::REN> ren_p = Create<nnn::REN> ();
+
+      REN wireEncoding (ren_p);
+      wire->PeekHeader (wireEncoding);
+
+      ren_p->SetWire (wire);
+
+      return ren_p;
+    }
+
+    uint32_t
+    REN::GetSerializedSize (void) const
+    {
+      uint64_t lease = static_cast<uint64_t> (m_ptr->GetRemainLease ().ToInteger (Time::S));
+
+      size_t size =
+	  CommonGetSerializedSize () +                           /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetNumPoa ()) +  /* Number of PoAs */
+	  m_ptr->GetPoaSerializedSize () +                       /* Total size of PoAs */
+	  Compact::SerializedSizeVarint (lease) +                /* Lease time */
+	  Compact::SerializedSizeName (m_ptr->GetName ())        /* Name size */
+	  ;
+      return size;
+    }
+
+    void
+    REN::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PoAs
+      Compact::SerializeVarint (start, m_ptr->GetNumPoa ());
+      for (uint32_t i = 0; i < m_ptr->GetNumPoa (); i++)
+	Compact::SerializeAddress (start, m_ptr->GetOnePoa (i));
+
+      // Serialize the lease time
+      int64_t lease = m_ptr->GetRemainLease ().ToInteger (Time::S);
+      NS_ASSERT_MSG (0 <= lease, "Incorrect Lease time (should not be smaller than 0)");
+      Compact::SerializeVarint (start, static_cast<uint64_t> (lease));
+
+      // Serialize the name
+      Compact::SerializeName (start, m_ptr->GetName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    REN::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::REN_NNN)
+	throw new RENException ();
+
+      // Deserialize the PoAs
+      uint64_t totalpoas = Compact::DeserializeVarint (i);
+      for (uint64_t k = 0; k < totalpoas; k++)
+	m_ptr->AddPoa (Compact::DeserializeAddress (i));
+
+      // Deserialize the lease time
+      m_ptr->SetRemainLease (Seconds (Compact::DeserializeVarint (i)));
+
+      // Deserialize the name
+      m_ptr->SetName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  compact-so.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  compact-so.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with compact-so.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compact-so.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace compact {
+
+    NS_OBJECT_ENSURE_REGISTERED (SO);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.compact.SO");
+
+    SO::SO ()
+    : CommonHeader<nnn::SO> ()
+    {
+    }
+
+    SO::SO (Ptr<nnn::SO> so_p)
+    : CommonHeader<nnn::SO> (so_p)
+    {
+    }
+
+    TypeId
+    SO::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::SO::Compact")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<SO> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    SO::GetInstanceTypeId (void) const
+    {
+      return GetTypeId ();
+    }
+
+    Ptr<Packet>
+    SO::ToWire (Ptr<const nnn::SO> so_p)
+    {
+      Ptr<const Packet> p = CachedWire (so_p);
+      if (!p)
+	{
+	  Ptr<Packet> packet = Create<Packet> (*so_p->GetPayload ());
+	  SO wireEncoding (ConstCast<nnn::SO> (so_p));
+	  packet->AddHeader (wireEncoding);
+	  so_p->SetWire (packet);
+
+	  p = packet;
+	}
+      return p->Copy ();
+    }
+
+    Ptr<nnn::SO>
+    SO::FromWire (Ptr<Packet> packet)
+    {
+      Ptr<nnn::SO> so_p = Create<nnn::SO> ();
+      Ptr<Packet> wire = packet->Copy ();
+
+      SO wireEncoding (so_p);
+      packet->RemoveHeader (wireEncoding);
+
+      so_p->SetPayload (packet);
+      so_p->SetWire (wire);
+
+      return so_p;
+    }
+
+    Ptr<nnn::SO>
+    SO::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::SO> so_p = Create<nnn::SO> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      SO wireEncoding (so_p);
+      packet->RemoveHeader (wireEncoding);
+
+      so_p->SetPayload (packet);
+      so_p->SetWire (wire);
+
+      return so_p;
+    }
+
+    uint32_t
+    SO::GetSerializedSize (void) const
+    {
+      size_t size =
+	  CommonGetSerializedSize () +                                   /* Common header */
+	  Compact::SerializedSizeVarint (m_ptr->GetPDUPayloadType ()) +  /* PDU Data type */
+	  Compact::SerializedSizeName (m_ptr->GetName ())                /* Name size */
+	  ;
+      return size;
+    }
+
+    void
+    SO::Serialize (Buffer::Iterator start) const
+    {
+      // Serialize the header
+      CommonSerialize (start);
+
+      // Serialize the PDU Data type
+      Compact::SerializeVarint (start, m_ptr->GetPDUPayloadType ());
+
+      // Serialize the name
+      Compact::SerializeName (start, m_ptr->GetName ());
+
+      NS_LOG_INFO ("Finished serialization");
+    }
+
+    uint32_t
+    SO::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      // Deserialize the header, checking the packet ID
+      if (CommonDeserialize (i) != nnn::SO_NNN)
+	throw new SOException ();
+
+      // Deserialize the PDU Data type
+      m_ptr->SetPDUPayloadType (static_cast<uint16_t> (Compact::DeserializeVarint (i)));
+
+      // Deserialize the name
+      m_ptr->SetName (Compact::DeserializeName (i));
+
+      NS_ASSERT (GetSerializedSize () == (i.GetDistanceFrom (start)));
+
+      return i.GetDistanceFrom (start);
+    }
+  }
+}
+
+NNN_NAMESPACE_END
@@ -23,8 +23,10 @@
 
 #include "../../helper/nnn-header-helper.h"
 #include "nnnsim/nnnsim.h"
+#include "compact/compact.h"
 #include "nnn-wire.h"
 #include "wire-nnnsim.h"
+#include "wire-compact.h"
 
 NNN_NAMESPACE_BEGIN
 
@@ -32,7 +34,7 @@ static
 GlobalValue g_wireFormat ("nnn::WireFormat",
                           "Default wire format for nnnSIM.  nnnSIM will be accepting packets "
                           "in any supported packet formats, but if encoding requested, it will "
-                          "use default wire format to encode (0 for nnnSIM (default))",
+                          "use default wire format to encode (0 for nnnSIM (default), 1 for compact)",
                           IntegerValue (Wire::WIRE_FORMAT_NNNSIM),
                           MakeIntegerChecker<int32_t> ());
 
@@ -50,6 +52,74 @@ GetWireFormat ()
   return format;
 }
 
+WirePDU
+Wire::ToPDU (Ptr<const Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
+{
+  if (wireFormat == WIRE_FORMAT_AUTODETECT)
+    wireFormat = HeaderHelper::GetWireFormat (packet);
+
+  NNN_PDU_TYPE type = HeaderHelper::GetNNNHeaderType (packet);
+  if (wireFormat == WIRE_FORMAT_NNNSIM)
+    {
+      switch (type)
+      {
+	case nnn::NULL_NNN:
+	  return WirePDU (type, wire::nnnSIM::NULLp::FromWire (packet));
+	case nnn::SO_NNN:
+	  return WirePDU (type, wire::nnnSIM::SO::FromWire (packet));
+	case nnn::DO_NNN:
+	  return WirePDU (type, wire::nnnSIM::DO::FromWire (packet));
+	case nnn::DU_NNN:
+	  return WirePDU (type, wire::nnnSIM::DU::FromWire (packet));
+	case nnn::EN_NNN:
+	  return WirePDU (type, wire::nnnSIM::EN::FromWire (packet));
+	case nnn::OEN_NNN:
+	  return WirePDU (type, wire::nnnSIM::OEN::FromWire (packet));
+	case nnn::AEN_NNN:
+	  return WirePDU (type, wire::nnnSIM::AEN::FromWire (packet));
+	case nnn::REN_NNN:
+	  return WirePDU (type, wire::nnnSIM::REN::FromWire (packet));
+	case nnn::DEN_NNN:
+	  return WirePDU (type, wire::nnnSIM::DEN::FromWire (packet));
+	case nnn::INF_NNN:
+	  return WirePDU (type, wire::nnnSIM::INF::FromWire (packet));
+      }
+    }
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    {
+      switch (type)
+      {
+	case nnn::NULL_NNN:
+	  return WirePDU (type, wire::compact::NULLp::FromWire (packet));
+	case nnn::SO_NNN:
+	  return WirePDU (type, wire::compact::SO::FromWire (packet));
+	case nnn::DO_NNN:
+	  return WirePDU (type, wire::compact::DO::FromWire (packet));
+	case nnn::DU_NNN:
+	  return WirePDU (type, wire::compact::DU::FromWire (packet));
+	case nnn::EN_NNN:
+	  return WirePDU (type, wire::compact::EN::FromWire (packet));
+	case nnn::OEN_NNN:
+	  return WirePDU (type, wire::compact::OEN::FromWire (packet));
+	case nnn::AEN_NNN:
+	  return WirePDU (type, wire::compact::AEN::FromWire (packet));
+	case nnn::REN_NNN:
+	  return WirePDU (type, wire::compact::REN::FromWire (packet));
+	case nnn::DEN_NNN:
+	  return WirePDU (type, wire::compact::DEN::FromWire (packet));
+	case nnn::INF_NNN:
+	  return WirePDU (type, wire::compact::INF::FromWire (packet));
+      }
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unsupported format requested");
+      return WirePDU ();
+    }
+
+  throw UnknownHeaderException ();
+}
+
 Ptr<Packet>
 Wire::FromNULLp (Ptr<const NULLp> n_o, int8_t wireFormat)
 {
@@ -58,6 +128,8 @@ Wire::FromNULLp (Ptr<const NULLp> n_o, int8_t wireFormat)
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::NULLp::ToWire (n_o);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::NULLp::ToWire (n_o);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -77,7 +149,7 @@ Wire::ToNULLp (Ptr<Packet> packet, int8_t wireFormat)
 	  {
 	    case nnn::NULL_NNN:
 	      {
-		return wire::nnnSIM::NULLp::FromWire (packet);
+		return ToNULLp (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -96,6 +168,8 @@ Wire::ToNULLp (Ptr<Packet> packet, int8_t wireFormat)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::NULLp::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::NULLp::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -112,6 +186,8 @@ Wire::FromSO (Ptr<const SO> so_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::SO::ToWire (so_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::SO::ToWire (so_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -131,7 +207,7 @@ Wire::ToSO (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::SO_NNN:
 	      {
-		return wire::nnnSIM::SO::FromWire (packet);
+		return ToSO (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -150,6 +226,8 @@ Wire::ToSO (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::SO::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::SO::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -166,6 +244,8 @@ Wire::FromDO (Ptr<const DO> do_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::DO::ToWire (do_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::DO::ToWire (do_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -185,7 +265,7 @@ Wire::ToDO (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::DO_NNN:
 	      {
-		return wire::nnnSIM::DO::FromWire (packet);
+		return ToDO (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -204,6 +284,8 @@ Wire::ToDO (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::DO::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::DO::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -212,6 +294,34 @@ Wire::ToDO (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     }
 }
 
+Ptr<DO>
+Wire::RedirectDO (Ptr<const DO> do_p, const NNNAddress &name, Time lifetime, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
+{
+  if (wireFormat == WIRE_FORMAT_DEFAULT)
+    wireFormat = GetWireFormat ();
+
+  Ptr<DO> redirect = Create<DO> ();
+  redirect->SetVersion (do_p->GetVersion ());
+  redirect->SetLifetime (lifetime);
+  redirect->SetName (name);
+  redirect->SetPDUPayloadType (do_p->GetPDUPayloadType ());
+  redirect->SetPayload (do_p->GetPayload ());
+
+  // The rewrite sets the lifetime, so an outdated one does not matter
+  Ptr<const Packet> wire = do_p->GetWire ();
+  if (wire == 0)
+    wire = do_p->GetStaleWire ();
+  if (wire != 0 && wireFormat == WIRE_FORMAT_NNNSIM
+      && HeaderHelper::GetWireFormat (wire) == WIRE_FORMAT_NNNSIM)
+    {
+      Ptr<Packet> packet = wire->Copy ();
+      wire::nnnSIM::DO::Rewrite (packet, name, lifetime);
+      redirect->SetWire (packet);
+    }
+
+  return redirect;
+}
+
 Ptr<Packet>
 Wire::FromEN (Ptr<const EN> en_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 {
@@ -220,6 +330,8 @@ Wire::FromEN (Ptr<const EN> en_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::EN::ToWire (en_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::EN::ToWire (en_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -239,7 +351,7 @@ Wire::ToEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::EN_NNN:
 	      {
-		return wire::nnnSIM::EN::FromWire (packet);
+		return ToEN (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -258,6 +370,8 @@ Wire::ToEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::EN::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::EN::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -274,6 +388,8 @@ Wire::FromAEN (Ptr<const AEN> aen_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::AEN::ToWire (aen_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::AEN::ToWire (aen_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -293,7 +409,7 @@ Wire::ToAEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::AEN_NNN:
 	      {
-		return wire::nnnSIM::AEN::FromWire (packet);
+		return ToAEN (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -312,6 +428,8 @@ Wire::ToAEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::AEN::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::AEN::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -328,6 +446,8 @@ Wire::FromREN (Ptr<const REN> ren_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::REN::ToWire (ren_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::REN::ToWire (ren_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -347,7 +467,7 @@ Wire::ToREN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::REN_NNN:
 	      {
-		return wire::nnnSIM::REN::FromWire (packet);
+		return ToREN (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -366,6 +486,8 @@ Wire::ToREN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::REN::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::REN::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -382,6 +504,8 @@ Wire::FromDEN (Ptr<const DEN> ren_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::DEN::ToWire (ren_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::DEN::ToWire (ren_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -401,7 +525,7 @@ Wire::ToDEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::DEN_NNN:
 	      {
-		return wire::nnnSIM::DEN::FromWire (packet);
+		return ToDEN (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -420,6 +544,8 @@ Wire::ToDEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::DEN::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::DEN::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -436,6 +562,8 @@ Wire::FromINF (Ptr<const INF> inf_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::INF::ToWire (inf_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::INF::ToWire (inf_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -455,7 +583,7 @@ Wire::ToINF (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::INF_NNN:
 	      {
-		return wire::nnnSIM::INF::FromWire (packet);
+		return ToINF (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -474,6 +602,8 @@ Wire::ToINF (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::INF::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::INF::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -490,6 +620,8 @@ Wire::FromDU (Ptr<const DU> du_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::DU::ToWire (du_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::DU::ToWire (du_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -509,7 +641,7 @@ Wire::ToDU (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::DU_NNN:
 	      {
-		return wire::nnnSIM::DU::FromWire (packet);
+		return ToDU (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -528,6 +660,8 @@ Wire::ToDU (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::DU::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::DU::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -536,6 +670,35 @@ Wire::ToDU (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     }
 }
 
+Ptr<DU>
+Wire::RedirectDU (Ptr<const DU> du_p, const NNNAddress &dst, Time lifetime, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
+{
+  if (wireFormat == WIRE_FORMAT_DEFAULT)
+    wireFormat = GetWireFormat ();
+
+  Ptr<DU> redirect = Create<DU> ();
+  redirect->SetVersion (du_p->GetVersion ());
+  redirect->SetLifetime (lifetime);
+  redirect->SetSrcName (du_p->GetSrcName ());
+  redirect->SetDstName (dst);
+  redirect->SetPDUPayloadType (du_p->GetPDUPayloadType ());
+  redirect->SetPayload (du_p->GetPayload ());
+
+  // The rewrite sets the lifetime, so an outdated one does not matter
+  Ptr<const Packet> wire = du_p->GetWire ();
+  if (wire == 0)
+    wire = du_p->GetStaleWire ();
+  if (wire != 0 && wireFormat == WIRE_FORMAT_NNNSIM
+      && HeaderHelper::GetWireFormat (wire) == WIRE_FORMAT_NNNSIM)
+    {
+      Ptr<Packet> packet = wire->Copy ();
+      wire::nnnSIM::DU::Rewrite (packet, dst, lifetime);
+      redirect->SetWire (packet);
+    }
+
+  return redirect;
+}
+
 Ptr<Packet>
 Wire::FromOEN (Ptr<const OEN> oen_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
 {
@@ -544,6 +707,8 @@ Wire::FromOEN (Ptr<const OEN> oen_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
     return wire::nnnSIM::OEN::ToWire (oen_p);
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    return wire::compact::OEN::ToWire (oen_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -563,7 +728,7 @@ Wire::ToOEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
 	  {
 	    case nnn::OEN_NNN:
 	      {
-		return wire::nnnSIM::OEN::FromWire (packet);
+		return ToOEN (packet, HeaderHelper::GetWireFormat (packet));
 	      }
 	    default:
 	      NS_FATAL_ERROR ("Unsupported format");
@@ -582,6 +747,8 @@ Wire::ToOEN (Ptr<Packet> packet, int8_t wireFormat/* = WIRE_FORMAT_AUTODETECT*/)
     {
       if (wireFormat == WIRE_FORMAT_NNNSIM)
 	return wire::nnnSIM::OEN::FromWire (packet);
+      else if (wireFormat == WIRE_FORMAT_COMPACT)
+	return wire::compact::OEN::FromWire (packet);
       else
 	{
 	  NS_FATAL_ERROR ("Unsupported format requested");
@@ -775,6 +942,20 @@ Wire::FromName (Ptr<const NNNAddress> name, int8_t wireFormat/* = WIRE_FORMAT_DE
       wire.resize (buf.GetSize ());
       buf.CopyData (reinterpret_cast<uint8_t *>(&wire[0]), wire.size ());
 
+      return wire;
+    }
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    {
+      Buffer buf;
+      buf.AddAtStart (wire::Compact::SerializedSizeName (*name));
+      Buffer::Iterator i = buf.Begin ();
+
+      wire::Compact::SerializeName (i, *name);
+
+      std::string wire;
+      wire.resize (buf.GetSize ());
+      buf.CopyData (reinterpret_cast<uint8_t *>(&wire[0]), wire.size ());
+
       return wire;
     }
   else
@@ -801,6 +982,10 @@ Wire::ToName (const std::string &name, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT
     {
       return wire::NnnSim::DeserializeName (i);
     }
+  else if (wireFormat == WIRE_FORMAT_COMPACT)
+    {
+      return wire::Compact::DeserializeName (i);
+    }
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
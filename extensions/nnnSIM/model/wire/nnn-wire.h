@@ -29,15 +29,73 @@
 
 NNN_NAMESPACE_BEGIN
 
+/**
+ * @brief PDU returned by Wire::ToPDU, tagged with its type
+ */
+class WirePDU
+{
+public:
+  WirePDU ()
+  : m_type (NULL_NNN)
+  {
+  }
+
+  WirePDU (NNN_PDU_TYPE type, Ptr<NNNPDU> pdu)
+  : m_type (type)
+  , m_pdu (pdu)
+  {
+  }
+
+  NNN_PDU_TYPE
+  GetType () const
+  {
+    return m_type;
+  }
+
+  Ptr<NNNPDU>
+  GetPDU () const
+  {
+    return m_pdu;
+  }
+
+  /**
+   * @brief The PDU as T, which must be the class matching GetType
+   *
+   * The type was fixed when decoding, so no run time check is done
+   */
+  template<class T> Ptr<T>
+  Get () const
+  {
+    return StaticCast<T> (m_pdu);
+  }
+
+private:
+  NNN_PDU_TYPE m_type;
+  Ptr<NNNPDU> m_pdu;
+};
+
 struct Wire
 {
   enum
   {
     WIRE_FORMAT_DEFAULT = -2,
     WIRE_FORMAT_AUTODETECT = -1,
-    WIRE_FORMAT_NNNSIM = 0
+    WIRE_FORMAT_NNNSIM = 0,
+    WIRE_FORMAT_COMPACT = 1
   };
 
+  /**
+   * @brief Classify and decode packet in a single pass
+   *
+   * With WIRE_FORMAT_AUTODETECT, the format is found out with
+   * HeaderHelper::GetWireFormat.
+   * packet is not modified and becomes the cached wire format of the
+   * returned PDU, only the payload of data PDUs is copied out of it.
+   * Throws UnknownHeaderException if the PDU type is not recognized
+   */
+  static WirePDU
+  ToPDU (Ptr<const Packet> packet, int8_t type = WIRE_FORMAT_AUTODETECT);
+
   static Ptr<Packet>
   FromNULLp (Ptr<const NULLp> n_o, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
 
@@ -56,6 +114,15 @@ struct Wire
   static Ptr<DO>
   ToDO (Ptr<Packet> packet, int8_t type = WIRE_FORMAT_AUTODETECT);
 
+  /**
+   * @brief Copy of do_p headed to name with a new lifetime
+   *
+   * When do_p holds its wire encoding in nnnSIM format, the encoding of
+   * the copy is patched from it instead of serializing the whole PDU again
+   */
+  static Ptr<DO>
+  RedirectDO (Ptr<const DO> do_p, const NNNAddress &name, Time lifetime, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
+
   static Ptr<Packet>
   FromEN (Ptr<const EN> n_o, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
 
@@ -92,6 +159,15 @@ struct Wire
   static Ptr<DU>
   ToDU (Ptr<Packet> packet, int8_t type = WIRE_FORMAT_AUTODETECT);
 
+  /**
+   * @brief Copy of du_p headed to dst with a new lifetime
+   *
+   * When du_p holds its wire encoding in nnnSIM format, the encoding of
+   * the copy is patched from it instead of serializing the whole PDU again
+   */
+  static Ptr<DU>
+  RedirectDU (Ptr<const DU> du_p, const NNNAddress &dst, Time lifetime, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
+
   static Ptr<Packet>
   FromOEN (Ptr<const OEN> du_o, int8_t wireFormat = WIRE_FORMAT_DEFAULT);
 
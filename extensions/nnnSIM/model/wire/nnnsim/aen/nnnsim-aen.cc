@@ -58,7 +58,7 @@ namespace wire {
     Ptr<Packet>
     AEN::ToWire (Ptr<const nnn::AEN> aen_p)
     {
-      Ptr<const Packet> p = aen_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (aen_p, GetTypeId ());
       if (!p)
 	{
 	  // Mechanism packets have no payload, make an empty packet
@@ -87,18 +87,24 @@ namespace wire {
       return aen_p;
     }
 
+    Ptr<nnn::AEN>
+    AEN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::AEN> aen_p = Create<nnn::AEN> ();
+
+      AEN wireEncoding (aen_p);
+      wire->PeekHeader (wireEncoding);
+
+      aen_p->SetWire (wire);
+
+      return aen_p;
+    }
+
     uint32_t
     AEN::GetSerializedSize (void) const
     {
-      size_t poatype_size = 0;
-      size_t poa_num = 0;
-
-      poa_num = m_ptr->GetNumPoa ();
-      // Get the serialized size from the Address class
-      for (int i = 0; i < poa_num; i++)
-	{
-	  poatype_size += m_ptr->GetOnePoa (i).GetSerializedSize ();
-	}
+      // The PDU keeps the size of its PoAs up to date
+      size_t poatype_size = m_ptr->GetPoaSerializedSize ();
 
       size_t size =
 	  CommonGetSerializedSize () +                    /* Common header */
@@ -113,6 +119,8 @@ namespace wire {
     void
     AEN::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -123,10 +131,9 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize packet length
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       uint32_t totalpoas = m_ptr->GetNumPoa();
 
@@ -169,6 +176,7 @@ namespace wire {
 
       // Serialize NNN address
       NnnSim::SerializeName(start, m_ptr->GetName());
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
@@ -58,7 +58,7 @@ namespace wire{
     Ptr<Packet>
     DEN::ToWire(Ptr<const nnn::DEN> den_p)
     {
-      Ptr<const Packet> p = den_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (den_p, GetTypeId ());
       if (!p)
 	{
 	  // Mechanism packets have no payload, make an empty packet
@@ -87,18 +87,24 @@ namespace wire{
       return den_p;
     }
 
+    Ptr<nnn::DEN>
+    DEN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DEN> den_p = Create<nnn::DEN> ();
+
+      DEN wireEncoding (den_p);
+      wire->PeekHeader (wireEncoding);
+
+      den_p->SetWire (wire);
+
+      return den_p;
+    }
+
     uint32_t
     DEN::GetSerializedSize(void) const
     {
-      size_t poatype_size = 0;
-      size_t poa_num = 0;
-
-      poa_num = m_ptr->GetNumPoa ();
-      // Get the serialized size from the Address class
-      for (int i = 0; i < poa_num; i++)
-	{
-	  poatype_size += m_ptr->GetOnePoa (i).GetSerializedSize();
-	}
+      // The PDU keeps the size of its PoAs up to date
+      size_t poatype_size = m_ptr->GetPoaSerializedSize ();
 
       size_t size = CommonGetSerializedSize() +         /* Common header */
 	  2 +                                           /* Number of PoAs */
@@ -110,6 +116,8 @@ namespace wire{
     void
     DEN::Serialize(Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -120,10 +128,9 @@ namespace wire{
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       // Create a buffer to be able to serialize PoAs
       uint32_t totalpoas = m_ptr->GetNumPoa();
@@ -158,6 +165,7 @@ namespace wire{
       // Serialize NNN address
       NnnSim::SerializeName(start, m_ptr->GetName());
 
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
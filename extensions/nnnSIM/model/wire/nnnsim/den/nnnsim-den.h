@@ -44,6 +44,13 @@ namespace wire {
       static Ptr<nnn::DEN>
       FromWire (Ptr<Packet> packet);
 
+      /**
+       * @brief Decode wire without modifying it, wire is kept as the
+       * cached wire format of the PDU
+       */
+      static Ptr<nnn::DEN>
+      FromWire (Ptr<const Packet> wire);
+
       // from Header
       static TypeId GetTypeId (void);
       TypeId GetInstanceTypeId (void) const;
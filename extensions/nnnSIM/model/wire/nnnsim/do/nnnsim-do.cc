@@ -58,7 +58,7 @@ namespace wire {
     Ptr<Packet>
     DO::ToWire (Ptr<const nnn::DO> do_p)
     {
-      Ptr<const Packet> p = do_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (do_p, GetTypeId ());
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*do_p->GetPayload ());
@@ -86,6 +86,28 @@ namespace wire {
       return do_p;
     }
 
+    Ptr<nnn::DO>
+    DO::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DO> do_p = Create<nnn::DO> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      DO wireEncoding (do_p);
+      packet->RemoveHeader (wireEncoding);
+
+      do_p->SetPayload (packet);
+      do_p->SetWire (wire);
+
+      return do_p;
+    }
+
+    void
+    DO::Rewrite (Ptr<Packet> packet, const NNNAddress &name, Time lifetime)
+    {
+      RewriteHeader::Rewrite (packet, 0, DO::GetTypeId (), name, lifetime);
+    }
+
     uint32_t
     DO::GetSerializedSize (void) const
     {
@@ -100,6 +122,8 @@ namespace wire {
     void
     DO::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -110,10 +134,9 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       // Serialize the PDU Data type
       start.WriteU16(m_ptr->GetPDUPayloadType());
@@ -121,6 +144,7 @@ namespace wire {
       // Serialize
       NnnSim::SerializeName(start, m_ptr->GetName());
 
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
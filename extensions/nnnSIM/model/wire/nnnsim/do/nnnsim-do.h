@@ -18,6 +18,7 @@
  */
 #include "../nnnsim-common-hdr.h"
 #include "../nnnsim-common.h"
+#include "../rewrite/nnnsim-rewrite.h"
 NNN_NAMESPACE_BEGIN
 /**
  * @brief Namespace encapsulating wire operations
@@ -44,6 +45,22 @@ namespace wire {
       static Ptr<nnn::DO>
       FromWire (Ptr<Packet> packet);
 
+      /**
+       * @brief Decode wire without modifying it, wire is kept as the
+       * cached wire format of the PDU
+       */
+      static Ptr<nnn::DO>
+      FromWire (Ptr<const Packet> wire);
+
+      /**
+       * @brief Rewrite the lifetime and name of a serialized DO in place
+       *
+       * Only the header fields and length are rewritten, the payload is
+       * neither decoded nor copied
+       */
+      static void
+      Rewrite (Ptr<Packet> packet, const NNNAddress &name, Time lifetime);
+
       // from Header
       static TypeId GetTypeId (void);
       TypeId GetInstanceTypeId (void) const;
@@ -59,7 +59,7 @@ namespace wire
     Ptr<Packet>
     DU::ToWire (Ptr<const nnn::DU> du_p)
     {
-      Ptr<const Packet> p = du_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (du_p, GetTypeId ());
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*du_p->GetPayload ());
@@ -87,6 +87,28 @@ namespace wire
       return du_p;
     }
 
+    Ptr<nnn::DU>
+    DU::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::DU> du_p = Create<nnn::DU> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      DU wireEncoding (du_p);
+      packet->RemoveHeader (wireEncoding);
+
+      du_p->SetPayload (packet);
+      du_p->SetWire (wire);
+
+      return du_p;
+    }
+
+    void
+    DU::Rewrite (Ptr<Packet> packet, const NNNAddress &dst, Time lifetime)
+    {
+      RewriteHeader::Rewrite (packet, 1, DU::GetTypeId (), dst, lifetime);
+    }
+
     uint32_t
     DU::GetSerializedSize (void) const
     {
@@ -102,6 +124,8 @@ namespace wire
     void
     DU::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -112,10 +136,9 @@ namespace wire
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       // Serialize the PDU Data type
       start.WriteU16(m_ptr->GetPDUPayloadType());
@@ -126,6 +149,7 @@ namespace wire
       // Serialize the destination name
       NnnSim::SerializeName(start, m_ptr->GetDstName());
 
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
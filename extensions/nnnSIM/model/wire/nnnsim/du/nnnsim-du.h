@@ -22,6 +22,7 @@
 
 #include "../nnnsim-common-hdr.h"
 #include "../nnnsim-common.h"
+#include "../rewrite/nnnsim-rewrite.h"
 
 NNN_NAMESPACE_BEGIN
 
@@ -42,6 +43,22 @@ namespace wire
       static Ptr<nnn::DU>
       FromWire (Ptr<Packet> packet);
 
+      /**
+       * @brief Decode wire without modifying it, wire is kept as the
+       * cached wire format of the PDU
+       */
+      static Ptr<nnn::DU>
+      FromWire (Ptr<const Packet> wire);
+
+      /**
+       * @brief Rewrite the lifetime and destination name of a serialized DU in place
+       *
+       * Only the header fields and length are rewritten, the payload is
+       * neither decoded nor copied
+       */
+      static void
+      Rewrite (Ptr<Packet> packet, const NNNAddress &dst, Time lifetime);
+
       // from Header
       static TypeId GetTypeId (void);
       TypeId GetInstanceTypeId (void) const;
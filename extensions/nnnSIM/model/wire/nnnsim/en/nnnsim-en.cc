@@ -58,7 +58,7 @@ namespace wire {
     Ptr<Packet>
     EN::ToWire (Ptr<const nnn::EN> en_p)
     {
-      Ptr<const Packet> p = en_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (en_p, GetTypeId ());
       if (!p)
 	{
 	  // Mechanism packets have no payload, make an empty packet
@@ -87,18 +87,24 @@ namespace wire {
       return en_p;
     }
 
+    Ptr<nnn::EN>
+    EN::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::EN> en_p = Create<nnn::EN> ();
+
+      EN wireEncoding (en_p);
+      wire->PeekHeader (wireEncoding);
+
+      en_p->SetWire (wire);
+
+      return en_p;
+    }
+
     uint32_t
     EN::GetSerializedSize (void) const
     {
-      size_t poatype_size = 0;
-      size_t poa_num = 0;
-
-      poa_num = m_ptr->GetNumPoa ();
-      // Get the serialized size from the Address class
-      for (int i = 0; i < poa_num; i++)
-	{
-	  poatype_size += m_ptr->GetOnePoa (i).GetSerializedSize ();
-	}
+      // The PDU keeps the size of its PoAs up to date
+      size_t poatype_size = m_ptr->GetPoaSerializedSize ();
 
       size_t size =
 	  CommonGetSerializedSize() +         /* Common header */
@@ -111,6 +117,8 @@ namespace wire {
     void
     EN::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -121,10 +129,9 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       uint32_t totalpoas = m_ptr->GetNumPoa();
 
@@ -154,6 +161,7 @@ namespace wire {
 	  for (int j = 0; j < serialSize; j++)
 	    start.WriteU8 (buffer[j]);
 	}
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
@@ -58,7 +58,7 @@ namespace wire {
     Ptr<Packet>
     INF::ToWire (Ptr<const nnn::INF> inf_p)
     {
-      Ptr<const Packet> p = inf_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (inf_p, GetTypeId ());
       if (!p)
 	{
 	  // Mechanism packets have no payload, make an empty packet
@@ -87,6 +87,19 @@ namespace wire {
       return inf_p;
     }
 
+    Ptr<nnn::INF>
+    INF::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::INF> inf_p = Create<nnn::INF> ();
+
+      INF wireEncoding (inf_p);
+      wire->PeekHeader (wireEncoding);
+
+      inf_p->SetWire (wire);
+
+      return inf_p;
+    }
+
     uint32_t
     INF::GetSerializedSize (void) const
     {
@@ -101,6 +114,8 @@ namespace wire {
     void
     INF::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -111,10 +126,9 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       uint64_t lease = static_cast<uint64_t> (m_ptr->GetRemainLease ().ToInteger (Time::S));
 
@@ -130,6 +144,7 @@ namespace wire {
 
       // Serialize NNN address
       NnnSim::SerializeName(start, m_ptr->GetNewName());
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
@@ -19,6 +19,9 @@
 #include <ns3-dev/ns3/ptr.h>
 
 #include "nnnsim-common.h"
+#include "rewrite/nnnsim-rewrite.h"
+#include "../nnn-wire.h"
+#include "../../../helper/nnn-header-helper.h"
 
 #ifndef NNNSIM_COMMON_HDR_H_
 #define NNNSIM_COMMON_HDR_H_
@@ -90,6 +93,47 @@ namespace ns3
 	    // return because everything else is Header specific
 	  }
 
+	  /**
+	   * @brief Write the Packet Length of the PDU serialized between
+	   * start and end
+	   *
+	   * Serialize writes a placeholder and patches the length once all
+	   * the variable parts are written, instead of sizing the PDU again
+	   */
+	  void
+	  CommonPatchLength (Buffer::Iterator start, Buffer::Iterator end) const
+	  {
+	    uint32_t length = end.GetDistanceFrom (start);
+	    start.Next (CommonGetSerializedSize () - 2);
+	    start.WriteU16 (static_cast<uint16_t> (length));
+	  }
+
+	  /**
+	   * @brief Cached wire format of t_p, 0 if it has to be encoded
+	   *
+	   * If only the lifetime of t_p changed since it was encoded, the
+	   * lifetime is patched into a copy of the cached packet. Wires
+	   * cached in another format are ignored
+	   */
+	  static Ptr<const Packet>
+	  CachedWire (Ptr<const T> t_p, TypeId tid)
+	  {
+	    Ptr<const Packet> wire = t_p->GetWire ();
+	    if (wire != 0 && HeaderHelper::GetWireFormat (wire) != Wire::WIRE_FORMAT_NNNSIM)
+	      return 0;
+
+	    if (wire == 0 && t_p->GetStaleWire () != 0
+		&& HeaderHelper::GetWireFormat (t_p->GetStaleWire ()) == Wire::WIRE_FORMAT_NNNSIM)
+	      {
+		Ptr<Packet> packet = t_p->GetStaleWire ()->Copy ();
+		RewriteHeader::RewriteLifetime (packet, tid, t_p->GetLifetime ());
+		t_p->SetWire (packet);
+
+		wire = packet;
+	      }
+	    return wire;
+	  }
+
 	  uint32_t
 	  CommonDeserialize (Buffer::Iterator start)
 	  {
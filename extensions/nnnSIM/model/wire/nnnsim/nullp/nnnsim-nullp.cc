@@ -58,7 +58,7 @@ namespace wire {
     Ptr<Packet>
     NULLp::ToWire (Ptr<const nnn::NULLp> null_p)
     {
-      Ptr<const Packet> p = null_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (null_p, GetTypeId ());
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*null_p->GetPayload ());
@@ -87,6 +87,22 @@ namespace wire {
       return null_p;
     }
 
+    Ptr<nnn::NULLp>
+    NULLp::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::NULLp> null_p = Create<nnn::NULLp> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      NULLp wireEncoding (null_p);
+      packet->RemoveHeader (wireEncoding);
+
+      null_p->SetPayload (packet);
+      null_p->SetWire (wire);
+
+      return null_p;
+    }
+
     uint32_t
     NULLp::GetSerializedSize (void) const
     {
@@ -101,6 +117,8 @@ namespace wire {
     void
     NULLp::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -111,14 +129,14 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       // Serialize the PDU Data type
       start.WriteU16(m_ptr->GetPDUPayloadType());
 
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
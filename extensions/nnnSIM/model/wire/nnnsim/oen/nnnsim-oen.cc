@@ -61,7 +61,7 @@ namespace ns3
 	Ptr<Packet>
 	OEN::ToWire(Ptr<const nnn::OEN> oen_p)
 	{
-	  Ptr<const Packet> p = oen_p->GetWire ();
+	  Ptr<const Packet> p = CachedWire (oen_p, GetTypeId ());
 	  if (!p)
 	    {
 	      // Mechanism packets have no payload, make an empty packet
@@ -90,27 +90,25 @@ namespace ns3
 	  return oen_p;
 	}
 
+	Ptr<nnn::OEN>
+	OEN::FromWire (Ptr<const Packet> wire)
+	{
+	  Ptr<nnn::OEN> oen_p = Create<nnn::OEN> ();
+
+	  OEN wireEncoding (oen_p);
+	  wire->PeekHeader (wireEncoding);
+
+	  oen_p->SetWire (wire);
+
+	  return oen_p;
+	}
+
 	uint32_t
 	OEN::GetSerializedSize(void) const
 	{
-	  size_t poatype_size = 0;
-	  size_t poa_num = 0;
-	  size_t poa_num2 = 0;
-	  size_t poatype_size2 = 0;
-
-	  poa_num = m_ptr->GetNumPoa ();
-	  // Get the serialized size from the Address class
-	  for (int i = 0; i < poa_num; i++)
-	    {
-	      poatype_size += m_ptr->GetOnePoa (i).GetSerializedSize ();
-	    }
-
-	  poa_num2 = m_ptr->GetPersonalNumPoa ();
-	  // Get the serialized size from the Address class
-	  for (int i = 0; i < poa_num2; i++)
-	    {
-	      poatype_size += m_ptr->GetPersonalOnePoa (i).GetSerializedSize ();
-	    }
+	  // The PDU keeps the size of its PoAs up to date
+	  size_t poatype_size = m_ptr->GetPoaSerializedSize ();
+	  size_t poatype_size2 = m_ptr->GetPersonalPoaSerializedSize ();
 
 	  size_t size = CommonGetSerializedSize() +             /* Common header */
 	      2 +                                               /* Number of PoAs */
@@ -127,6 +125,8 @@ namespace ns3
 	void
 	OEN::Serialize(Buffer::Iterator start) const
 	{
+	  Buffer::Iterator begin = start;
+
 	  // Serialize the header
 	  CommonSerialize(start);
 
@@ -137,10 +137,9 @@ namespace ns3
 	  NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
 	  NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
 	  NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-	  NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-	  // Serialize the packet size
-	  start.WriteU16(GetSerializedSize());
+	  // Serialize the packet size, patched once everything is written
+	  start.WriteU16 (0);
 
 	  uint32_t totalpoas = m_ptr->GetNumPoa();
 
@@ -211,7 +210,8 @@ namespace ns3
 	  // Serialize NNN address
 	  NnnSim::SerializeName(start, m_ptr->GetSrcName());
 
-	  NS_LOG_INFO("Finished serialization wrote " << GetSerializedSize ());
+	  CommonPatchLength (begin, start);
+	  NS_LOG_INFO("Finished serialization");
 	}
 
 	uint32_t
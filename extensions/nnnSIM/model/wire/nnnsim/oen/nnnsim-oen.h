@@ -44,6 +44,13 @@ namespace ns3
 	  static Ptr<nnn::OEN>
 	  FromWire (Ptr<Packet> packet);
 
+	  /**
+	   * @brief Decode wire without modifying it, wire is kept as the
+	   * cached wire format of the PDU
+	   */
+	  static Ptr<nnn::OEN>
+	  FromWire (Ptr<const Packet> wire);
+
 	  // from Header
 	  static TypeId GetTypeId (void);
 	  TypeId GetInstanceTypeId (void) const;
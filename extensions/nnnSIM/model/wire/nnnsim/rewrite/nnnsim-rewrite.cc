@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2014 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnnsim-rewrite.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnnsim-rewrite.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnnsim-rewrite.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnnsim-rewrite.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace nnnSIM {
+
+    NS_OBJECT_ENSURE_REGISTERED (RewriteHeader);
+
+    NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM.RewriteHeader");
+
+    const uint32_t RewriteHeader::KeepAll;
+
+    RewriteHeader::RewriteHeader ()
+    : m_tid (GetTypeId ())
+    , m_keep (0)
+    , m_packetId (0)
+    , m_lifetime (0)
+    , m_version (0)
+    , m_pduType (0)
+    , m_name (0)
+    {
+    }
+
+    RewriteHeader::RewriteHeader (uint32_t keep, TypeId tid)
+    : m_tid (tid)
+    , m_keep (keep)
+    , m_packetId (0)
+    , m_lifetime (0)
+    , m_version (0)
+    , m_pduType (0)
+    , m_name (0)
+    {
+    }
+
+    TypeId
+    RewriteHeader::GetTypeId (void)
+    {
+      static TypeId tid = TypeId ("ns3::nnn::RewriteHeader::nnnSIM")
+	  .SetGroupName ("Nnn")
+	  .SetParent<Header> ()
+	  .AddConstructor<RewriteHeader> ()
+	  ;
+      return tid;
+    }
+
+    TypeId
+    RewriteHeader::GetInstanceTypeId (void) const
+    {
+      return m_tid;
+    }
+
+    void
+    RewriteHeader::SetName (const NNNAddress &name)
+    {
+      m_name = &name;
+    }
+
+    void
+    RewriteHeader::SetLifetime (Time lifetime)
+    {
+      NS_ASSERT_MSG (0 <= lifetime.ToInteger (Time::S) && lifetime.ToInteger (Time::S) < 65535,
+                     "Incorrect Lifetime (should not be smaller than 0 and larger than 65535");
+
+      m_lifetime = static_cast<uint16_t> (lifetime.ToInteger (Time::S));
+    }
+
+    void
+    RewriteHeader::Rewrite (Ptr<Packet> packet, uint32_t keep, TypeId tid, const NNNAddress &name, Time lifetime)
+    {
+      NS_LOG_FUNCTION (packet << keep << name << lifetime);
+
+      RewriteHeader header (keep, tid);
+
+      // Removing only parses the fixed fields, the payload stays shared
+      packet->RemoveHeader (header);
+
+      header.SetName (name);
+      header.SetLifetime (lifetime);
+
+      packet->AddHeader (header);
+    }
+
+    void
+    RewriteHeader::RewriteLifetime (Ptr<Packet> packet, TypeId tid, Time lifetime)
+    {
+      NS_LOG_FUNCTION (packet << lifetime);
+
+      RewriteHeader header (KeepAll, tid);
+
+      packet->RemoveHeader (header);
+      header.SetLifetime (lifetime);
+      packet->AddHeader (header);
+    }
+
+    uint32_t
+    RewriteHeader::GetSerializedSize (void) const
+    {
+      if (m_keep == KeepAll)
+	return (4 +                                    /* PacketId */
+	    2 +                                        /* TTL */
+	    2 +                                        /* Version */
+	    2 +                                        /* Packet Length */
+	    m_kept.size ()                             /* Rest of the header */
+	);
+
+      NS_ASSERT (m_name != 0);
+
+      return (4 +                                      /* PacketId */
+	  2 +                                          /* TTL */
+	  2 +                                          /* Version */
+	  2 +                                          /* Packet Length */
+	  2 +                                          /* PDU Data type */
+	  m_kept.size () +                             /* Names kept */
+	  NnnSim::SerializedSizeName (*m_name)         /* New name */
+      );
+    }
+
+    void
+    RewriteHeader::Serialize (Buffer::Iterator start) const
+    {
+      start.WriteU32 (m_packetId);
+      start.WriteU16 (m_lifetime);
+      start.WriteU16 (m_version);
+      start.WriteU16 (GetSerializedSize ());
+
+      if (m_keep != KeepAll)
+	start.WriteU16 (m_pduType);
+
+      if (!m_kept.empty ())
+	start.Write (&m_kept[0], m_kept.size ());
+
+      if (m_keep != KeepAll)
+	NnnSim::SerializeName (start, *m_name);
+    }
+
+    uint32_t
+    RewriteHeader::Deserialize (Buffer::Iterator start)
+    {
+      Buffer::Iterator i = start;
+
+      m_packetId = i.ReadU32 ();
+      m_lifetime = i.ReadU16 ();
+      m_version = i.ReadU16 ();
+      uint16_t length = i.ReadU16 ();
+
+      if (m_keep == KeepAll)
+	{
+	  m_kept.resize (length - i.GetDistanceFrom (start));
+	  if (!m_kept.empty ())
+	    i.Read (&m_kept[0], m_kept.size ());
+
+	  return i.GetDistanceFrom (start);
+	}
+
+      m_pduType = i.ReadU16 ();
+
+      // Copy the names which are not replaced, length field included
+      for (uint32_t k = 0; k < m_keep; k++)
+	{
+	  Buffer::Iterator peek = i;
+	  uint16_t nameLength = peek.ReadU16 ();
+	  size_t offset = m_kept.size ();
+
+	  m_kept.resize (offset + 2 + nameLength);
+	  i.Read (&m_kept[offset], 2 + nameLength);
+	}
+
+      // The replaced name is the last element of the header, skip it
+      i.Next (length - i.GetDistanceFrom (start));
+
+      return i.GetDistanceFrom (start);
+    }
+
+    void
+    RewriteHeader::Print (std::ostream &os) const
+    {
+      os << "<Rewrite>" << m_packetId << " " << m_lifetime << "</Rewrite>";
+    }
+
+  } /* namespace nnnSIM */
+} /* namespace wire */
+
+NNN_NAMESPACE_END
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2014 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnnsim-rewrite.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnnsim-rewrite.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnnsim-rewrite.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNNSIM_REWRITE_H_
+#define NNNSIM_REWRITE_H_
+
+#include <vector>
+
+#include "../nnnsim-common.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+  namespace nnnSIM {
+
+    /**
+     * @brief Header used to patch an already serialized 3N data PDU
+     *
+     * Reads the fixed fields of the header, keeps the first names as raw
+     * bytes and skips the last name without decoding it. Serializing
+     * writes back the fixed fields with the new lifetime and length,
+     * the raw names and the new last name.
+     *
+     * With KeepAll, everything after the common fields is kept as raw
+     * bytes and only the lifetime changes, which works for any 3N PDU.
+     */
+    class RewriteHeader : public Header
+    {
+    public:
+      /**
+       * @brief Keep the whole header, only the lifetime is rewritten
+       */
+      static const uint32_t KeepAll = ~0u;
+
+      RewriteHeader ();
+
+      /**
+       * @param keep number of names before the one being replaced
+       * @param tid TypeId of the header being rewritten, so that packet
+       *            metadata stays consistent
+       */
+      RewriteHeader (uint32_t keep, TypeId tid);
+
+      void
+      SetName (const NNNAddress &name);
+
+      void
+      SetLifetime (Time lifetime);
+
+      /**
+       * @brief Rewrite the lifetime and last name of the serialized PDU
+       * at the start of packet, leaving the payload untouched
+       */
+      static void
+      Rewrite (Ptr<Packet> packet, uint32_t keep, TypeId tid, const NNNAddress &name, Time lifetime);
+
+      /**
+       * @brief Rewrite only the lifetime of the serialized PDU at the start
+       * of packet
+       */
+      static void
+      RewriteLifetime (Ptr<Packet> packet, TypeId tid, Time lifetime);
+
+      // from Header
+      static TypeId GetTypeId (void);
+      TypeId GetInstanceTypeId (void) const;
+      uint32_t GetSerializedSize (void) const;
+      void Serialize (Buffer::Iterator start) const;
+      uint32_t Deserialize (Buffer::Iterator start);
+      void Print (std::ostream &os) const;
+
+    private:
+      TypeId m_tid;
+      uint32_t m_keep;
+      uint32_t m_packetId;
+      uint16_t m_lifetime;
+      uint16_t m_version;
+      uint16_t m_pduType;
+      std::vector<uint8_t> m_kept;   ///< @brief Serialized names kept as is
+      const NNNAddress *m_name;
+    };
+
+  } /* namespace nnnSIM */
+} /* namespace wire */
+
+NNN_NAMESPACE_END
+
+#endif /* NNNSIM_REWRITE_H_ */
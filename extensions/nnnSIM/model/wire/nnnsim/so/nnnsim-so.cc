@@ -41,7 +41,7 @@ namespace wire {
     Ptr<Packet>
     SO::ToWire (Ptr<const nnn::SO> so_p)
     {
-      Ptr<const Packet> p = so_p->GetWire ();
+      Ptr<const Packet> p = CachedWire (so_p, GetTypeId ());
       if (!p)
 	{
 	  Ptr<Packet> packet = Create<Packet> (*so_p->GetPayload ());
@@ -70,6 +70,22 @@ namespace wire {
       return so_p;
     }
 
+    Ptr<nnn::SO>
+    SO::FromWire (Ptr<const Packet> wire)
+    {
+      Ptr<nnn::SO> so_p = Create<nnn::SO> ();
+
+      // The payload shares the buffer of wire, which is left as it is
+      Ptr<Packet> packet = wire->Copy ();
+      SO wireEncoding (so_p);
+      packet->RemoveHeader (wireEncoding);
+
+      so_p->SetPayload (packet);
+      so_p->SetWire (wire);
+
+      return so_p;
+    }
+
     TypeId
     SO::GetTypeId (void)
     {
@@ -102,6 +118,8 @@ namespace wire {
     void
     SO::Serialize (Buffer::Iterator start) const
     {
+      Buffer::Iterator begin = start;
+
       // Serialize the header
       CommonSerialize(start);
 
@@ -112,10 +130,9 @@ namespace wire {
       NS_LOG_INFO ("Serialize -> PktID = " << m_ptr->GetPacketId());
       NS_LOG_INFO ("Serialize -> TTL = " << Seconds(static_cast<uint16_t> (m_ptr->GetLifetime ().ToInteger (Time::S))));
       NS_LOG_INFO ("Serialize -> Version = " << m_ptr->GetVersion ());
-      NS_LOG_INFO ("Serialize -> Pkt Len = " << GetSerializedSize());
 
-      // Serialize the packet size
-      start.WriteU16(GetSerializedSize());
+      // Serialize the packet size, patched once everything is written
+      start.WriteU16 (0);
 
       // Serialize the PDU Data type
       start.WriteU16(m_ptr->GetPDUPayloadType());
@@ -123,6 +140,7 @@ namespace wire {
       // Serialize
       NnnSim::SerializeName(start, m_ptr->GetName());
 
+      CommonPatchLength (begin, start);
       NS_LOG_INFO("Finished serialization");
     }
 
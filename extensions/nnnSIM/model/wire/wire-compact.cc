@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  wire-compact.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  wire-compact.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with wire-compact.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ns3-dev/ns3/assert.h>
+
+#include "wire-compact.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+
+  const uint8_t Compact::TypeFlag;
+  const uint8_t Compact::Escape;
+
+  //////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////
+
+  size_t
+  Compact::SerializeVarint (Buffer::Iterator &i, uint64_t value)
+  {
+    size_t written = 1;
+    while (value >= 0x80)
+      {
+	i.WriteU8 (static_cast<uint8_t> (value | 0x80));
+	value >>= 7;
+	written++;
+      }
+    i.WriteU8 (static_cast<uint8_t> (value));
+
+    return written;
+  }
+
+  size_t
+  Compact::SerializedSizeVarint (uint64_t value)
+  {
+    size_t size = 1;
+    while (value >= 0x80)
+      {
+	value >>= 7;
+	size++;
+      }
+    return size;
+  }
+
+  uint64_t
+  Compact::DeserializeVarint (Buffer::Iterator &i)
+  {
+    uint64_t value = 0;
+    uint8_t shift = 0;
+    uint8_t byte;
+
+    do
+      {
+	NS_ASSERT_MSG (shift < 64, "Varint longer than 64 bits");
+	byte = i.ReadU8 ();
+	value |= static_cast<uint64_t> (byte & 0x7F) << shift;
+	shift += 7;
+      }
+    while (byte & 0x80);
+
+    return value;
+  }
+
+  size_t
+  Compact::SerializeName (Buffer::Iterator &i, const NNNAddress &name)
+  {
+    Buffer::Iterator start = i;
+
+    if (name.isPackable ())
+      {
+	const PackedNNNAddress &packed = name.getPacked ();
+	uint8_t nibbles = packed.nibbles ();
+
+	i.WriteU8 (nibbles);
+
+	uint16_t bounds = packed.bounds ();
+	for (uint8_t k = 0; k < (nibbles + 7) / 8; k++)
+	  i.WriteU8 (static_cast<uint8_t> (bounds >> (8 * k)));
+
+	// The nibbles past the end of the name are always zero
+	uint64_t word = packed.word ();
+	for (uint8_t k = 0; k < (nibbles + 1) / 2; k++)
+	  i.WriteU8 (static_cast<uint8_t> (word >> (56 - 8 * k)));
+      }
+    else
+      {
+	i.WriteU8 (Escape);
+	SerializeVarint (i, name.size ());
+
+	for (NNNAddress::const_iterator item = name.begin ();
+	    item != name.end ();
+	    item++)
+	  {
+	    SerializeVarint (i, item->size ());
+	    i.Write (reinterpret_cast<const uint8_t*> (item->buf ()), item->size ());
+	  }
+      }
+
+    return i.GetDistanceFrom (start);
+  }
+
+  size_t
+  Compact::SerializedSizeName (const NNNAddress &name)
+  {
+    if (name.isPackable ())
+      {
+	uint8_t nibbles = name.getPacked ().nibbles ();
+	return 1 + (nibbles + 7) / 8 + (nibbles + 1) / 2;
+      }
+
+    size_t nameSerializedSize = 1 + SerializedSizeVarint (name.size ());
+
+    for (NNNAddress::const_iterator i = name.begin ();
+	i != name.end ();
+	i++)
+      {
+	nameSerializedSize += SerializedSizeVarint (i->size ()) + i->size ();
+      }
+    return nameSerializedSize;
+  }
+
+  Ptr<NNNAddress>
+  Compact::DeserializeName (Buffer::Iterator &i)
+  {
+    Ptr<NNNAddress> name = Create<NNNAddress> ();
+
+    uint8_t nibbles = i.ReadU8 ();
+    if (nibbles == Escape)
+      {
+	uint64_t components = DeserializeVarint (i);
+	for (uint64_t k = 0; k < components; k++)
+	  {
+	    uint64_t length = DeserializeVarint (i);
+
+	    uint8_t tmp[length];
+	    i.Read (tmp, length);
+
+	    name->append (tmp, length);
+	  }
+	return name;
+      }
+
+    NS_ASSERT_MSG (nibbles <= 16, "Packed name longer than 16 nibbles");
+
+    uint16_t bounds = 0;
+    for (uint8_t k = 0; k < (nibbles + 7) / 8; k++)
+      bounds |= static_cast<uint16_t> (i.ReadU8 ()) << (8 * k);
+
+    uint64_t word = 0;
+    for (uint8_t k = 0; k < (nibbles + 1) / 2; k++)
+      word |= static_cast<uint64_t> (i.ReadU8 ()) << (56 - 8 * k);
+
+    // Every bound closes the label started after the previous one
+    uint8_t start = 0;
+    for (uint8_t k = 0; k < nibbles; k++)
+      {
+	if (bounds & (1u << k))
+	  {
+	    uint64_t label = (word << (4 * start)) >> (64 - 4 * (k + 1 - start));
+	    name->append (name::Component ().fromNumber (label));
+	    start = k + 1;
+	  }
+      }
+
+    return name;
+  }
+
+  size_t
+  Compact::SerializeAddress (Buffer::Iterator &i, const Address &addr)
+  {
+    uint32_t serialSize = addr.GetSerializedSize ();
+    uint8_t buffer[serialSize];
+    addr.CopyAllTo (buffer, serialSize);
+    i.Write (buffer, serialSize);
+
+    return serialSize;
+  }
+
+  Address
+  Compact::DeserializeAddress (Buffer::Iterator &i)
+  {
+    uint8_t type = i.ReadU8 ();
+    uint8_t length = i.ReadU8 ();
+    uint8_t buffer[length];
+    i.Read (buffer, length);
+
+    return Address (type, buffer, length);
+  }
+}
+
+NNN_NAMESPACE_END
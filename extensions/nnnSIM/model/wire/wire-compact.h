@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  wire-compact.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  wire-compact.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with wire-compact.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_WIRE_COMPACT_SYNTAX_H
+#define NNN_WIRE_COMPACT_SYNTAX_H
+
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/buffer.h>
+#include <ns3-dev/ns3/address.h>
+
+#include "../nnn-common.h"
+#include "../nnn-naming.h"
+
+NNN_NAMESPACE_BEGIN
+
+namespace wire {
+
+  /**
+   * @brief Helper to encode compact wire elements
+   *
+   * Integers are written as unsigned LEB128 varints, 7 bits per byte
+   * with the high bit set on all but the last byte.
+   *
+   * Packable names (see NNNAddress::isPackable) are written as the
+   * number of nibbles, the label bitmap (one bit per nibble, least
+   * significant byte first) and the nibbles themselves, most significant
+   * first, so that /1/2/a takes 4 bytes. Other names are written after an Escape
+   * byte as a varint number of components, each a varint length
+   * followed by the raw bytes.
+   */
+  class Compact
+  {
+  public:
+    /**
+     * @brief Set on the type byte starting every compact PDU
+     *
+     * The nnnSIM format starts with a 32 bit little endian type, whose
+     * first byte never has it set
+     */
+    static const uint8_t TypeFlag = 0x80;
+
+    /**
+     * @brief Nibble count announcing a name made of raw components
+     */
+    static const uint8_t Escape = 0xFF;
+
+    static size_t
+    SerializeVarint (Buffer::Iterator &start, uint64_t value);
+
+    static size_t
+    SerializedSizeVarint (uint64_t value);
+
+    static uint64_t
+    DeserializeVarint (Buffer::Iterator &start);
+
+    /**
+     * @brief Append Name in compact encoding
+     * @returns written length
+     */
+    static size_t
+    SerializeName (Buffer::Iterator &start, const NNNAddress &name);
+
+    /**
+     * @brief Size of Name in compact encoding
+     */
+    static size_t
+    SerializedSizeName (const NNNAddress &name);
+
+    static Ptr<NNNAddress>
+    DeserializeName (Buffer::Iterator &start);
+
+    /**
+     * @brief Append a PoA as type, length and address bytes
+     * @returns written length
+     */
+    static size_t
+    SerializeAddress (Buffer::Iterator &start, const Address &addr);
+
+    static Address
+    DeserializeAddress (Buffer::Iterator &start);
+  }; // Compact
+
+} // wire
+
+NNN_NAMESPACE_END
+
+#endif // NNN_WIRE_COMPACT_SYNTAX_H
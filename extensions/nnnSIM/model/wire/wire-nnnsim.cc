@@ -33,7 +33,8 @@ namespace wire {
   {
     Buffer::Iterator start = i;
 
-    i.WriteU16 (static_cast<uint16_t> (SerializedSizeName (name)-2));
+    // The length is written once the components are, walking them once
+    i.WriteU16 (0);
 
     for (NNNAddress::const_iterator item = name.begin ();
 	item != name.end ();
@@ -43,7 +44,11 @@ namespace wire {
 	i.Write (reinterpret_cast<const uint8_t*> (item->buf ()), item->size ());
       }
 
-    return i.GetDistanceFrom (start);
+    uint32_t written = i.GetDistanceFrom (start);
+    Buffer::Iterator length = start;
+    length.WriteU16 (static_cast<uint16_t> (written - 2));
+
+    return written;
   }
 
   size_t
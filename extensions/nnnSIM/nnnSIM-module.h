@@ -46,6 +46,7 @@
 #include "model/buffers/nnn-pdu-buffer.h"
 #include "model/fib/nnn-fib.h"
 #include "model/fib/nnn-fib-entry.h"
+#include "model/fw/nnn-adaptive-strategy.h"
 #include "model/fw/nnn-forwarding-strategy.h"
 #include "model/nnpt/nnn-nnpt.h"
 #include "model/nnpt/nnn-nnpt-entry.h"
@@ -67,7 +68,9 @@
 #include "helper/nnn-names-container.h"
 #include "helper/nnn-names-container-entry.h"
 #include "helper/nnn-stack-helper.h"
+#include "helper/nnn-wifi-association-helper.h"
 
 #include "helper/nnn-point2point-helper.h"
+#include "helper/nnn-partition-helper.h"
 
 #endif /* NNNSIM_MODULE_H_ */
@@ -0,0 +1,391 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2014 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-lease-wheel.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-lease-wheel.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-lease-wheel.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/string.h>
+
+#include "nnn-lease-wheel.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.LeaseWheel");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (LeaseWheel);
+
+    const LeaseWheel::TimerId LeaseWheel::INVALID_TIMER = 0xFFFFFFFF;
+
+    TypeId
+    LeaseWheel::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::LeaseWheel")
+	  .SetParent<Object> ()
+	  .SetGroupName ("Nnn")
+	  .AddConstructor<LeaseWheel> ()
+
+	  .AddAttribute ("Granularity", "Duration of one tick of the wheel. Leases expire at most one tick late",
+	                 StringValue ("10ms"),
+	                 MakeTimeAccessor (&LeaseWheel::SetGranularity, &LeaseWheel::GetGranularity),
+	                 MakeTimeChecker ())
+	  ;
+      return tid;
+    }
+
+    LeaseWheel::LeaseWheel ()
+    : m_granularity (MilliSeconds (10))
+    , m_free (INVALID_TIMER)
+    , m_pending (0)
+    , m_now (0)
+    , m_wakeup (0)
+    {
+      for (uint32_t i = 0; i <= OVERFLOW_SLOT; i++)
+	m_heads[i] = INVALID_TIMER;
+
+      for (uint32_t l = 0; l < LEVELS; l++)
+	m_occupied[l] = 0;
+    }
+
+    LeaseWheel::~LeaseWheel ()
+    {
+    }
+
+    uint32_t
+    LeaseWheel::RegisterClient (ExpiryCallback expired)
+    {
+      NS_LOG_FUNCTION (this);
+      m_clients.push_back (expired);
+      m_batch.push_back (std::vector<uint64_t> ());
+      return m_clients.size () - 1;
+    }
+
+    LeaseWheel::TimerId
+    LeaseWheel::Schedule (uint32_t client, Time expire, uint64_t cookie)
+    {
+      NS_LOG_FUNCTION (this << client << expire << cookie);
+      NS_ASSERT (client < m_clients.size ());
+
+      // With nothing pending, the wheel can jump to the present without
+      // having to go through the ticks in between
+      if (m_pending == 0 && !m_event.IsRunning ())
+	{
+	  uint64_t nowTick = Simulator::Now ().GetTimeStep () / m_granularity.GetTimeStep ();
+	  if (nowTick > m_now + 1)
+	    m_now = nowTick - 1;
+	}
+
+      TimerId id;
+      if (m_free != INVALID_TIMER)
+	{
+	  id = m_free;
+	  m_free = m_timers[id].m_next;
+	}
+      else
+	{
+	  id = m_timers.size ();
+	  m_timers.push_back (Timer ());
+	}
+
+      Timer &timer = m_timers[id];
+      timer.m_cookie = cookie;
+      timer.m_client = client;
+      timer.m_tick = ToTick (expire);
+
+      if (timer.m_tick <= m_now)
+	timer.m_tick = m_now + 1;
+
+      Place (id);
+      m_pending++;
+
+      UpdateWakeup ();
+      return id;
+    }
+
+    void
+    LeaseWheel::Reschedule (TimerId id, Time expire)
+    {
+      NS_LOG_FUNCTION (this << id << expire);
+
+      if (!IsPending (id))
+	return;
+
+      uint64_t tick = ToTick (expire);
+      if (tick <= m_now)
+	tick = m_now + 1;
+
+      if (tick == m_timers[id].m_tick)
+	return;
+
+      Unlink (id);
+      m_timers[id].m_tick = tick;
+      Place (id);
+
+      UpdateWakeup ();
+    }
+
+    void
+    LeaseWheel::Cancel (TimerId id)
+    {
+      NS_LOG_FUNCTION (this << id);
+
+      if (!IsPending (id))
+	return;
+
+      Unlink (id);
+      Release (id);
+
+      UpdateWakeup ();
+    }
+
+    bool
+    LeaseWheel::IsPending (TimerId id) const
+    {
+      return (id < m_timers.size () && m_timers[id].m_slot != FREE_SLOT);
+    }
+
+    uint32_t
+    LeaseWheel::GetPendingTimers () const
+    {
+      return m_pending;
+    }
+
+    void
+    LeaseWheel::SetGranularity (Time granularity)
+    {
+      NS_ASSERT_MSG (m_pending == 0, "Granularity can only be changed on an empty wheel");
+      NS_ASSERT (granularity.IsStrictlyPositive ());
+      m_granularity = granularity;
+    }
+
+    Time
+    LeaseWheel::GetGranularity () const
+    {
+      return m_granularity;
+    }
+
+    void
+    LeaseWheel::DoDispose ()
+    {
+      m_event.Cancel ();
+      m_clients.clear ();
+      m_batch.clear ();
+      m_timers.clear ();
+      m_free = INVALID_TIMER;
+      m_pending = 0;
+
+      Object::DoDispose ();
+    }
+
+    uint64_t
+    LeaseWheel::ToTick (Time t) const
+    {
+      if (!t.IsStrictlyPositive ())
+	return 0;
+
+      // Round up, leases never expire early
+      int64_t step = m_granularity.GetTimeStep ();
+      return (t.GetTimeStep () + step - 1) / step;
+    }
+
+    void
+    LeaseWheel::Place (TimerId id)
+    {
+      Timer &timer = m_timers[id];
+      uint16_t slot = OVERFLOW_SLOT;
+
+      // The level is the lowest one on which the timer and the current
+      // tick fall in the same cycle
+      for (uint32_t l = 0; l < LEVELS; l++)
+	{
+	  if (((timer.m_tick ^ m_now) >> (SLOT_BITS * (l + 1))) == 0)
+	    {
+	      slot = l * SLOTS + ((timer.m_tick >> (SLOT_BITS * l)) & (SLOTS - 1));
+	      m_occupied[l] |= (1ULL << (slot % SLOTS));
+	      break;
+	    }
+	}
+
+      timer.m_slot = slot;
+      timer.m_prev = INVALID_TIMER;
+      timer.m_next = m_heads[slot];
+
+      if (m_heads[slot] != INVALID_TIMER)
+	m_timers[m_heads[slot]].m_prev = id;
+
+      m_heads[slot] = id;
+    }
+
+    void
+    LeaseWheel::Unlink (TimerId id)
+    {
+      Timer &timer = m_timers[id];
+
+      if (timer.m_prev != INVALID_TIMER)
+	m_timers[timer.m_prev].m_next = timer.m_next;
+      else
+	m_heads[timer.m_slot] = timer.m_next;
+
+      if (timer.m_next != INVALID_TIMER)
+	m_timers[timer.m_next].m_prev = timer.m_prev;
+
+      if (m_heads[timer.m_slot] == INVALID_TIMER && timer.m_slot != OVERFLOW_SLOT)
+	m_occupied[timer.m_slot / SLOTS] &= ~(1ULL << (timer.m_slot % SLOTS));
+    }
+
+    void
+    LeaseWheel::Release (TimerId id)
+    {
+      m_timers[id].m_slot = FREE_SLOT;
+      m_timers[id].m_next = m_free;
+      m_free = id;
+      m_pending--;
+    }
+
+    void
+    LeaseWheel::Cascade (uint16_t slot)
+    {
+      TimerId id = m_heads[slot];
+
+      m_heads[slot] = INVALID_TIMER;
+      if (slot != OVERFLOW_SLOT)
+	m_occupied[slot / SLOTS] &= ~(1ULL << (slot % SLOTS));
+
+      while (id != INVALID_TIMER)
+	{
+	  TimerId next = m_timers[id].m_next;
+	  Place (id);
+	  id = next;
+	}
+    }
+
+    uint64_t
+    LeaseWheel::NextWakeup () const
+    {
+      // Slots on every level only hold timers ahead of the current
+      // position, so the first occupied slot after it on the lowest
+      // level gives the next tick with work to do
+      for (uint32_t l = 0; l < LEVELS; l++)
+	{
+	  uint32_t shift = SLOT_BITS * l;
+	  uint64_t idx = (m_now >> shift) & (SLOTS - 1);
+
+	  if (idx == SLOTS - 1)
+	    continue;
+
+	  uint64_t ahead = m_occupied[l] & (~0ULL << (idx + 1));
+	  if (ahead != 0)
+	    {
+	      uint64_t base = (m_now >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+	      return base + (static_cast<uint64_t> (__builtin_ctzll (ahead)) << shift);
+	    }
+	}
+
+      if (m_heads[OVERFLOW_SLOT] != INVALID_TIMER)
+	{
+	  uint32_t shift = SLOT_BITS * LEVELS;
+	  return ((m_now >> shift) + 1) << shift;
+	}
+
+      return 0;
+    }
+
+    void
+    LeaseWheel::UpdateWakeup ()
+    {
+      uint64_t wakeup = NextWakeup ();
+
+      if (wakeup == 0)
+	{
+	  m_event.Cancel ();
+	  m_wakeup = 0;
+	  return;
+	}
+
+      if (m_event.IsRunning () && m_wakeup == wakeup)
+	return;
+
+      m_event.Cancel ();
+      m_wakeup = wakeup;
+
+      Time delay = TimeStep (wakeup * m_granularity.GetTimeStep ()) - Simulator::Now ();
+      if (delay.IsStrictlyNegative ())
+	delay = Seconds (0);
+
+      m_event = Simulator::Schedule (delay, &LeaseWheel::Tick, this);
+    }
+
+    void
+    LeaseWheel::Tick ()
+    {
+      NS_LOG_FUNCTION (this << m_wakeup);
+
+      // Nothing is pending between the last processed tick and m_wakeup
+      uint64_t tick = m_wakeup;
+      m_now = tick;
+      m_wakeup = 0;
+
+      // Move the timers of the higher levels reaching this tick down
+      if ((tick & ((1ULL << (SLOT_BITS * LEVELS)) - 1)) == 0)
+	Cascade (OVERFLOW_SLOT);
+
+      for (uint32_t l = LEVELS - 1; l > 0; l--)
+	{
+	  uint32_t shift = SLOT_BITS * l;
+	  if ((tick & ((1ULL << shift) - 1)) == 0)
+	    Cascade (l * SLOTS + ((tick >> shift) & (SLOTS - 1)));
+	}
+
+      // Collect everything expiring on this tick
+      uint16_t slot = tick & (SLOTS - 1);
+      TimerId id = m_heads[slot];
+      m_heads[slot] = INVALID_TIMER;
+      m_occupied[0] &= ~(1ULL << slot);
+
+      while (id != INVALID_TIMER)
+	{
+	  TimerId next = m_timers[id].m_next;
+	  m_batch[m_timers[id].m_client].push_back (m_timers[id].m_cookie);
+	  Release (id);
+	  id = next;
+	}
+
+      // One callback per client, clients may schedule new timers from it
+      for (uint32_t c = 0; c < m_batch.size (); c++)
+	{
+	  if (m_batch[c].empty ())
+	    continue;
+
+	  std::vector<uint64_t> cookies;
+	  cookies.swap (m_batch[c]);
+
+	  NS_LOG_DEBUG ("Client " << c << " has " << cookies.size () << " expired leases");
+	  m_clients[c] (cookies);
+
+	  cookies.clear ();
+	  if (c < m_batch.size ())
+	    m_batch[c].swap (cookies);
+	}
+
+      UpdateWakeup ();
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
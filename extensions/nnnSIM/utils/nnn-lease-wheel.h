@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2014 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-lease-wheel.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-lease-wheel.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-lease-wheel.h.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NNN_LEASE_WHEEL_H_
+#define NNN_LEASE_WHEEL_H_
+
+#include <vector>
+
+#include <ns3-dev/ns3/callback.h>
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/object.h>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn
+     * @brief Per node lease expiry service
+     *
+     * Hierarchical timing wheel keyed by absolute lease time. The NNST,
+     * NNPT and NamesContainer register as clients and schedule timers
+     * carrying an opaque cookie. All the timers of a client expiring on
+     * the same tick are delivered with a single callback, and only one
+     * simulator event is pending per wheel at any time.
+     *
+     * Timer identifiers are recycled once a timer fires or is cancelled,
+     * so clients must forget an identifier as soon as they receive its
+     * cookie.
+     */
+    class LeaseWheel : public Object
+    {
+    public:
+      typedef uint32_t TimerId;
+
+      /**
+       * @brief Callback receiving the cookies of all timers of a client
+       * which expired on the same tick
+       */
+      typedef Callback<void, const std::vector<uint64_t> &> ExpiryCallback;
+
+      static const TimerId INVALID_TIMER;
+
+      static TypeId GetTypeId ();
+
+      LeaseWheel ();
+
+      virtual
+      ~LeaseWheel ();
+
+      /**
+       * @brief Register a client of the wheel
+       * @returns identifier of the client to use with Schedule
+       */
+      uint32_t
+      RegisterClient (ExpiryCallback expired);
+
+      /**
+       * @brief Schedule a timer for the absolute time expire
+       */
+      TimerId
+      Schedule (uint32_t client, Time expire, uint64_t cookie);
+
+      /**
+       * @brief Move a pending timer to a new absolute time in O(1)
+       */
+      void
+      Reschedule (TimerId id, Time expire);
+
+      /**
+       * @brief Cancel a pending timer
+       */
+      void
+      Cancel (TimerId id);
+
+      bool
+      IsPending (TimerId id) const;
+
+      uint32_t
+      GetPendingTimers () const;
+
+      void
+      SetGranularity (Time granularity);
+
+      Time
+      GetGranularity () const;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      static const uint32_t LEVELS = 4;
+      static const uint32_t SLOT_BITS = 6;
+      static const uint32_t SLOTS = 1 << SLOT_BITS;
+      static const uint16_t OVERFLOW_SLOT = LEVELS * SLOTS;
+      static const uint16_t FREE_SLOT = 0xFFFF;
+
+      struct Timer
+      {
+	uint64_t m_tick;
+	uint64_t m_cookie;
+	uint32_t m_client;
+	TimerId m_prev;
+	TimerId m_next;
+	uint16_t m_slot;
+      };
+
+      uint64_t
+      ToTick (Time t) const;
+
+      void
+      Place (TimerId id);
+
+      void
+      Unlink (TimerId id);
+
+      void
+      Release (TimerId id);
+
+      void
+      Cascade (uint16_t slot);
+
+      /**
+       * @brief Earliest tick at which the wheel has work to do, or 0 if empty
+       */
+      uint64_t
+      NextWakeup () const;
+
+      void
+      UpdateWakeup ();
+
+      void
+      Tick ();
+
+    private:
+      Time m_granularity;
+
+      std::vector<Timer> m_timers;
+      TimerId m_free;
+      uint32_t m_pending;
+
+      TimerId m_heads[LEVELS * SLOTS + 1];
+      uint64_t m_occupied[LEVELS];
+
+      uint64_t m_now;           ///< \brief Last tick processed
+      uint64_t m_wakeup;        ///< \brief Tick for which m_event is scheduled
+      EventId m_event;
+
+      std::vector<ExpiryCallback> m_clients;
+      std::vector<std::vector<uint64_t> > m_batch;
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_LEASE_WHEEL_H_ */
@@ -20,7 +20,6 @@
 
 #include <ns3-dev/ns3/log.h>
 #include <ns3-dev/ns3/simulator.h>
-#include <ns3-dev/ns3/random-variable.h>
 #include <ns3-dev/ns3/node.h>
 
 #include "../model/nnn-face.h"
@@ -41,7 +40,7 @@ namespace ns3
 	.SetParent <Limits> ()
 	.AddConstructor <LimitsRate> ()
 
-	.AddAttribute ("RandomizeLeak", "Randomize start time for token bucket leakage. May be helpful to prevent leak synchronizations",
+	.AddAttribute ("RandomizeLeak", "Unused, the token bucket no longer leaks periodically. Kept so existing configurations still load",
 	               TimeValue (Seconds (0.001)),
 	               MakeTimeAccessor (&LimitsRate::m_leakRandomizationInteral),
 	               MakeTimeChecker ())
@@ -55,33 +54,22 @@ namespace ns3
     {
       super::NotifyNewAggregate ();
 
-      if (!m_isLeakScheduled)
-	{
-	  if (GetObject<Face> () != 0)
-	    {
-	      NS_ASSERT_MSG (GetObject<Face> ()->GetNode () != 0, "Node object should exist on the face");
-
-	      m_isLeakScheduled = true;
-
-	      if (!m_leakRandomizationInteral.IsZero ())
-		{
-		  UniformVariable r (0.0, m_leakRandomizationInteral.ToDouble (Time::S));
-		  Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
-		                                  Seconds (r.GetValue ()), &LimitsRate::LeakBucket, this, 0.0);
-		}
-	      else
-		{
-		  Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
-		                                  Seconds (0), &LimitsRate::LeakBucket, this, 0.0);
-		}
-
-	    }
-	}
+      m_lastLeak = Simulator::Now ();
+    }
+
+    void
+    LimitsRate::DoDispose ()
+    {
+      m_wakeUp.Cancel ();
+
+      super::DoDispose ();
     }
 
     void
     LimitsRate::SetLimits (double rate, double delay)
     {
+      LeakBucket ();
+
       super::SetLimits (rate, delay);
 
       // maximum allowed burst
@@ -89,6 +77,10 @@ namespace ns3
 
       // amount of packets allowed every second (leak rate)
       m_bucketLeak = GetMaxRate ();
+
+      // A blocked caller may have no wake up pending, if nothing leaked
+      if (m_blocked)
+	ScheduleWakeUp ();
     }
 
 
@@ -97,8 +89,15 @@ namespace ns3
     {
       NS_ASSERT_MSG (limit >= 0.0, "Limit should be greater or equal to zero");
 
+      // What leaked so far did so at the old rate
+      LeakBucket ();
+
       m_bucketLeak = std::min (limit, GetMaxRate ());
       m_bucketMax  = m_bucketLeak * GetMaxDelay ();
+
+      // A blocked caller may have no wake up pending, if nothing leaked
+      if (m_blocked)
+	ScheduleWakeUp ();
     }
 
     bool
@@ -106,7 +105,17 @@ namespace ns3
     {
       if (!IsEnabled ()) return true;
 
-      return (m_bucketMax - m_bucket >= 1.0);
+      LeakBucket ();
+
+      if (m_bucketMax - m_bucket >= 1.0)
+	return true;
+
+      // The caller is blocked until a token frees up
+      m_blocked = true;
+      if (!m_wakeUp.IsRunning ())
+	ScheduleWakeUp ();
+
+      return false;
     }
 
     void
@@ -114,6 +123,8 @@ namespace ns3
     {
       if (!IsEnabled ()) return;
 
+      LeakBucket ();
+
       NS_ASSERT_MSG (m_bucketMax - m_bucket >= 1.0, "Should not be possible, unless we IsBelowLimit was not checked correctly");
       m_bucket += 1;
     }
@@ -125,9 +136,11 @@ namespace ns3
     }
 
     void
-    LimitsRate::LeakBucket (double interval)
+    LimitsRate::LeakBucket ()
     {
-      const double leak = m_bucketLeak * interval;
+      Time now = Simulator::Now ();
+      const double leak = m_bucketLeak * (now - m_lastLeak).ToDouble (Time::S);
+      m_lastLeak = now;
 
 #ifdef NS3_LOG_ENABLE
       if (m_bucket>1)
@@ -136,24 +149,38 @@ namespace ns3
 	}
 #endif
 
-      double bucketOld = m_bucket;
-
       m_bucket = std::max (0.0, m_bucket - leak);
+    }
 
-      // calculate interval so next time we will leak by 1.001, unless such interval would be more than 1 second
-      double newInterval = 1.0;
-      if (m_bucketLeak > 1.0)
-	{
-	  newInterval = 1.001 / m_bucketLeak;
-	}
+    void
+    LimitsRate::ScheduleWakeUp ()
+    {
+      m_wakeUp.Cancel ();
+
+      // Nothing leaks, SetLimits or UpdateCurrentLimit reschedule once
+      // the limit is raised
+      if (m_bucketLeak <= 0.0)
+	return;
 
-      if (m_bucketMax - bucketOld < 1.0 &&
-	  m_bucketMax - m_bucket >= 1.0) // limit number of times this stuff is called
+      // Wait until the bucket has leaked down to 1.001 tokens of room, so
+      // rounding does not leave it just short of one
+      double wait = std::max (0.0, m_bucket - (m_bucketMax - 1.001)) / m_bucketLeak;
+
+      m_wakeUp = Simulator::Schedule (Seconds (wait), &LimitsRate::WakeUp, this);
+    }
+
+    void
+    LimitsRate::WakeUp ()
+    {
+      LeakBucket ();
+
+      if (m_bucketMax - m_bucket >= 1.0)
 	{
+	  m_blocked = false;
 	  this->FireAvailableSlotCallback ();
 	}
-
-      Simulator::Schedule (Seconds (newInterval), &LimitsRate::LeakBucket, this, newInterval);
+      else
+	ScheduleWakeUp ();
     }
 
   } // namespace nnn
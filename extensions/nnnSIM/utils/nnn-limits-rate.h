@@ -20,6 +20,7 @@
 #define	_NNN_LIMITS_RATE_H_
 
 #include "nnn-limits.h"
+#include <ns3-dev/ns3/event-id.h>
 #include <ns3-dev/ns3/nstime.h>
 
 namespace ns3
@@ -29,6 +30,10 @@ namespace ns3
     /**
      * \ingroup nnn-fw
      * \brief Structure to manage limits for outstanding interests
+     *
+     * The token bucket is drained lazily: every call works out how much
+     * leaked since the previous one. The only event ever scheduled is the
+     * wake up of a caller that found the bucket full.
      */
     class LimitsRate : public Limits
     {
@@ -43,10 +48,10 @@ namespace ns3
        * \param prefix smart pointer to the prefix for the FIB entry
        */
       LimitsRate ()
-      : m_isLeakScheduled (false)
-      , m_bucketMax (0)
+      : m_bucketMax (0)
       , m_bucketLeak (1)
       , m_bucket (0)
+      , m_blocked (false)
       { }
 
       virtual
@@ -106,21 +111,38 @@ namespace ns3
       void
       NotifyNewAggregate ();
 
+      // from Object
+      virtual void
+      DoDispose ();
+
     private:
       /**
-       * @brief Leak bucket, assuming `interval' seconds between leakages
-       *
-       * @param interval Time interval for leakage. Used to calculate size of the leak
+       * @brief Leak what the bucket lost since the last call
+       */
+      void
+      LeakBucket ();
+
+      /**
+       * @brief Schedule WakeUp for when the bucket has room for one more token
        */
       void
-      LeakBucket (double interval);
+      ScheduleWakeUp ();
+
+      /**
+       * @brief Tell the blocked caller that the bucket has room again
+       */
+      void
+      WakeUp ();
     private:
-      bool m_isLeakScheduled;
 
       double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
       double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
       double m_bucket;      ///< \brief Value representing current size of the Interest allowance for this face (current size of token bucket)
 
+      Time m_lastLeak;      ///< \brief Time m_bucket was last leaked to
+      EventId m_wakeUp;     ///< \brief Pending wake up of a blocked caller
+      bool m_blocked;       ///< \brief A caller was refused and waits for the available slot callback
+
       Time m_leakRandomizationInteral;
     };
   } // namespace nnn
@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-app-delay-histogram-tracer.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-app-delay-histogram-tracer.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-app-delay-histogram-tracer.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "nnn-app-delay-histogram-tracer.h"
+
+#include <ns3-dev/ns3/node.h>
+#include <ns3-dev/ns3/config.h>
+#include <ns3-dev/ns3/names.h>
+#include <ns3-dev/ns3/callback.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/node-list.h>
+#include <ns3-dev/ns3/log.h>
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+#include "../../apps/nnn-app.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.AppDelayHistogramTracer");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<AppDelayHistogramTracer> > > > g_tracers;
+
+    template<class T>
+    static inline void
+    NullDeleter (T *ptr)
+    {
+    }
+
+    AppDelayHistogramTracer::AppDelayHistogramTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
+    : m_nodePtr (node)
+    , m_writer (Create<TraceWriter> (os))
+    {
+      m_node = boost::lexical_cast<std::string> (m_nodePtr->GetId ());
+
+      Connect ();
+
+      std::string name = Names::FindName (node);
+      if (!name.empty ())
+	{
+	  m_node = name;
+	}
+
+      SetPeriod (Seconds (1.0));
+    }
+
+    AppDelayHistogramTracer::AppDelayHistogramTracer (Ptr<TraceWriter> writer, Ptr<Node> node)
+    : m_nodePtr (node)
+    , m_writer (writer)
+    {
+      m_node = boost::lexical_cast<std::string> (m_nodePtr->GetId ());
+
+      Connect ();
+
+      std::string name = Names::FindName (node);
+      if (!name.empty ())
+	{
+	  m_node = name;
+	}
+
+      SetPeriod (Seconds (1.0));
+    }
+
+    AppDelayHistogramTracer::AppDelayHistogramTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
+    : m_node (node)
+    , m_writer (Create<TraceWriter> (os))
+    {
+      Connect ();
+
+      SetPeriod (Seconds (1.0));
+    }
+
+    AppDelayHistogramTracer::~AppDelayHistogramTracer ()
+    {
+      m_printEvent.Cancel ();
+    }
+
+    void
+    AppDelayHistogramTracer::InstallAll (const std::string &file, Time period/* = Seconds (1.0)*/,
+                                         TraceWriter::Format format/* = TraceWriter::TEXT*/)
+    {
+      std::list<Ptr<AppDelayHistogramTracer> > tracers;
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
+
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
+
+      for (NodeList::Iterator node = NodeList::Begin ();
+	  node != NodeList::End ();
+	  node++)
+	{
+	  Ptr<AppDelayHistogramTracer> trace = Install (*node, writer, period);
+	  tracers.push_back (trace);
+	}
+
+      if (tracers.size () > 0)
+	{
+	  writer->WriteHeader ();
+	}
+
+      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+    void
+    AppDelayHistogramTracer::Install (const NodeContainer &nodes, const std::string &file, Time period/* = Seconds (1.0)*/,
+                                      TraceWriter::Format format/* = TraceWriter::TEXT*/)
+    {
+      std::list<Ptr<AppDelayHistogramTracer> > tracers;
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
+
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
+
+      for (NodeContainer::Iterator node = nodes.Begin ();
+	  node != nodes.End ();
+	  node++)
+	{
+	  Ptr<AppDelayHistogramTracer> trace = Install (*node, writer, period);
+	  tracers.push_back (trace);
+	}
+
+      if (tracers.size () > 0)
+	{
+	  writer->WriteHeader ();
+	}
+
+      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+    void
+    AppDelayHistogramTracer::Install (Ptr<Node> node, const std::string &file, Time period/* = Seconds (1.0)*/,
+                                      TraceWriter::Format format/* = TraceWriter::TEXT*/)
+    {
+      std::list<Ptr<AppDelayHistogramTracer> > tracers;
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
+
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
+
+      Ptr<AppDelayHistogramTracer> trace = Install (node, writer, period);
+      tracers.push_back (trace);
+
+      if (tracers.size () > 0)
+	{
+	  writer->WriteHeader ();
+	}
+
+      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+    Ptr<AppDelayHistogramTracer>
+    AppDelayHistogramTracer::Install (Ptr<Node> node,
+                                      Ptr<TraceWriter> writer,
+                                      Time period/* = Seconds (1.0)*/)
+    {
+      NS_LOG_DEBUG ("Node: " << node->GetId ());
+
+      Ptr<AppDelayHistogramTracer> trace = Create<AppDelayHistogramTracer> (writer, node);
+      trace->SetPeriod (period);
+
+      return trace;
+    }
+
+    void
+    AppDelayHistogramTracer::Destroy ()
+    {
+      g_tracers.clear ();
+    }
+
+    void
+    AppDelayHistogramTracer::AddColumns (TraceWriter &writer)
+    {
+      writer.AddColumn ("Time", TraceWriter::DOUBLE);
+      writer.AddColumn ("Node", TraceWriter::STRING);
+      writer.AddColumn ("AppId", TraceWriter::INT32);
+      writer.AddColumn ("Type", TraceWriter::STRING);
+      writer.AddColumn ("Split", TraceWriter::STRING);
+      writer.AddColumn ("SplitValue", TraceWriter::INT32);
+      writer.AddColumn ("Samples", TraceWriter::UINT32);
+      writer.AddColumn ("MeanUS", TraceWriter::DOUBLE);
+      writer.AddColumn ("P50US", TraceWriter::DOUBLE);
+      writer.AddColumn ("P90US", TraceWriter::DOUBLE);
+      writer.AddColumn ("P99US", TraceWriter::DOUBLE);
+      writer.AddColumn ("P999US", TraceWriter::DOUBLE);
+      writer.AddColumn ("MaxUS", TraceWriter::DOUBLE);
+    }
+
+    void
+    AppDelayHistogramTracer::Connect ()
+    {
+      Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/LastRetransmittedInterestDataDelay",
+                                     MakeCallback (&AppDelayHistogramTracer::LastRetransmittedInterestDataDelay, this));
+
+      Config::ConnectWithoutContext ("/NodeList/"+m_node+"/ApplicationList/*/FirstInterestDataDelay",
+                                     MakeCallback (&AppDelayHistogramTracer::FirstInterestDataDelay, this));
+    }
+
+    void
+    AppDelayHistogramTracer::SetPeriod (const Time &period)
+    {
+      m_period = period;
+      m_printEvent.Cancel ();
+      m_printEvent = Simulator::Schedule (m_period, &AppDelayHistogramTracer::PeriodicPrinter, this);
+    }
+
+    void
+    AppDelayHistogramTracer::PeriodicPrinter ()
+    {
+      Write (*m_writer);
+      Reset ();
+
+      m_printEvent = Simulator::Schedule (m_period, &AppDelayHistogramTracer::PeriodicPrinter, this);
+    }
+
+    void
+    AppDelayHistogramTracer::Record (Ptr<App> app, DelayType type, Time delay, uint32_t retxCount, int32_t hopCount)
+    {
+      uint64_t us = std::max<int64_t> (delay.GetMicroSeconds (), 0);
+
+      int32_t ids[] = { static_cast<int32_t> (app->GetId ()), -1 };
+      for (uint32_t i = 0; i < 2; i++)
+	{
+	  Histograms &histograms = m_histograms[ids[i]].delay[type];
+	  histograms.all.Add (us);
+	  histograms.retx[retxCount].Add (us);
+	  histograms.hops[hopCount].Add (us);
+	}
+    }
+
+    void
+    AppDelayHistogramTracer::Reset ()
+    {
+      // Keep the histograms, so their buckets are not reallocated every period
+      for (std::map<int32_t, AppHistograms>::iterator app = m_histograms.begin ();
+	  app != m_histograms.end ();
+	  app++)
+	{
+	  for (uint32_t type = 0; type < N_DELAY_TYPES; type++)
+	    {
+	      Histograms &histograms = app->second.delay[type];
+	      histograms.all.Reset ();
+
+	      for (std::map<uint32_t, LatencyHistogram>::iterator i = histograms.retx.begin ();
+		  i != histograms.retx.end ();
+		  i++)
+		{
+		  i->second.Reset ();
+		}
+
+	      for (std::map<int32_t, LatencyHistogram>::iterator i = histograms.hops.begin ();
+		  i != histograms.hops.end ();
+		  i++)
+		{
+		  i->second.Reset ();
+		}
+	    }
+	}
+    }
+
+    void
+    AppDelayHistogramTracer::Print (std::ostream &os) const
+    {
+      TraceWriter writer (boost::shared_ptr<std::ostream> (&os, NullDeleter<std::ostream>));
+      Write (writer);
+    }
+
+    void
+    AppDelayHistogramTracer::WriteRow (TraceWriter &writer, double time, int32_t appId, DelayType type,
+                                       const std::string &split, int32_t value, const LatencyHistogram &histogram) const
+    {
+      if (histogram.GetCount () == 0)
+	return;
+
+      writer.Double (time)
+	.String (m_node)
+	.Int32 (appId)
+	.String ((type == LAST_DELAY) ? "LastDelay" : "FullDelay")
+	.String (split)
+	.Int32 (value)
+	.UInt32 (histogram.GetCount ())
+	.Double (histogram.GetMean ())
+	.Double (histogram.GetPercentile (0.5))
+	.Double (histogram.GetPercentile (0.9))
+	.Double (histogram.GetPercentile (0.99))
+	.Double (histogram.GetPercentile (0.999))
+	.Double (histogram.GetMax ())
+	.EndRow ();
+    }
+
+    void
+    AppDelayHistogramTracer::Write (TraceWriter &writer) const
+    {
+      double time = Simulator::Now ().ToDouble (Time::S);
+
+      for (std::map<int32_t, AppHistograms>::const_iterator app = m_histograms.begin ();
+	  app != m_histograms.end ();
+	  app++)
+	{
+	  for (uint32_t t = 0; t < N_DELAY_TYPES; t++)
+	    {
+	      DelayType type = static_cast<DelayType> (t);
+	      const Histograms &histograms = app->second.delay[type];
+
+	      WriteRow (writer, time, app->first, type, "all", -1, histograms.all);
+
+	      for (std::map<uint32_t, LatencyHistogram>::const_iterator i = histograms.retx.begin ();
+		  i != histograms.retx.end ();
+		  i++)
+		{
+		  WriteRow (writer, time, app->first, type, "RetxCount", i->first, i->second);
+		}
+
+	      for (std::map<int32_t, LatencyHistogram>::const_iterator i = histograms.hops.begin ();
+		  i != histograms.hops.end ();
+		  i++)
+		{
+		  WriteRow (writer, time, app->first, type, "HopCount", i->first, i->second);
+		}
+	    }
+	}
+    }
+
+    void
+    AppDelayHistogramTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+    {
+      Record (app, LAST_DELAY, delay, 1, hopCount);
+    }
+
+    void
+    AppDelayHistogramTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
+    {
+      Record (app, FULL_DELAY, delay, retxCount, hopCount);
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
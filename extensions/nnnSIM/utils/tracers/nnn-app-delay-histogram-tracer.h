@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-app-delay-histogram-tracer.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-app-delay-histogram-tracer.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-app-delay-histogram-tracer.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_APP_DELAY_HISTOGRAM_TRACER_H_
+#define NNN_APP_DELAY_HISTOGRAM_TRACER_H_
+
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/simple-ref-count.h>
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/node-container.h>
+
+#include "nnn-latency-histogram.h"
+#include "nnn-trace-writer.h"
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <map>
+
+namespace ns3
+{
+  class Node;
+
+  namespace nnn
+  {
+    class App;
+
+    /**
+     * @brief Aggregated counterpart of AppDelayTracer
+     *
+     * Instead of a line per satisfied Interest, keeps LatencyHistograms of
+     * the delays seen by each application and by the node as a whole
+     * (AppId -1), also split by retransmission count and hop count. Every
+     * period it writes one row per non empty histogram with the number of
+     * samples, the mean, p50, p90, p99, p99.9 and the maximum delay in
+     * microseconds, and starts over.
+     */
+    class AppDelayHistogramTracer : public SimpleRefCount<AppDelayHistogramTracer>
+    {
+    public:
+      /**
+       * @brief Trace constructor that attaches to all applications on the node using node's pointer
+       * @param os    reference to the output stream
+       * @param node  pointer to the node
+       */
+      AppDelayHistogramTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+      /**
+       * @brief Trace constructor that attaches to all applications on the node using node's name
+       * @param os        reference to the output stream
+       * @param nodeName  name of the node registered using Names::Add
+       */
+      AppDelayHistogramTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
+
+      /**
+       * @brief Trace constructor writing rows through writer
+       * @param writer  writer shared with the other tracers of the output
+       * @param node    pointer to the node
+       */
+      AppDelayHistogramTracer (Ptr<TraceWriter> writer, Ptr<Node> node);
+
+      /**
+       * @brief Destructor
+       */
+      ~AppDelayHistogramTracer ();
+
+      /**
+       * @brief Helper method to install tracers on all simulation nodes
+       *
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the summaries will be written into the trace file
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
+       */
+      static void
+      InstallAll (const std::string &file, Time period = Seconds (1.0),
+                  TraceWriter::Format format = TraceWriter::TEXT);
+
+      /**
+       * @brief Helper method to install tracers on the selected simulation nodes
+       *
+       * @param nodes Nodes on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the summaries will be written into the trace file
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
+       */
+      static void
+      Install (const NodeContainer &nodes, const std::string &file, Time period = Seconds (1.0),
+               TraceWriter::Format format = TraceWriter::TEXT);
+
+      /**
+       * @brief Helper method to install tracers on a specific simulation node
+       *
+       * @param node Node on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the summaries will be written into the trace file
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
+       */
+      static void
+      Install (Ptr<Node> node, const std::string &file, Time period = Seconds (1.0),
+               TraceWriter::Format format = TraceWriter::TEXT);
+
+      /**
+       * @brief Helper method to install a tracer on a node, writing rows through a shared writer
+       *
+       * @param node Node on which to install tracer
+       * @param writer Writer, with the columns of AddColumns, shared by all the tracers of an output
+       * @param period How often the summaries will be written into the trace file
+       */
+      static Ptr<AppDelayHistogramTracer>
+      Install (Ptr<Node> node, Ptr<TraceWriter> writer, Time period = Seconds (1.0));
+
+      /**
+       * @brief Explicit request to remove all statically created tracers
+       *
+       * This method can be helpful if simulation scenario contains several independent run,
+       * or if it is desired to do a postprocessing of the resulting data
+       */
+      static void
+      Destroy ();
+
+      /**
+       * @brief Declare the trace columns on writer
+       */
+      static void
+      AddColumns (TraceWriter &writer);
+
+      /**
+       * @brief Write the summaries of the histograms gathered so far
+       */
+      void
+      Print (std::ostream &os) const;
+
+    private:
+      enum DelayType
+      {
+	LAST_DELAY = 0,
+	FULL_DELAY,
+	N_DELAY_TYPES
+      };
+
+      struct Histograms
+      {
+	LatencyHistogram all;
+	std::map<uint32_t, LatencyHistogram> retx;   ///< @brief By retransmission count
+	std::map<int32_t, LatencyHistogram> hops;    ///< @brief By hop count
+      };
+
+      struct AppHistograms
+      {
+	Histograms delay[N_DELAY_TYPES];
+      };
+
+      void
+      Connect ();
+
+      void
+      SetPeriod (const Time &period);
+
+      void
+      PeriodicPrinter ();
+
+      void
+      Record (Ptr<App> app, DelayType type, Time delay, uint32_t retxCount, int32_t hopCount);
+
+      void
+      Write (TraceWriter &writer) const;
+
+      void
+      WriteRow (TraceWriter &writer, double time, int32_t appId, DelayType type,
+                const std::string &split, int32_t value, const LatencyHistogram &histogram) const;
+
+      void
+      Reset ();
+
+      void
+      LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+      void
+      FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount, int32_t hopCount);
+
+    private:
+      std::string m_node;
+      Ptr<Node> m_nodePtr;
+
+      Ptr<TraceWriter> m_writer;
+      Time m_period;
+      EventId m_printEvent;
+
+      // Keyed by application id, -1 for the whole node
+      std::map<int32_t, AppHistograms> m_histograms;
+    };
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_APP_DELAY_HISTOGRAM_TRACER_H_ */
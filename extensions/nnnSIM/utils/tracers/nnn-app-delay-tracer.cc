@@ -56,7 +56,22 @@ namespace ns3
 
     AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     : m_nodePtr (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
+    {
+      m_node = boost::lexical_cast<std::string> (m_nodePtr->GetId ());
+
+      Connect ();
+
+      std::string name = Names::FindName (node);
+      if (!name.empty ())
+	{
+	  m_node = name;
+	}
+    }
+
+    AppDelayTracer::AppDelayTracer (Ptr<TraceWriter> writer, Ptr<Node> node)
+    : m_nodePtr (node)
+    , m_writer (writer)
     {
       m_node = boost::lexical_cast<std::string> (m_nodePtr->GetId ());
 
@@ -71,7 +86,7 @@ namespace ns3
 
     AppDelayTracer::AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
     : m_node (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
     {
       Connect ();
     }
@@ -81,36 +96,23 @@ namespace ns3
     }
 
     void
-    AppDelayTracer::Install (Ptr<Node> node, const std::string &file)
+    AppDelayTracer::Install (Ptr<Node> node, const std::string &file, TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<AppDelayTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
-
-      Ptr<AppDelayTracer> trace = Install (node, outputStream);
+      Ptr<AppDelayTracer> trace = Install (node, writer);
       tracers.push_back (trace);
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -119,94 +121,75 @@ namespace ns3
     Ptr<AppDelayTracer>
     AppDelayTracer::Install (Ptr<Node> node,
                              boost::shared_ptr<std::ostream> outputStream)
+    {
+      return Install (node, Create<TraceWriter> (outputStream));
+    }
+
+    Ptr<AppDelayTracer>
+    AppDelayTracer::Install (Ptr<Node> node,
+                             Ptr<TraceWriter> writer)
     {
       NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-      Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (outputStream, node);
+      Ptr<AppDelayTracer> trace = Create<AppDelayTracer> (writer, node);
 
       return trace;
     }
 
     void
-    AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file)
+    AppDelayTracer::Install (const NodeContainer &nodes, const std::string &file, TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<AppDelayTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
-
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeContainer::Iterator node = nodes.Begin ();
 	  node != nodes.End ();
 	  node++)
 	{
-	  Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+	  Ptr<AppDelayTracer> trace = Install (*node, writer);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
     }
 
     void
-    AppDelayTracer::InstallAll (const std::string &file)
+    AppDelayTracer::InstallAll (const std::string &file, TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       using namespace boost;
       using namespace std;
 
       std::list<Ptr<AppDelayTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeList::Iterator node = NodeList::Begin ();
 	  node != NodeList::End ();
 	  node++)
 	{
-	  Ptr<AppDelayTracer> trace = Install (*node, outputStream);
+	  Ptr<AppDelayTracer> trace = Install (*node, writer);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -233,6 +216,20 @@ namespace ns3
 	  << "HopCount"  << "";
     }
 
+    void
+    AppDelayTracer::AddColumns (TraceWriter &writer)
+    {
+      writer.AddColumn ("Time", TraceWriter::DOUBLE);
+      writer.AddColumn ("Node", TraceWriter::STRING);
+      writer.AddColumn ("AppId", TraceWriter::UINT32);
+      writer.AddColumn ("SeqNo", TraceWriter::UINT32);
+      writer.AddColumn ("Type", TraceWriter::STRING);
+      writer.AddColumn ("DelayS", TraceWriter::DOUBLE);
+      writer.AddColumn ("DelayUS", TraceWriter::DOUBLE);
+      writer.AddColumn ("RetxCount", TraceWriter::UINT32);
+      writer.AddColumn ("HopCount", TraceWriter::INT32);
+    }
+
     void
     AppDelayTracer::Connect ()
     {
@@ -246,29 +243,31 @@ namespace ns3
     void
     AppDelayTracer::LastRetransmittedInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
     {
-      *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
-	  << m_node << "\t"
-	  << app->GetId () << "\t"
-	  << seqno << "\t"
-	  << "LastDelay" << "\t"
-	  << delay.ToDouble (Time::S) << "\t"
-	  << delay.ToDouble (Time::US) << "\t"
-	  << 1 << "\t"
-	  << hopCount << "\n";
+      m_writer->Double (Simulator::Now ().ToDouble (Time::S))
+	.String (m_node)
+	.UInt32 (app->GetId ())
+	.UInt32 (seqno)
+	.String ("LastDelay")
+	.Double (delay.ToDouble (Time::S))
+	.Double (delay.ToDouble (Time::US))
+	.UInt32 (1)
+	.Int32 (hopCount)
+	.EndRow ();
     }
 
     void
     AppDelayTracer::FirstInterestDataDelay (Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount)
     {
-      *m_os << Simulator::Now ().ToDouble (Time::S) << "\t"
-	  << m_node << "\t"
-	  << app->GetId () << "\t"
-	  << seqno << "\t"
-	  << "FullDelay" << "\t"
-	  << delay.ToDouble (Time::S) << "\t"
-	  << delay.ToDouble (Time::US) << "\t"
-	  << retxCount << "\t"
-	  << hopCount << "\n";
+      m_writer->Double (Simulator::Now ().ToDouble (Time::S))
+	.String (m_node)
+	.UInt32 (app->GetId ())
+	.UInt32 (seqno)
+	.String ("FullDelay")
+	.Double (delay.ToDouble (Time::S))
+	.Double (delay.ToDouble (Time::US))
+	.UInt32 (retxCount)
+	.Int32 (hopCount)
+	.EndRow ();
     }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -28,6 +28,8 @@
 #include <ns3-dev/ns3/event-id.h>
 #include <ns3-dev/ns3/node-container.h>
 
+#include "nnn-trace-writer.h"
+
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
 #include <list>
@@ -58,6 +60,13 @@ namespace ns3
        */
       AppDelayTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
 
+      /**
+       * @brief Trace constructor writing rows through writer
+       * @param writer  writer shared with the other tracers of the output
+       * @param node    pointer to the node
+       */
+      AppDelayTracer (Ptr<TraceWriter> writer, Ptr<Node> node);
+
       /**
        * @brief Destructor
        */
@@ -68,14 +77,14 @@ namespace ns3
        *
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
-       * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (Ptr<Node> node, const std::string &file);
+      Install (Ptr<Node> node, const std::string &file, TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on a specific simulation node
@@ -90,30 +99,47 @@ namespace ns3
       static Ptr<AppDelayTracer>
       Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream);
 
+      /**
+       * @brief Helper method to install a tracer on a node, writing rows through a shared writer
+       *
+       * @param node Node on which to install tracer
+       * @param writer Writer, with the columns of AddColumns, shared by all the tracers of an output
+       */
+      static Ptr<AppDelayTracer>
+      Install (Ptr<Node> node, Ptr<TraceWriter> writer);
+
+      /**
+       * @brief Declare the trace columns on writer
+       */
+      static void
+      AddColumns (TraceWriter &writer);
+
       /**
        * @brief Helper method to install tracers on the selected simulation nodes
        *
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (const NodeContainer &nodes, const std::string &file);
+      Install (const NodeContainer &nodes, const std::string &file, TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on all simulation nodes
        *
        * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      InstallAll (const std::string &file);
+      InstallAll (const std::string &file, TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Explicit request to remove all statically created tracers
@@ -146,7 +172,7 @@ namespace ns3
       std::string m_node;
       Ptr<Node> m_nodePtr;
 
-      boost::shared_ptr<std::ostream> m_os;
+      Ptr<TraceWriter> m_writer;
     };
   } /* namespace nnn */
 } /* namespace ns3 */
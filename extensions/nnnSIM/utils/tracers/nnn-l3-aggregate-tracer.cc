@@ -37,6 +37,7 @@
 #include "../../model/pit/nnn-pit-entry.h"
 
 #include <fstream>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE ("nnn.L3AggregateTracer");
 
@@ -54,14 +55,21 @@ namespace ns3
 
     L3AggregateTracer::L3AggregateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     : L3Tracer (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
     {
       Reset ();
     }
 
     L3AggregateTracer::L3AggregateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
     : L3Tracer (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
+    {
+      Reset ();
+    }
+
+    L3AggregateTracer::L3AggregateTracer (Ptr<TraceWriter> writer, Ptr<Node> node)
+    : L3Tracer (node)
+    , m_writer (writer)
     {
       Reset ();
     }
@@ -71,77 +79,53 @@ namespace ns3
     }
 
     void
-    L3AggregateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3AggregateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                                TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<L3AggregateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
-
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
-      Ptr<L3AggregateTracer> trace = Install (node, outputStream, averagingPeriod);
+      Ptr<L3AggregateTracer> trace = Install (node, writer, averagingPeriod);
       tracers.push_back (trace);
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
     }
 
     void
-    L3AggregateTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3AggregateTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                                TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<L3AggregateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
-
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeContainer::Iterator node = nodes.Begin ();
 	  node != nodes.End ();
 	  ++node)
 	{
-	  Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
+	  Ptr<L3AggregateTracer> trace = Install (*node, writer, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -151,51 +135,47 @@ namespace ns3
     L3AggregateTracer::Install (Ptr<Node> node,
                                 boost::shared_ptr<std::ostream> outputStream,
                                 Time averagingPeriod/* = Seconds (0.5)*/)
+    {
+      return Install (node, Create<TraceWriter> (outputStream), averagingPeriod);
+    }
+
+    Ptr<L3AggregateTracer>
+    L3AggregateTracer::Install (Ptr<Node> node,
+                                Ptr<TraceWriter> writer,
+                                Time averagingPeriod/* = Seconds (0.5)*/)
     {
       NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-      Ptr<L3AggregateTracer> trace = Create<L3AggregateTracer> (outputStream, node);
+      Ptr<L3AggregateTracer> trace = Create<L3AggregateTracer> (writer, node);
       trace->SetAveragingPeriod (averagingPeriod);
 
       return trace;
     }
 
     void
-    L3AggregateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3AggregateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                                   TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<L3AggregateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
-
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeList::Iterator node = NodeList::Begin ();
 	  node != NodeList::End ();
 	  ++node)
 	{
-	  Ptr<L3AggregateTracer> trace = Install (*node, outputStream, averagingPeriod);
+	  Ptr<L3AggregateTracer> trace = Install (*node, writer, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -224,25 +204,45 @@ namespace ns3
 #define STATS(INDEX) stats->second.get<INDEX> ()
 
 #define PRINTER(printName, fieldName) \
-  os << time.ToDouble (Time::S) << "\t"                                 \
-  << m_node << "\t";                                                    \
+  writer.Double (time.ToDouble (Time::S))                               \
+  .String (m_node);                                                     \
   if (stats->first)                                                     \
     {                                                                   \
-      os                                                                \
-        << stats->first->GetId () << "\t"                               \
-        << *stats->first << "\t";                                       \
+      writer                                                            \
+        .Int32 (stats->first->GetId ())                                 \
+        .String (faceDescr);                                            \
     }                                                                   \
   else                                                                  \
     {                                                                   \
-      os << "-1\tall\t";                                                \
+      writer.Int32 (-1).String ("all");                                 \
     }                                                                   \
-  os                                                                    \
-  << printName << "\t"                                                  \
-  << STATS(0).fieldName << "\t"                                         \
-  << STATS(1).fieldName / 1024.0 << "\n";
+  writer                                                                \
+  .String (printName)                                                   \
+  .Double (STATS(0).fieldName)                                          \
+  .Double (STATS(1).fieldName / 1024.0)                                 \
+  .EndRow ();
+
+    void
+    L3AggregateTracer::AddColumns (TraceWriter &writer)
+    {
+      writer.AddColumn ("Time", TraceWriter::DOUBLE);
+      writer.AddColumn ("Node", TraceWriter::STRING);
+      writer.AddColumn ("FaceId", TraceWriter::INT32);
+      writer.AddColumn ("FaceDescr", TraceWriter::STRING);
+      writer.AddColumn ("Type", TraceWriter::STRING);
+      writer.AddColumn ("Packets", TraceWriter::DOUBLE);
+      writer.AddColumn ("Kilobytes", TraceWriter::DOUBLE);
+    }
 
     void
     L3AggregateTracer::Print (std::ostream &os) const
+    {
+      TraceWriter writer (boost::shared_ptr<std::ostream> (&os, NullDeleter<std::ostream>));
+      Write (writer);
+    }
+
+    void
+    L3AggregateTracer::Write (TraceWriter &writer) const
     {
       Time time = Simulator::Now ();
 
@@ -253,6 +253,10 @@ namespace ns3
 	  if (!stats->first)
 	    continue;
 
+	  std::ostringstream descr;
+	  descr << *stats->first;
+	  std::string faceDescr = descr.str ();
+
 	  PRINTER ("InInterests",   m_inInterests);
 	  PRINTER ("OutInterests",  m_outInterests);
 	  PRINTER ("DropInterests", m_dropInterests);
@@ -304,6 +308,7 @@ namespace ns3
 
       {
 	std::map<Ptr<const Face>, boost::tuple<Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
+	std::string faceDescr;
 	if (stats != m_stats.end ())
 	  {
 	    PRINTER ("SatisfiedInterests", m_satisfiedInterests);
@@ -742,7 +747,7 @@ namespace ns3
     void
     L3AggregateTracer::PeriodicPrinter ()
     {
-      Print (*m_os);
+      Write (*m_writer);
       Reset ();
 
       m_printEvent = Simulator::Schedule (m_period, &L3AggregateTracer::PeriodicPrinter, this);
@@ -23,6 +23,7 @@
 #define NNN_L3_AGGREGATE_TRACER_H_
 
 #include "nnn-l3-tracer.h"
+#include "nnn-trace-writer.h"
 
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/event-id.h>
@@ -58,6 +59,13 @@ namespace ns3
        */
       L3AggregateTracer (boost::shared_ptr<std::ostream> os, const std::string &nodeName);
 
+      /**
+       * @brief Trace constructor writing rows through writer
+       * @param writer  writer shared with the other tracers of the output
+       * @param node    pointer to the node
+       */
+      L3AggregateTracer (Ptr<TraceWriter> writer, Ptr<Node> node);
+
       /**
        * @brief Destructor
        */
@@ -69,13 +77,15 @@ namespace ns3
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (Ptr<Node> node, const std::string &file, Time averagingPeriod = Seconds (0.5));
+      Install (Ptr<Node> node, const std::string &file, Time averagingPeriod = Seconds (0.5),
+               TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on the selected simulation nodes
@@ -83,13 +93,15 @@ namespace ns3
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod = Seconds (0.5));
+      Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod = Seconds (0.5),
+               TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on a specific simulation node
@@ -104,18 +116,36 @@ namespace ns3
       static Ptr<L3AggregateTracer>
       Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
+      /**
+       * @brief Helper method to install a tracer on a node, writing rows through a shared writer
+       *
+       * @param node Node on which to install tracer
+       * @param writer Writer, with the columns of AddColumns, shared by all the tracers of an output
+       * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       */
+      static Ptr<L3AggregateTracer>
+      Install (Ptr<Node> node, Ptr<TraceWriter> writer, Time averagingPeriod = Seconds (0.5));
+
+      /**
+       * @brief Declare the trace columns on writer
+       */
+      static void
+      AddColumns (TraceWriter &writer);
+
       /**
        * @brief Helper method to install tracers on all simulation nodes
        *
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        *
        * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This tuple needs to be preserved
        *          for the lifetime of simulation, otherwise SEGFAULTs are inevitable
        *
        */
       static void
-      InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5));
+      InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5),
+                  TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Explicit request to remove all statically created tracers
@@ -265,8 +295,11 @@ namespace ns3
       void
       PeriodicPrinter ();
 
+      void
+      Write (TraceWriter &writer) const;
+
     protected:
-      boost::shared_ptr<std::ostream> m_os;
+      Ptr<TraceWriter> m_writer;
 
       Time m_period;
       EventId m_printEvent;
@@ -35,7 +35,9 @@
 #include "../../model/nnn-face.h"
 #include "../../model/pit/nnn-pit-entry.h"
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 using namespace boost;
@@ -57,14 +59,39 @@ namespace ns3
 
     L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
     : L3Tracer (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
+    , m_faces (1)
+    , m_packets (N_COUNTERS, 0.0)
+    , m_bytes (N_COUNTERS, 0.0)
+    , m_packetRate (N_COUNTERS, 0.0)
+    , m_kbyteRate (N_COUNTERS, 0.0)
+    , m_nodeStats (false)
     {
       SetAveragingPeriod (Seconds (1.0));
     }
 
     L3RateTracer::L3RateTracer (boost::shared_ptr<std::ostream> os, const std::string &node)
     : L3Tracer (node)
-    , m_os (os)
+    , m_writer (Create<TraceWriter> (os))
+    , m_faces (1)
+    , m_packets (N_COUNTERS, 0.0)
+    , m_bytes (N_COUNTERS, 0.0)
+    , m_packetRate (N_COUNTERS, 0.0)
+    , m_kbyteRate (N_COUNTERS, 0.0)
+    , m_nodeStats (false)
+    {
+      SetAveragingPeriod (Seconds (1.0));
+    }
+
+    L3RateTracer::L3RateTracer (Ptr<TraceWriter> writer, Ptr<Node> node)
+    : L3Tracer (node)
+    , m_writer (writer)
+    , m_faces (1)
+    , m_packets (N_COUNTERS, 0.0)
+    , m_bytes (N_COUNTERS, 0.0)
+    , m_packetRate (N_COUNTERS, 0.0)
+    , m_kbyteRate (N_COUNTERS, 0.0)
+    , m_nodeStats (false)
     {
       SetAveragingPeriod (Seconds (1.0));
     }
@@ -75,124 +102,88 @@ namespace ns3
     }
 
     void
-    L3RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3RateTracer::InstallAll (const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                              TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       std::list<Ptr<L3RateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
-
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeList::Iterator node = NodeList::Begin ();
 	  node != NodeList::End ();
 	  node++)
 	{
-	  Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
+	  Ptr<L3RateTracer> trace = Install (*node, writer, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
     }
 
     void
-    L3RateTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3RateTracer::Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                           TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       using namespace boost;
       using namespace std;
 
       std::list<Ptr<L3RateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
-
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
       for (NodeContainer::Iterator node = nodes.Begin ();
 	  node != nodes.End ();
 	  node++)
 	{
-	  Ptr<L3RateTracer> trace = Install (*node, outputStream, averagingPeriod);
+	  Ptr<L3RateTracer> trace = Install (*node, writer, averagingPeriod);
 	  tracers.push_back (trace);
 	}
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
     }
 
     void
-    L3RateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/)
+    L3RateTracer::Install (Ptr<Node> node, const std::string &file, Time averagingPeriod/* = Seconds (0.5)*/,
+                           TraceWriter::Format format/* = TraceWriter::TEXT*/)
     {
       using namespace boost;
       using namespace std;
 
       std::list<Ptr<L3RateTracer> > tracers;
-      boost::shared_ptr<std::ostream> outputStream;
-      if (file != "-")
-	{
-	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
-	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+      boost::shared_ptr<std::ostream> outputStream = TraceWriter::Open (file, format);
+      if (!outputStream)
+	return;
 
-	  if (!os->is_open ())
-	    {
-	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
-	      return;
-	    }
+      Ptr<TraceWriter> writer = Create<TraceWriter> (outputStream, format);
+      AddColumns (*writer);
 
-	  outputStream = os;
-	}
-      else
-	{
-	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
-	}
-
-      Ptr<L3RateTracer> trace = Install (node, outputStream, averagingPeriod);
+      Ptr<L3RateTracer> trace = Install (node, writer, averagingPeriod);
       tracers.push_back (trace);
 
       if (tracers.size () > 0)
 	{
 	  // *m_l3RateTrace << "# "; // not necessary for R's read.table
-	  tracers.front ()->PrintHeader (*outputStream);
-	  *outputStream << "\n";
+	  writer->WriteHeader ();
 	}
 
       g_tracers.push_back (boost::make_tuple (outputStream, tracers));
@@ -208,10 +199,18 @@ namespace ns3
     L3RateTracer::Install (Ptr<Node> node,
                            boost::shared_ptr<std::ostream> outputStream,
                            Time averagingPeriod/* = Seconds (0.5)*/)
+    {
+      return Install (node, Create<TraceWriter> (outputStream), averagingPeriod);
+    }
+
+    Ptr<L3RateTracer>
+    L3RateTracer::Install (Ptr<Node> node,
+                           Ptr<TraceWriter> writer,
+                           Time averagingPeriod/* = Seconds (0.5)*/)
     {
       NS_LOG_DEBUG ("Node: " << node->GetId ());
 
-      Ptr<L3RateTracer> trace = Create<L3RateTracer> (outputStream, node);
+      Ptr<L3RateTracer> trace = Create<L3RateTracer> (writer, node);
       trace->SetAveragingPeriod (averagingPeriod);
 
       return trace;
@@ -233,243 +232,279 @@ namespace ns3
 	  << "KilobytesRaw";
     }
 
-#define STATS(INDEX) stats->second.get<INDEX> ()
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble (Time::S)
-
-#define PRINTER(printName, fieldName) \
-    STATS(2).fieldName = /*new value*/alpha * RATE(0, fieldName) + /*old value*/(1-alpha) * STATS(2).fieldName; \
-    STATS(3).fieldName = /*new value*/alpha * RATE(1, fieldName) / 1024.0 + /*old value*/(1-alpha) * STATS(3).fieldName; \
-    \
-    os << time.ToDouble (Time::S) << "\t"                                 \
-    << m_node << "\t";                                                    \
-    if (stats->first)                                                     \
-    {                                                                   \
-	os                                                                \
-	<< stats->first->GetId () << "\t"                               \
-	<< *stats->first << "\t";                                       \
-    }                                                                   \
-    else                                                                  \
-    {                                                                   \
-	os << "-1\tall\t";                                                \
-    }                                                                   \
-    os                                                                    \
-    << printName << "\t"                                                  \
-    << STATS(2).fieldName << "\t"                                         \
-    << STATS(3).fieldName << "\t"                                         \
-    << STATS(0).fieldName << "\t"                                         \
-    << STATS(1).fieldName / 1024.0 << "\n";
-
     const double alpha = 0.8;
 
     void
-    L3RateTracer::Print (std::ostream &os) const
+    L3RateTracer::AddColumns (TraceWriter &writer)
     {
-      Time time = Simulator::Now ();
+      writer.AddColumn ("Time", TraceWriter::DOUBLE);
+      writer.AddColumn ("Node", TraceWriter::STRING);
+      writer.AddColumn ("FaceId", TraceWriter::INT32);
+      writer.AddColumn ("FaceDescr", TraceWriter::STRING);
+      writer.AddColumn ("Type", TraceWriter::STRING);
+      writer.AddColumn ("Packets", TraceWriter::DOUBLE);
+      writer.AddColumn ("Kilobytes", TraceWriter::DOUBLE);
+      writer.AddColumn ("PacketRaw", TraceWriter::DOUBLE);
+      writer.AddColumn ("KilobytesRaw", TraceWriter::DOUBLE);
+    }
 
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
-	  stats != m_stats.end ();
-	  stats++)
-	{
-	  if (!stats->first)
-	    continue;
+    /**
+     * Counters written for each face, in the order they appear in the trace
+     */
+    static const struct
+    {
+      uint32_t counter;
+      const char *name;
+    } g_faceCounters[] = {
+      { L3RateTracer::INTEREST_TYPE * 3 + L3RateTracer::IN,   "InInterests" },
+      { L3RateTracer::INTEREST_TYPE * 3 + L3RateTracer::OUT,  "OutInterests" },
+      { L3RateTracer::INTEREST_TYPE * 3 + L3RateTracer::DROP, "DropInterests" },
 
-	  PRINTER ("InInterests",   m_inInterests);
-	  PRINTER ("OutInterests",  m_outInterests);
-	  PRINTER ("DropInterests", m_dropInterests);
+      { L3RateTracer::NACK_TYPE * 3 + L3RateTracer::IN,   "InNacks" },
+      { L3RateTracer::NACK_TYPE * 3 + L3RateTracer::OUT,  "OutNacks" },
+      { L3RateTracer::NACK_TYPE * 3 + L3RateTracer::DROP, "DropNacks" },
 
-	  PRINTER ("InNacks",   m_inNacks);
-	  PRINTER ("OutNacks",  m_outNacks);
-	  PRINTER ("DropNacks", m_dropNacks);
+      { L3RateTracer::DATA_TYPE * 3 + L3RateTracer::IN,   "InData" },
+      { L3RateTracer::DATA_TYPE * 3 + L3RateTracer::OUT,  "OutData" },
+      { L3RateTracer::DATA_TYPE * 3 + L3RateTracer::DROP, "DropData" },
 
-	  PRINTER ("InData",   m_inData);
-	  PRINTER ("OutData",  m_outData);
-	  PRINTER ("DropData", m_dropData);
+      { L3RateTracer::IN_SATISFIED,  "InSatisfiedInterests" },
+      { L3RateTracer::IN_TIMED_OUT,  "InTimedOutInterests" },
 
-	  PRINTER ("InSatisfiedInterests", m_satisfiedInterests);
-	  PRINTER ("InTimedOutInterests", m_timedOutInterests);
+      { L3RateTracer::OUT_SATISFIED, "OutSatisfiedInterests" },
+      { L3RateTracer::OUT_TIMED_OUT, "OutTimedOutInterests" },
 
-	  PRINTER ("OutSatisfiedInterests", m_outSatisfiedInterests);
-	  PRINTER ("OutTimedOutInterests", m_outTimedOutInterests);
+      { NULL_NNN * 3 + L3RateTracer::IN,   "InNULLps" },
+      { NULL_NNN * 3 + L3RateTracer::OUT,  "OutNULLps" },
+      { NULL_NNN * 3 + L3RateTracer::DROP, "DropNULLps" },
 
-	  PRINTER ("InNULLps",   m_inNULLps);
-	  PRINTER ("OutNULLps",  m_outNULLps);
-	  PRINTER ("DropNULLps", m_dropNULLps);
+      { SO_NNN * 3 + L3RateTracer::IN,   "InSOs" },
+      { SO_NNN * 3 + L3RateTracer::OUT,  "OutSOs" },
+      { SO_NNN * 3 + L3RateTracer::DROP, "DropSOs" },
 
-	  PRINTER ("InSOs",   m_inSOs);
-	  PRINTER ("OutSOs",  m_outSOs);
-	  PRINTER ("DropSOs", m_dropSOs);
+      { DO_NNN * 3 + L3RateTracer::IN,   "InDOs" },
+      { DO_NNN * 3 + L3RateTracer::OUT,  "OutDOs" },
+      { DO_NNN * 3 + L3RateTracer::DROP, "DropDOs" },
 
-	  PRINTER ("InDOs",   m_inDOs);
-	  PRINTER ("OutDOs",  m_outDOs);
-	  PRINTER ("DropDOs", m_dropDOs);
+      { DU_NNN * 3 + L3RateTracer::IN,   "InDUs" },
+      { DU_NNN * 3 + L3RateTracer::OUT,  "OutDUs" },
+      { DU_NNN * 3 + L3RateTracer::DROP, "DropDUs" },
 
-	  PRINTER ("InDUs",   m_inDUs);
-	  PRINTER ("OutDUs",  m_outDUs);
-	  PRINTER ("DropDUs", m_dropDUs);
+      { EN_NNN * 3 + L3RateTracer::IN,   "InENs" },
+      { EN_NNN * 3 + L3RateTracer::OUT,  "OutENs" },
+      { EN_NNN * 3 + L3RateTracer::DROP, "DropENs" },
 
-	  PRINTER ("InENs",   m_inENs);
-	  PRINTER ("OutENs",  m_outENs);
-	  PRINTER ("DropENs", m_dropENs);
+      { OEN_NNN * 3 + L3RateTracer::IN,   "InOENs" },
+      { OEN_NNN * 3 + L3RateTracer::OUT,  "OutOENs" },
+      { OEN_NNN * 3 + L3RateTracer::DROP, "DropOENs" },
 
-	  PRINTER ("InOENs",   m_inOENs);
-	  PRINTER ("OutOENs",  m_outOENs);
-	  PRINTER ("DropOENs", m_dropOENs);
+      { AEN_NNN * 3 + L3RateTracer::IN,   "InAENs" },
+      { AEN_NNN * 3 + L3RateTracer::OUT,  "OutAENs" },
+      { AEN_NNN * 3 + L3RateTracer::DROP, "DropAENs" },
 
-	  PRINTER ("InAENs",   m_inAENs);
-	  PRINTER ("OutAENs",  m_outAENs);
-	  PRINTER ("DropAENs", m_dropAENs);
+      { REN_NNN * 3 + L3RateTracer::IN,   "InRENs" },
+      { REN_NNN * 3 + L3RateTracer::OUT,  "OutRENs" },
+      { REN_NNN * 3 + L3RateTracer::DROP, "DropRENs" },
 
-	  PRINTER ("InRENs",   m_inRENs);
-	  PRINTER ("OutRENs",  m_outRENs);
-	  PRINTER ("DropRENs", m_dropRENs);
+      { DEN_NNN * 3 + L3RateTracer::IN,   "InDENs" },
+      { DEN_NNN * 3 + L3RateTracer::OUT,  "OutDENs" },
+      { DEN_NNN * 3 + L3RateTracer::DROP, "DropDENs" },
 
-	  PRINTER ("InINFs",   m_inINFs);
-	  PRINTER ("OutINFs",  m_outINFs);
-	  PRINTER ("DropINFs", m_dropINFs);
-	}
+      { INF_NNN * 3 + L3RateTracer::IN,   "InINFs" },
+      { INF_NNN * 3 + L3RateTracer::OUT,  "OutINFs" },
+      { INF_NNN * 3 + L3RateTracer::DROP, "DropINFs" },
+    };
 
-      {
-	std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.find (Ptr<const Face> (0));
-	if (stats != m_stats.end ())
-	  {
-	    PRINTER ("SatisfiedInterests", m_satisfiedInterests);
-	    PRINTER ("TimedOutInterests", m_timedOutInterests);
-	  }
-      }
+    void
+    L3RateTracer::Print (std::ostream &os) const
+    {
+      TraceWriter writer (boost::shared_ptr<std::ostream> (&os, NullDeleter<std::ostream>));
+      Write (writer);
     }
 
     void
-    L3RateTracer::OutInterests  (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    L3RateTracer::WriteRow (TraceWriter &writer, double time, int32_t faceId, const std::string &faceDescr,
+                            const char *name, uint32_t slot) const
     {
-      m_stats[face].get<0> ().m_outInterests ++;
-      if (interest->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outInterests += interest->GetWire ()->GetSize ();
-	}
+      writer.Double (time)
+	.String (m_node)
+	.Int32 (faceId)
+	.String (faceDescr)
+	.String (name)
+	.Double (m_packetRate[slot])
+	.Double (m_kbyteRate[slot])
+	.Double (m_packets[slot])
+	.Double (m_bytes[slot] / 1024.0)
+	.EndRow ();
     }
 
     void
-    L3RateTracer::InInterests   (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    L3RateTracer::Write (TraceWriter &writer) const
     {
-      m_stats[face].get<0> ().m_inInterests ++;
-      if (interest->GetWire ())
+      double time = Simulator::Now ().ToDouble (Time::S);
+
+      // One pass over every counter of every face, kept free of branches so
+      // the compiler can vectorize it
+      const double inv = 1.0 / m_period.ToDouble (Time::S);
+      const uint32_t slots = m_packets.size ();
+      for (uint32_t i = 0; i < slots; i++)
 	{
-	  m_stats[face].get<1> ().m_inInterests += interest->GetWire ()->GetSize ();
+	  m_packetRate[i] = /*new value*/alpha * m_packets[i] * inv + /*old value*/(1-alpha) * m_packetRate[i];
+	  m_kbyteRate[i] = /*new value*/alpha * m_bytes[i] * inv / 1024.0 + /*old value*/(1-alpha) * m_kbyteRate[i];
+	}
+
+      const uint32_t nCounters = sizeof (g_faceCounters) / sizeof (g_faceCounters[0]);
+      for (uint32_t row = 1; row < m_faces.size (); row++)
+	{
+	  if (!m_faces[row])
+	    continue;
+
+	  std::ostringstream descr;
+	  descr << *m_faces[row];
+	  std::string faceDescr = descr.str ();
+	  int32_t faceId = m_faces[row]->GetId ();
+
+	  for (uint32_t i = 0; i < nCounters; i++)
+	    {
+	      WriteRow (writer, time, faceId, faceDescr, g_faceCounters[i].name,
+	                row * N_COUNTERS + g_faceCounters[i].counter);
+	    }
+	}
+
+      if (m_nodeStats)
+	{
+	  WriteRow (writer, time, -1, "all", "SatisfiedInterests", IN_SATISFIED);
+	  WriteRow (writer, time, -1, "all", "TimedOutInterests", IN_TIMED_OUT);
 	}
     }
 
-    void
-    L3RateTracer::DropInterests (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    uint32_t
+    L3RateTracer::Slot (Ptr<const Face> face, uint32_t counter)
     {
-      m_stats[face].get<0> ().m_dropInterests ++;
-      if (interest->GetWire ())
+      if (!face)
+	return counter;
+
+      uint32_t row = face->GetId () + 1;
+      if (row >= m_faces.size () || m_faces[row] != face)
 	{
-	  m_stats[face].get<1> ().m_dropInterests += interest->GetWire ()->GetSize ();
+	  if (row >= m_faces.size ())
+	    {
+	      m_faces.resize (row + 1);
+	      m_packets.resize ((row + 1) * N_COUNTERS, 0.0);
+	      m_bytes.resize ((row + 1) * N_COUNTERS, 0.0);
+	      m_packetRate.resize ((row + 1) * N_COUNTERS, 0.0);
+	      m_kbyteRate.resize ((row + 1) * N_COUNTERS, 0.0);
+	    }
+	  else
+	    {
+	      // A new face reusing the id of a removed one starts from scratch
+	      std::fill (m_packets.begin () + row * N_COUNTERS, m_packets.begin () + (row + 1) * N_COUNTERS, 0.0);
+	      std::fill (m_bytes.begin () + row * N_COUNTERS, m_bytes.begin () + (row + 1) * N_COUNTERS, 0.0);
+	      std::fill (m_packetRate.begin () + row * N_COUNTERS, m_packetRate.begin () + (row + 1) * N_COUNTERS, 0.0);
+	      std::fill (m_kbyteRate.begin () + row * N_COUNTERS, m_kbyteRate.begin () + (row + 1) * N_COUNTERS, 0.0);
+	    }
+	  m_faces[row] = face;
 	}
+      return row * N_COUNTERS + counter;
     }
 
+    template<class T>
     void
-    L3RateTracer::OutNacks  (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    L3RateTracer::Count (Ptr<const T> pdu, Ptr<const Face> face, uint32_t counter)
     {
-      m_stats[face].get<0> ().m_outNacks ++;
-      if (interest->GetWire ())
+      uint32_t slot = Slot (face, counter);
+      m_packets[slot]++;
+      if (pdu->GetWire ())
 	{
-	  m_stats[face].get<1> ().m_outNacks += interest->GetWire ()->GetSize ();
+	  m_bytes[slot] += pdu->GetWire ()->GetSize ();
 	}
     }
 
     void
-    L3RateTracer::InNacks   (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    L3RateTracer::OutInterests (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNacks ++;
-      if (interest->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inNacks += interest->GetWire ()->GetSize ();
-	}
+      Count (interest, face, INTEREST_TYPE * 3 + OUT);
     }
 
     void
-    L3RateTracer::DropNacks (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
+    L3RateTracer::InInterests (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNacks ++;
-      if (interest->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropNacks += interest->GetWire ()->GetSize ();
-	}
+      Count (interest, face, INTEREST_TYPE * 3 + IN);
     }
 
     void
-    L3RateTracer::OutData  (Ptr<const ndn::Data> data,
-                            bool fromCache, Ptr<const Face> face)
+    L3RateTracer::DropInterests (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outData ++;
-      if (data->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outData += data->GetWire ()->GetSize ();
-	}
+      Count (interest, face, INTEREST_TYPE * 3 + DROP);
     }
 
     void
-    L3RateTracer::InData   (Ptr<const ndn::Data> data,
-                            Ptr<const Face> face)
+    L3RateTracer::OutNacks (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inData ++;
-      if (data->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inData += data->GetWire ()->GetSize ();
-	}
+      Count (interest, face, NACK_TYPE * 3 + OUT);
     }
 
     void
-    L3RateTracer::DropData (Ptr<const ndn::Data> data,
-                            Ptr<const Face> face)
+    L3RateTracer::InNacks (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropData ++;
-      if (data->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropData += data->GetWire ()->GetSize ();
-	}
+      Count (interest, face, NACK_TYPE * 3 + IN);
     }
 
     void
-    L3RateTracer::SatisfiedInterests (Ptr<const pit::Entry> entry)
+    L3RateTracer::DropNacks (Ptr<const ndn::Interest> interest, Ptr<const Face> face)
     {
-      m_stats[0].get<0> ().m_satisfiedInterests ++;
-      // no "size" stats
+      Count (interest, face, NACK_TYPE * 3 + DROP);
+    }
 
-      for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
-	  i != entry->GetIncoming ().end ();
-	  i++)
-	{
-	  m_stats[i->m_face].get<0> ().m_satisfiedInterests ++;
-	}
+    void
+    L3RateTracer::OutData (Ptr<const ndn::Data> data, bool fromCache, Ptr<const Face> face)
+    {
+      Count (data, face, DATA_TYPE * 3 + OUT);
+    }
 
-      for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
-	  i != entry->GetOutgoing ().end ();
-	  i++)
-	{
-	  m_stats[i->m_face].get<0> ().m_outSatisfiedInterests ++;
-	}
+    void
+    L3RateTracer::InData (Ptr<const ndn::Data> data, Ptr<const Face> face)
+    {
+      Count (data, face, DATA_TYPE * 3 + IN);
+    }
+
+    void
+    L3RateTracer::DropData (Ptr<const ndn::Data> data, Ptr<const Face> face)
+    {
+      Count (data, face, DATA_TYPE * 3 + DROP);
+    }
+
+    void
+    L3RateTracer::SatisfiedInterests (Ptr<const pit::Entry> entry)
+    {
+      CountEntry (entry, IN_SATISFIED, OUT_SATISFIED);
     }
 
     void
     L3RateTracer::TimedOutInterests (Ptr<const pit::Entry> entry)
     {
-      m_stats[0].get<0> ().m_timedOutInterests ++;
+      CountEntry (entry, IN_TIMED_OUT, OUT_TIMED_OUT);
+    }
+
+    void
+    L3RateTracer::CountEntry (Ptr<const pit::Entry> entry, uint32_t inCounter, uint32_t outCounter)
+    {
+      m_nodeStats = true;
+      m_packets[inCounter]++;
       // no "size" stats
 
       for (pit::Entry::in_container::const_iterator i = entry->GetIncoming ().begin ();
 	  i != entry->GetIncoming ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_timedOutInterests ++;
+	  m_packets[Slot (i->m_face, inCounter)]++;
 	}
 
       for (pit::Entry::out_container::const_iterator i = entry->GetOutgoing ().begin ();
 	  i != entry->GetOutgoing ().end ();
 	  i++)
 	{
-	  m_stats[i->m_face].get<0> ().m_outTimedOutInterests ++;
+	  m_packets[Slot (i->m_face, outCounter)]++;
 	}
     }
 
@@ -484,322 +519,197 @@ namespace ns3
     void
     L3RateTracer::PeriodicPrinter ()
     {
-      Print (*m_os);
+      Write (*m_writer);
       Reset ();
 
       m_printEvent = Simulator::Schedule (m_period, &L3RateTracer::PeriodicPrinter, this);
     }
 
     void
-    L3RateTracer::OutAENs  (Ptr<const AEN> aen_p, Ptr<const Face> face)
+    L3RateTracer::OutAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outAENs ++;
-      if (aen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outAENs += aen_p->GetWire ()->GetSize ();
-	}
+      Count (aen_p, face, AEN_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InAENs   (Ptr<const AEN> aen_p, Ptr<const Face> face)
+    L3RateTracer::InAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inAENs ++;
-      if (aen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inAENs += aen_p->GetWire ()->GetSize ();
-	}
+      Count (aen_p, face, AEN_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropAENs ++;
-      if (aen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropAENs += aen_p->GetWire ()->GetSize ();
-	}
+      Count (aen_p, face, AEN_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutDENs  (Ptr<const DEN> den_p, Ptr<const Face> face)
+    L3RateTracer::OutDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDENs ++;
-      if (den_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outDENs += den_p->GetWire ()->GetSize ();
-	}
+      Count (den_p, face, DEN_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InDENs   (Ptr<const DEN> den_p, Ptr<const Face> face)
+    L3RateTracer::InDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDENs ++;
-      if (den_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inDENs += den_p->GetWire ()->GetSize ();
-	}
+      Count (den_p, face, DEN_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDENs ++;
-      if (den_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropDENs += den_p->GetWire ()->GetSize ();
-	}
+      Count (den_p, face, DEN_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutENs  (Ptr<const EN> en_p, Ptr<const Face> face)
+    L3RateTracer::OutENs (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outENs ++;
-      if (en_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outENs += en_p->GetWire ()->GetSize ();
-	}
+      Count (en_p, face, EN_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InENs   (Ptr<const EN> en_p, Ptr<const Face> face)
+    L3RateTracer::InENs (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inENs ++;
-      if (en_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inENs += en_p->GetWire ()->GetSize ();
-	}
+      Count (en_p, face, EN_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropENs (Ptr<const EN> en_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropENs ++;
-      if (en_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropENs += en_p->GetWire ()->GetSize ();
-	}
+      Count (en_p, face, EN_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutOENs  (Ptr<const OEN> oen_p, Ptr<const Face> face)
+    L3RateTracer::OutOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outOENs ++;
-      if (oen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outOENs += oen_p->GetWire ()->GetSize ();
-	}
+      Count (oen_p, face, OEN_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InOENs   (Ptr<const OEN> oen_p, Ptr<const Face> face)
+    L3RateTracer::InOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inOENs ++;
-      if (oen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inOENs += oen_p->GetWire ()->GetSize ();
-	}
+      Count (oen_p, face, OEN_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropOENs ++;
-      if (oen_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropENs += oen_p->GetWire ()->GetSize ();
-	}
+      Count (oen_p, face, OEN_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutRENs  (Ptr<const REN> ren_p, Ptr<const Face> face)
+    L3RateTracer::OutRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outRENs ++;
-      if (ren_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outRENs += ren_p->GetWire ()->GetSize ();
-	}
+      Count (ren_p, face, REN_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InRENs   (Ptr<const REN> ren_p, Ptr<const Face> face)
+    L3RateTracer::InRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inRENs ++;
-      if (ren_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inRENs += ren_p->GetWire ()->GetSize ();
-	}
+      Count (ren_p, face, REN_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropRENs ++;
-      if (ren_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropRENs += ren_p->GetWire ()->GetSize ();
-	}
+      Count (ren_p, face, REN_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutINFs  (Ptr<const INF> inf_p, Ptr<const Face> face)
+    L3RateTracer::OutINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outINFs ++;
-      if (inf_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outINFs += inf_p->GetWire ()->GetSize ();
-	}
+      Count (inf_p, face, INF_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InINFs   (Ptr<const INF> inf_p, Ptr<const Face> face)
+    L3RateTracer::InINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inINFs ++;
-      if (inf_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inINFs += inf_p->GetWire ()->GetSize ();
-	}
+      Count (inf_p, face, INF_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropINFs ++;
-      if (inf_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropINFs += inf_p->GetWire ()->GetSize ();
-	}
+      Count (inf_p, face, INF_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutDOs  (Ptr<const DO> do_p, Ptr<const Face> face)
+    L3RateTracer::OutDOs (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDOs ++;
-      if (do_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outDOs += do_p->GetWire ()->GetSize ();
-	}
+      Count (do_p, face, DO_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InDOs   (Ptr<const DO> do_p, Ptr<const Face> face)
+    L3RateTracer::InDOs (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDOs ++;
-      if (do_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inDOs += do_p->GetWire ()->GetSize ();
-	}
+      Count (do_p, face, DO_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropDOs (Ptr<const DO> do_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDOs ++;
-      if (do_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropDOs += do_p->GetWire ()->GetSize ();
-	}
+      Count (do_p, face, DO_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutDUs  (Ptr<const DU> du_p, Ptr<const Face> face)
+    L3RateTracer::OutDUs (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outDUs ++;
-      if (du_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outDUs += du_p->GetWire ()->GetSize ();
-	}
+      Count (du_p, face, DU_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InDUs   (Ptr<const DU> du_p, Ptr<const Face> face)
+    L3RateTracer::InDUs (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inDUs ++;
-      if (du_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inDUs += du_p->GetWire ()->GetSize ();
-	}
+      Count (du_p, face, DU_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropDUs (Ptr<const DU> du_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropDUs ++;
-      if (du_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropDUs += du_p->GetWire ()->GetSize ();
-	}
+      Count (du_p, face, DU_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutSOs  (Ptr<const SO> so_p, Ptr<const Face> face)
+    L3RateTracer::OutSOs (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outSOs ++;
-      if (so_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outSOs += so_p->GetWire ()->GetSize ();
-	}
+      Count (so_p, face, SO_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InSOs   (Ptr<const SO> so_p, Ptr<const Face> face)
+    L3RateTracer::InSOs (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inSOs ++;
-      if (so_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inSOs += so_p->GetWire ()->GetSize ();
-	}
+      Count (so_p, face, SO_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropSOs (Ptr<const SO> so_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropSOs ++;
-      if (so_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropSOs += so_p->GetWire ()->GetSize ();
-	}
+      Count (so_p, face, SO_NNN * 3 + DROP);
     }
 
     void
-    L3RateTracer::OutNULLps  (Ptr<const NULLp> null_p, Ptr<const Face> face)
+    L3RateTracer::OutNULLps (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_outNULLps ++;
-      if (null_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_outNULLps += null_p->GetWire ()->GetSize ();
-	}
+      Count (null_p, face, NULL_NNN * 3 + OUT);
     }
 
     void
-    L3RateTracer::InNULLps   (Ptr<const NULLp> null_p, Ptr<const Face> face)
+    L3RateTracer::InNULLps (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_inNULLps ++;
-      if (null_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_inNULLps += null_p->GetWire ()->GetSize ();
-	}
+      Count (null_p, face, NULL_NNN * 3 + IN);
     }
 
     void
     L3RateTracer::DropNULLps (Ptr<const NULLp> null_p, Ptr<const Face> face)
     {
-      m_stats[face].get<0> ().m_dropNULLps ++;
-      if (null_p->GetWire ())
-	{
-	  m_stats[face].get<1> ().m_dropNULLps += null_p->GetWire ()->GetSize ();
-	}
+      Count (null_p, face, NULL_NNN * 3 + DROP);
     }
 
     void
     L3RateTracer::Reset ()
     {
-      for (std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> >::iterator stats = m_stats.begin ();
-	  stats != m_stats.end ();
-	  stats++)
-	{
-	  stats->second.get<0> ().Reset ();
-	  stats->second.get<1> ().Reset ();
-	}
+      std::fill (m_packets.begin (), m_packets.end (), 0.0);
+      std::fill (m_bytes.begin (), m_bytes.end (), 0.0);
     }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -20,6 +20,8 @@
 #define NNN_L3_RATE_TRACER_H_
 
 #include "nnn-l3-tracer.h"
+#include "nnn-trace-writer.h"
+#include "../../model/pdus/nnn-pdu.h"
 
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/event-id.h>
@@ -27,8 +29,8 @@
 
 #include <boost/tuple/tuple.hpp>
 #include <boost/shared_ptr.hpp>
-#include <map>
 #include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -38,6 +40,37 @@ namespace ns3
     class L3RateTracer : public L3Tracer
     {
     public:
+      enum Direction
+      {
+	IN = 0,
+	OUT,
+	DROP
+      };
+
+      /**
+       * @brief PDU types counted besides NNN_PDU_TYPE
+       */
+      enum CountedType
+      {
+	INTEREST_TYPE = INF_NNN + 1,
+	NACK_TYPE,
+	DATA_TYPE,
+	N_TYPES
+      };
+
+      /**
+       * @brief Counters kept for each face, the first N_TYPES * 3 being
+       * type * 3 + Direction
+       */
+      enum Counter
+      {
+	IN_SATISFIED = N_TYPES * 3,
+	IN_TIMED_OUT,
+	OUT_SATISFIED,
+	OUT_TIMED_OUT,
+	N_COUNTERS
+      };
+
       /**
        * @brief Trace constructor that attaches to the node using node pointer
        * @param os    reference to the output stream
@@ -52,6 +85,13 @@ namespace ns3
        */
       L3RateTracer (boost::shared_ptr<std::ostream> os, const std::string &node);
 
+      /**
+       * @brief Trace constructor writing rows through writer
+       * @param writer  writer shared with the other tracers of the output
+       * @param node    pointer to the node
+       */
+      L3RateTracer (Ptr<TraceWriter> writer, Ptr<Node> node);
+
       /**
        * @brief Destructor
        */
@@ -63,9 +103,11 @@ namespace ns3
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod Defines averaging period for the rate calculation,
        *        as well as how often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        */
       static void
-      InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5));
+      InstallAll (const std::string &file, Time averagingPeriod = Seconds (0.5),
+                  TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on the selected simulation nodes
@@ -73,9 +115,11 @@ namespace ns3
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        */
       static void
-      Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod = Seconds (0.5));
+      Install (const NodeContainer &nodes, const std::string &file, Time averagingPeriod = Seconds (0.5),
+               TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Helper method to install tracers on a specific simulation node
@@ -83,9 +127,11 @@ namespace ns3
        * @param nodes Nodes on which to install tracer
        * @param file File to which traces will be written.  If filename is -, then std::out is used
        * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       * @param format TEXT for tab separated values, BINARY for the columnar format of TraceWriter
        */
       static void
-      Install (Ptr<Node> node, const std::string &file, Time averagingPeriod = Seconds (0.5));
+      Install (Ptr<Node> node, const std::string &file, Time averagingPeriod = Seconds (0.5),
+               TraceWriter::Format format = TraceWriter::TEXT);
 
       /**
        * @brief Explicit request to remove all statically created tracers
@@ -109,6 +155,22 @@ namespace ns3
       static Ptr<L3RateTracer>
       Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time averagingPeriod = Seconds (0.5));
 
+      /**
+       * @brief Helper method to install a tracer on a node, writing rows through a shared writer
+       *
+       * @param node Node on which to install tracer
+       * @param writer Writer, with the columns of AddColumns, shared by all the tracers of an output
+       * @param averagingPeriod How often data will be written into the trace file (default, every half second)
+       */
+      static Ptr<L3RateTracer>
+      Install (Ptr<Node> node, Ptr<TraceWriter> writer, Time averagingPeriod = Seconds (0.5));
+
+      /**
+       * @brief Declare the trace columns on writer
+       */
+      static void
+      AddColumns (TraceWriter &writer);
+
       // from L3Tracer
       virtual void
       PrintHeader (std::ostream &os) const;
@@ -248,15 +310,42 @@ namespace ns3
         void
         PeriodicPrinter ();
 
+        void
+        Write (TraceWriter &writer) const;
+
+        void
+        WriteRow (TraceWriter &writer, double time, int32_t faceId, const std::string &faceDescr,
+                  const char *name, uint32_t slot) const;
+
+        /**
+         * @brief Index of counter of face in the counter arrays, adding a row for new faces
+         */
+        uint32_t
+        Slot (Ptr<const Face> face, uint32_t counter);
+
+        template<class T>
+        void
+        Count (Ptr<const T> pdu, Ptr<const Face> face, uint32_t counter);
+
+        void
+        CountEntry (Ptr<const pit::Entry> entry, uint32_t inCounter, uint32_t outCounter);
+
         void
         Reset ();
 
     private:
-        boost::shared_ptr<std::ostream> m_os;
+        Ptr<TraceWriter> m_writer;
         Time m_period;
         EventId m_printEvent;
 
-        mutable std::map<Ptr<const Face>, boost::tuple<Stats, Stats, Stats, Stats> > m_stats;
+        // Counters are stored row by row, N_COUNTERS per row. Row 0 holds the
+        // node wide counters, row GetId () + 1 those of each face
+        std::vector<Ptr<const Face> > m_faces;    ///< @brief Face of each row
+        std::vector<double> m_packets;            ///< @brief Packets in the current period
+        std::vector<double> m_bytes;              ///< @brief Bytes in the current period
+        mutable std::vector<double> m_packetRate; ///< @brief Averaged packets per second
+        mutable std::vector<double> m_kbyteRate;  ///< @brief Averaged kilobytes per second
+        bool m_nodeStats;                         ///< @brief Node wide counters have been used
     };
 
   } /* namespace nnn */
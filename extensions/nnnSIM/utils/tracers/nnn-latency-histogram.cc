@@ -0,0 +1,125 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-latency-histogram.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-latency-histogram.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-latency-histogram.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-latency-histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    LatencyHistogram::LatencyHistogram ()
+    : m_count (0)
+    , m_sum (0)
+    , m_max (0)
+    {
+    }
+
+    uint32_t
+    LatencyHistogram::GetBucket (uint64_t value)
+    {
+      const uint64_t sub = 1 << SubBits;
+      if (value < sub)
+	return value;
+
+      // Index of the highest bit set, at least SubBits here
+      uint32_t msb = SubBits;
+      while ((value >> msb) > 1)
+	msb++;
+
+      uint32_t shift = msb - SubBits;
+      // (value >> shift) lies in [sub, 2 sub), continuing the linear buckets
+      return shift * sub + (value >> shift);
+    }
+
+    uint64_t
+    LatencyHistogram::GetUpperBound (uint32_t bucket)
+    {
+      const uint64_t sub = 1 << SubBits;
+      if (bucket < sub)
+	return bucket;
+
+      uint32_t shift = bucket / sub - 1;
+      uint64_t mantissa = bucket % sub + sub;
+      return ((mantissa + 1) << shift) - 1;
+    }
+
+    void
+    LatencyHistogram::Add (uint64_t value)
+    {
+      uint32_t bucket = GetBucket (value);
+      if (bucket >= m_buckets.size ())
+	m_buckets.resize (bucket + 1, 0);
+
+      m_buckets[bucket]++;
+      m_count++;
+      m_sum += value;
+      m_max = std::max (m_max, value);
+    }
+
+    void
+    LatencyHistogram::Reset ()
+    {
+      std::fill (m_buckets.begin (), m_buckets.end (), 0);
+      m_count = 0;
+      m_sum = 0;
+      m_max = 0;
+    }
+
+    uint64_t
+    LatencyHistogram::GetCount () const
+    {
+      return m_count;
+    }
+
+    double
+    LatencyHistogram::GetMean () const
+    {
+      return (m_count > 0) ? m_sum / m_count : 0;
+    }
+
+    uint64_t
+    LatencyHistogram::GetMax () const
+    {
+      return m_max;
+    }
+
+    uint64_t
+    LatencyHistogram::GetPercentile (double q) const
+    {
+      if (m_count == 0)
+	return 0;
+
+      uint64_t rank = static_cast<uint64_t> (std::ceil (q * m_count));
+      rank = std::max<uint64_t> (rank, 1);
+
+      uint64_t seen = 0;
+      for (uint32_t i = 0; i < m_buckets.size (); i++)
+	{
+	  seen += m_buckets[i];
+	  if (seen >= rank)
+	    return std::min (GetUpperBound (i), m_max);
+	}
+
+      return m_max;
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,89 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-latency-histogram.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-latency-histogram.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-latency-histogram.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_LATENCY_HISTOGRAM_H_
+#define NNN_LATENCY_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Log bucketed histogram of latencies in microseconds
+     *
+     * Values below 2^SubBits get a bucket each. Above that every power of
+     * two is split into 2^SubBits linear buckets, so a percentile is never
+     * more than 1/2^SubBits (about 3%) above the real value, whatever the
+     * range of the samples.
+     */
+    class LatencyHistogram
+    {
+    public:
+      static const uint32_t SubBits = 5;
+
+      LatencyHistogram ();
+
+      void
+      Add (uint64_t value);
+
+      /**
+       * @brief Forget all samples, keeping the allocated buckets
+       */
+      void
+      Reset ();
+
+      uint64_t
+      GetCount () const;
+
+      double
+      GetMean () const;
+
+      uint64_t
+      GetMax () const;
+
+      /**
+       * @brief Smallest value not exceeded by a fraction q of the samples
+       *
+       * The value returned is the upper bound of the bucket holding that
+       * sample, capped at the largest sample seen.
+       */
+      uint64_t
+      GetPercentile (double q) const;
+
+      static uint32_t
+      GetBucket (uint64_t value);
+
+      /**
+       * @brief Largest value that falls in bucket
+       */
+      static uint64_t
+      GetUpperBound (uint32_t bucket);
+
+    private:
+      std::vector<uint64_t> m_buckets;
+      uint64_t m_count;
+      double m_sum;
+      uint64_t m_max;
+    };
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_LATENCY_HISTOGRAM_H_ */
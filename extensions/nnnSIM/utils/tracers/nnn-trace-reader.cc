@@ -0,0 +1,241 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trace-reader.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trace-reader.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trace-reader.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-trace-reader.h"
+
+#include <cstring>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    template<class T>
+    static inline bool
+    Read (std::istream &is, T &value)
+    {
+      return is.read (reinterpret_cast<char *> (&value), sizeof (T)).good ();
+    }
+
+    TraceReader::TraceReader (std::istream &is)
+    : m_is (is)
+    , m_valid (false)
+    , m_rows (0)
+    , m_row (0)
+    {
+      char magic[4];
+      uint32_t version, ncols;
+
+      if (!m_is.read (magic, 4) || std::memcmp (magic, "3NTR", 4) != 0)
+	return;
+
+      if (!Read (m_is, version) || version != TraceWriter::Version || !Read (m_is, ncols))
+	return;
+
+      for (uint32_t i = 0; i < ncols; i++)
+	{
+	  uint8_t type;
+	  uint16_t len;
+	  if (!Read (m_is, type) || type > TraceWriter::STRING || !Read (m_is, len))
+	    return;
+
+	  std::string name (len, '\0');
+	  if (len > 0 && !m_is.read (&name[0], len))
+	    return;
+
+	  m_names.push_back (name);
+	  m_types.push_back (static_cast<TraceWriter::Type> (type));
+	}
+
+      m_strings.resize (ncols);
+      m_block.resize (ncols);
+      m_valid = true;
+    }
+
+    bool
+    TraceReader::IsValid () const
+    {
+      return m_valid;
+    }
+
+    uint32_t
+    TraceReader::GetNColumns () const
+    {
+      return m_names.size ();
+    }
+
+    const std::string &
+    TraceReader::GetColumnName (uint32_t column) const
+    {
+      return m_names[column];
+    }
+
+    TraceWriter::Type
+    TraceReader::GetColumnType (uint32_t column) const
+    {
+      return m_types[column];
+    }
+
+    int32_t
+    TraceReader::GetColumn (const std::string &name) const
+    {
+      for (uint32_t i = 0; i < m_names.size (); i++)
+	{
+	  if (m_names[i] == name)
+	    return i;
+	}
+      return -1;
+    }
+
+    bool
+    TraceReader::ReadBlock ()
+    {
+      char tag;
+      while (Read (m_is, tag))
+	{
+	  if (tag == 'S')
+	    {
+	      uint32_t column, id, len;
+	      if (!Read (m_is, column) || !Read (m_is, id) || !Read (m_is, len) || column >= m_strings.size ())
+		return false;
+
+	      std::string value (len, '\0');
+	      if (len > 0 && !m_is.read (&value[0], len))
+		return false;
+
+	      if (m_strings[column].size () <= id)
+		m_strings[column].resize (id + 1);
+	      m_strings[column][id] = value;
+	    }
+	  else if (tag == 'B')
+	    {
+	      if (!Read (m_is, m_rows))
+		return false;
+
+	      for (uint32_t i = 0; i < m_block.size (); i++)
+		{
+		  m_block[i].resize (m_rows * TraceWriter::GetWidth (m_types[i]));
+		  if (m_rows > 0 && !m_is.read (&m_block[i][0], m_block[i].size ()))
+		    return false;
+		}
+
+	      m_row = 0;
+	      if (m_rows > 0)
+		return true;
+	    }
+	  else
+	    return false;
+	}
+
+      return false;
+    }
+
+    bool
+    TraceReader::Next ()
+    {
+      if (!m_valid)
+	return false;
+
+      if (m_row + 1 < m_rows)
+	{
+	  m_row++;
+	  return true;
+	}
+
+      if (!ReadBlock ())
+	{
+	  m_valid = false;
+	  m_rows = 0;
+	  return false;
+	}
+
+      return true;
+    }
+
+    template<class T> T
+    TraceReader::Value (uint32_t column) const
+    {
+      T value;
+      std::memcpy (&value, &m_block[column][m_row * sizeof (T)], sizeof (T));
+      return value;
+    }
+
+    double
+    TraceReader::GetDouble (uint32_t column) const
+    {
+      return Value<double> (column);
+    }
+
+    int32_t
+    TraceReader::GetInt32 (uint32_t column) const
+    {
+      return Value<int32_t> (column);
+    }
+
+    uint32_t
+    TraceReader::GetUInt32 (uint32_t column) const
+    {
+      return Value<uint32_t> (column);
+    }
+
+    const std::string &
+    TraceReader::GetString (uint32_t column) const
+    {
+      return m_strings[column][Value<uint32_t> (column)];
+    }
+
+    void
+    TraceReader::PrintHeader (std::ostream &os) const
+    {
+      for (uint32_t i = 0; i < m_names.size (); i++)
+	{
+	  if (i > 0)
+	    os << "\t";
+	  os << m_names[i];
+	}
+      os << "\n";
+    }
+
+    void
+    TraceReader::PrintRow (std::ostream &os) const
+    {
+      for (uint32_t i = 0; i < m_types.size (); i++)
+	{
+	  if (i > 0)
+	    os << "\t";
+
+	  switch (m_types[i])
+	    {
+	    case TraceWriter::DOUBLE:
+	      os << GetDouble (i);
+	      break;
+	    case TraceWriter::INT32:
+	      os << GetInt32 (i);
+	      break;
+	    case TraceWriter::UINT32:
+	      os << GetUInt32 (i);
+	      break;
+	    case TraceWriter::STRING:
+	      os << GetString (i);
+	      break;
+	    }
+	}
+      os << "\n";
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
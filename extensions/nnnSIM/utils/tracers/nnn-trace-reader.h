@@ -0,0 +1,123 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trace-reader.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trace-reader.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trace-reader.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_TRACE_READER_H_
+#define NNN_TRACE_READER_H_
+
+#include "nnn-trace-writer.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Reads back the binary traces written by TraceWriter
+     *
+     * Usage:
+     *
+     *     std::ifstream in ("rate-trace.bin", std::ios_base::binary);
+     *     nnn::TraceReader reader (in);
+     *     while (reader.Next ())
+     *       total += reader.GetDouble (reader.GetColumn ("Packets"));
+     */
+    class TraceReader
+    {
+    public:
+      /**
+       * @brief Reads the header from is, check IsValid afterwards
+       */
+      TraceReader (std::istream &is);
+
+      /**
+       * @brief The stream holds a binary trace with a readable header
+       */
+      bool
+      IsValid () const;
+
+      uint32_t
+      GetNColumns () const;
+
+      const std::string &
+      GetColumnName (uint32_t column) const;
+
+      TraceWriter::Type
+      GetColumnType (uint32_t column) const;
+
+      /**
+       * @brief Index of the column called name, -1 if there is none
+       */
+      int32_t
+      GetColumn (const std::string &name) const;
+
+      /**
+       * @brief Move to the next row, false at the end of the trace
+       */
+      bool
+      Next ();
+
+      double
+      GetDouble (uint32_t column) const;
+
+      int32_t
+      GetInt32 (uint32_t column) const;
+
+      uint32_t
+      GetUInt32 (uint32_t column) const;
+
+      const std::string &
+      GetString (uint32_t column) const;
+
+      /**
+       * @brief Print the column names as the TEXT format header
+       */
+      void
+      PrintHeader (std::ostream &os) const;
+
+      /**
+       * @brief Print the current row as a TEXT format line
+       */
+      void
+      PrintRow (std::ostream &os) const;
+
+    private:
+      bool
+      ReadBlock ();
+
+      template<class T> T
+      Value (uint32_t column) const;
+
+    private:
+      std::istream &m_is;
+      bool m_valid;
+
+      std::vector<std::string> m_names;
+      std::vector<TraceWriter::Type> m_types;
+      std::vector<std::vector<std::string> > m_strings;   ///< @brief String ids, by column
+
+      std::vector<std::vector<char> > m_block;            ///< @brief Current block, by column
+      uint32_t m_rows;                                    ///< @brief Rows in the current block
+      uint32_t m_row;                                     ///< @brief Current row in the block
+    };
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TRACE_READER_H_ */
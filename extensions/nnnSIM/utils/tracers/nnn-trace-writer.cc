@@ -0,0 +1,274 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trace-writer.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trace-writer.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trace-writer.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-trace-writer.h"
+
+#include <ns3-dev/ns3/assert.h>
+#include <ns3-dev/ns3/log.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE ("nnn.TraceWriter");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    template<class T>
+    static inline void
+    NullDeleter (T *ptr)
+    {
+    }
+
+    template<class T>
+    static inline void
+    Append (std::vector<char> &buf, T value)
+    {
+      const char *bytes = reinterpret_cast<const char *> (&value);
+      buf.insert (buf.end (), bytes, bytes + sizeof (T));
+    }
+
+    boost::shared_ptr<std::ostream>
+    TraceWriter::Open (const std::string &file, Format format)
+    {
+      if (file == "-")
+	return boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+
+      boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+      std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+      if (format == BINARY)
+	mode |= std::ios_base::binary;
+
+      os->open (file.c_str (), mode);
+
+      if (!os->is_open ())
+	{
+	  NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+	  return boost::shared_ptr<std::ostream> ();
+	}
+
+      return os;
+    }
+
+    TraceWriter::TraceWriter (boost::shared_ptr<std::ostream> os, Format format, uint32_t blockRows)
+    : m_os (os)
+    , m_format (format)
+    , m_blockRows (blockRows)
+    , m_column (0)
+    , m_rows (0)
+    {
+    }
+
+    TraceWriter::~TraceWriter ()
+    {
+      Flush ();
+    }
+
+    TraceWriter::Format
+    TraceWriter::GetFormat () const
+    {
+      return m_format;
+    }
+
+    uint32_t
+    TraceWriter::GetWidth (Type type)
+    {
+      return (type == DOUBLE) ? 8 : 4;
+    }
+
+    void
+    TraceWriter::AddColumn (const std::string &name, Type type)
+    {
+      m_names.push_back (name);
+      m_types.push_back (type);
+      m_block.push_back (std::vector<char> ());
+      m_strings.push_back (std::map<std::string, uint32_t> ());
+    }
+
+    void
+    TraceWriter::WriteHeader ()
+    {
+      if (m_format == TEXT)
+	{
+	  for (uint32_t i = 0; i < m_names.size (); i++)
+	    {
+	      if (i > 0)
+		*m_os << "\t";
+	      *m_os << m_names[i];
+	    }
+	  *m_os << "\n";
+	  return;
+	}
+
+      std::vector<char> header;
+      header.insert (header.end (), "3NTR", "3NTR" + 4);
+      Append<uint32_t> (header, Version);
+      Append<uint32_t> (header, m_names.size ());
+      for (uint32_t i = 0; i < m_names.size (); i++)
+	{
+	  Append<uint8_t> (header, m_types[i]);
+	  Append<uint16_t> (header, m_names[i].size ());
+	  header.insert (header.end (), m_names[i].begin (), m_names[i].end ());
+	  m_block[i].reserve (m_blockRows * GetWidth (m_types[i]));
+	}
+
+      m_os->write (&header[0], header.size ());
+    }
+
+    void
+    TraceWriter::Put (const void *value, uint32_t size)
+    {
+      NS_ASSERT_MSG (m_column < m_types.size (), "Row has more values than columns");
+
+      const char *bytes = static_cast<const char *> (value);
+      m_block[m_column].insert (m_block[m_column].end (), bytes, bytes + size);
+      m_column++;
+    }
+
+    TraceWriter &
+    TraceWriter::Double (double value)
+    {
+      if (m_format == TEXT)
+	{
+	  if (m_column++ > 0)
+	    *m_os << "\t";
+	  *m_os << value;
+	}
+      else
+	Put (&value, sizeof (value));
+
+      return *this;
+    }
+
+    TraceWriter &
+    TraceWriter::Int32 (int32_t value)
+    {
+      if (m_format == TEXT)
+	{
+	  if (m_column++ > 0)
+	    *m_os << "\t";
+	  *m_os << value;
+	}
+      else
+	Put (&value, sizeof (value));
+
+      return *this;
+    }
+
+    TraceWriter &
+    TraceWriter::UInt32 (uint32_t value)
+    {
+      if (m_format == TEXT)
+	{
+	  if (m_column++ > 0)
+	    *m_os << "\t";
+	  *m_os << value;
+	}
+      else
+	Put (&value, sizeof (value));
+
+      return *this;
+    }
+
+    TraceWriter &
+    TraceWriter::String (const std::string &value)
+    {
+      if (m_format == TEXT)
+	{
+	  if (m_column++ > 0)
+	    *m_os << "\t";
+	  *m_os << value;
+	  return *this;
+	}
+
+      NS_ASSERT_MSG (m_column < m_types.size (), "Row has more values than columns");
+
+      std::map<std::string, uint32_t> &strings = m_strings[m_column];
+      std::map<std::string, uint32_t>::iterator it = strings.find (value);
+      if (it == strings.end ())
+	{
+	  uint32_t id = strings.size ();
+	  it = strings.insert (std::make_pair (value, id)).first;
+
+	  m_newStrings.push_back ('S');
+	  Append<uint32_t> (m_newStrings, m_column);
+	  Append<uint32_t> (m_newStrings, id);
+	  Append<uint32_t> (m_newStrings, value.size ());
+	  m_newStrings.insert (m_newStrings.end (), value.begin (), value.end ());
+	}
+
+      Put (&it->second, sizeof (uint32_t));
+      return *this;
+    }
+
+    void
+    TraceWriter::EndRow ()
+    {
+      if (m_format == TEXT)
+	{
+	  *m_os << "\n";
+	  m_column = 0;
+	  return;
+	}
+
+      NS_ASSERT_MSG (m_column == m_types.size (), "Row has fewer values than columns");
+      m_column = 0;
+
+      if (++m_rows == m_blockRows)
+	WriteBlock ();
+    }
+
+    void
+    TraceWriter::WriteBlock ()
+    {
+      if (m_rows == 0)
+	return;
+
+      if (!m_newStrings.empty ())
+	{
+	  m_os->write (&m_newStrings[0], m_newStrings.size ());
+	  m_newStrings.clear ();
+	}
+
+      std::vector<char> tag;
+      tag.push_back ('B');
+      Append<uint32_t> (tag, m_rows);
+      m_os->write (&tag[0], tag.size ());
+
+      for (uint32_t i = 0; i < m_block.size (); i++)
+	{
+	  m_os->write (&m_block[i][0], m_block[i].size ());
+	  m_block[i].clear ();
+	}
+
+      m_rows = 0;
+    }
+
+    void
+    TraceWriter::Flush ()
+    {
+      if (m_format == BINARY)
+	WriteBlock ();
+
+      m_os->flush ();
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
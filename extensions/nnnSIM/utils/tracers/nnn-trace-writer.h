@@ -0,0 +1,146 @@
+/* -*- Mode: C++; c-file-style: "gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trace-writer.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trace-writer.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trace-writer.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_TRACE_WRITER_H_
+#define NNN_TRACE_WRITER_H_
+
+#include <ns3-dev/ns3/simple-ref-count.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @brief Row writer shared by the tracers writing to the same output
+     *
+     * In TEXT mode rows are written as tab separated values, exactly as the
+     * tracers always did. In BINARY mode rows are gathered into blocks and
+     * written column by column:
+     *
+     *     header:  "3NTR" u32 version, u32 columns, then per column
+     *              u8 type, u16 name length, name
+     *     string:  'S' u32 column, u32 id, u32 length, bytes
+     *     block:   'B' u32 rows, then per column rows fixed width values
+     *
+     * Numbers are in host byte order. STRING columns hold u32 ids, each
+     * defined by a string record before the first block that uses it.
+     * TraceReader reads the binary format back.
+     */
+    class TraceWriter : public SimpleRefCount<TraceWriter>
+    {
+    public:
+      enum Format
+      {
+	TEXT = 0,
+	BINARY = 1
+      };
+
+      enum Type
+      {
+	DOUBLE = 0,   ///< @brief 8 bytes
+	INT32 = 1,    ///< @brief 4 bytes
+	UINT32 = 2,   ///< @brief 4 bytes
+	STRING = 3    ///< @brief 4 byte id into the column dictionary
+      };
+
+      static const uint32_t Version = 1;
+
+      /**
+       * @brief Open file for a trace in format, "-" meaning std::cout
+       *
+       * @returns empty pointer if the file cannot be opened
+       */
+      static boost::shared_ptr<std::ostream>
+      Open (const std::string &file, Format format);
+
+      TraceWriter (boost::shared_ptr<std::ostream> os, Format format = TEXT, uint32_t blockRows = 4096);
+
+      /**
+       * @brief Writes out any pending block
+       */
+      ~TraceWriter ();
+
+      Format
+      GetFormat () const;
+
+      /**
+       * @brief Add a column to the schema, only before WriteHeader
+       */
+      void
+      AddColumn (const std::string &name, Type type);
+
+      void
+      WriteHeader ();
+
+      TraceWriter &
+      Double (double value);
+
+      TraceWriter &
+      Int32 (int32_t value);
+
+      TraceWriter &
+      UInt32 (uint32_t value);
+
+      TraceWriter &
+      String (const std::string &value);
+
+      void
+      EndRow ();
+
+      /**
+       * @brief Write the pending block and flush the stream
+       */
+      void
+      Flush ();
+
+      static uint32_t
+      GetWidth (Type type);
+
+    private:
+      void
+      Put (const void *value, uint32_t size);
+
+      void
+      WriteBlock ();
+
+    private:
+      boost::shared_ptr<std::ostream> m_os;
+      Format m_format;
+      uint32_t m_blockRows;
+
+      std::vector<std::string> m_names;
+      std::vector<Type> m_types;
+
+      uint32_t m_column;        ///< @brief Next column of the current row
+      uint32_t m_rows;          ///< @brief Rows in the pending block
+
+      std::vector<std::vector<char> > m_block;                  ///< @brief Pending values, by column
+      std::vector<std::map<std::string, uint32_t> > m_strings;  ///< @brief String ids, by column
+      std::vector<char> m_newStrings;                           ///< @brief String records for the pending block
+    };
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TRACE_WRITER_H_ */
@@ -478,6 +478,18 @@ namespace ns3
 	  return key_;
 	}
 
+	iterator
+	parent ()
+	{
+	  return parent_;
+	}
+
+	const_iterator
+	parent () const
+	{
+	  return parent_;
+	}
+
 	inline void
 	PrintStat (std::ostream &os) const;
 
@@ -81,8 +81,6 @@ NS_LOG_COMPONENT_DEFINE (scenario);
 // Global information to use in callbacks
 std::map<int, Address> last_seen_mac;
 std::map<int, Address>::iterator last_seen_mac_it;
-std::map<int, std::string> last_seen_ssid;
-std::map<int, std::string>::iterator last_seen_ssid_it;
 
 // Number generator
 br::mt19937_64 gen;
@@ -103,85 +101,28 @@ double obtain_Num(double min, double max)
   return dist(gen);
 }
 
-// Function to change the SSID of a Node, depending on distance
-void SetSSIDviaDistance(uint32_t mtId, uint32_t netId, std::map<std::string, Ptr<MobilityModel> > aps, bool use3N)
+// Called by the WifiAssociationHelper whenever a mobile terminal changes AP
+void APChange (bool use3N, Ptr<Node> node, Ssid oldSsid, Ssid newSsid)
 {
-  NS_LOG_FUNCTION (mtId << netId);
-
-  char configbuf[250];
-  char buffer[250];
-
-  // Obtain the global list of Nodes in the simulation
-  NodeContainer global = NodeContainer::GetGlobal ();
-
-  Ptr<MobilityModel> nodeMM = global.Get (mtId)->GetObject<MobilityModel> ();
-  Ptr<nnn::ForwardingStrategy> nodeFW;
-
-  if (use3N)
-    nodeFW = global.Get (mtId)->GetObject<nnn::ForwardingStrategy> ();
+  NS_LOG_FUNCTION (node->GetId () << oldSsid << newSsid);
 
-  // This causes the device in mtId to change the SSID, forcing AP change
-  sprintf(configbuf, "/NodeList/%d/DeviceList/%d/$ns3::WifiNetDevice/Mac/Ssid", mtId, netId);
+  if (!use3N)
+    return;
 
-  std::map<double, std::string> SsidDistance;
+  Ptr<nnn::ForwardingStrategy> nodeFW = node->GetObject<nnn::ForwardingStrategy> ();
 
-  // Iterate through the map of seen Ssids
-  for (std::map<std::string, Ptr<MobilityModel> >::iterator ii=aps.begin(); ii!=aps.end(); ++ii)
+  if (oldSsid.IsBroadcast ())
     {
-      // Calculate the distance from the AP to the node and save into the map
-      SsidDistance[nodeMM->GetDistanceFrom((*ii).second)] = (*ii).first;
-    }
-
-  double distance = SsidDistance.begin()->first;
-  std::string ssid(SsidDistance.begin()->second);
-
-  sprintf(buffer, "Change to SSID %s at distance of %f", ssid.c_str(), distance);
-
-  NS_LOG_INFO(buffer);
-
-  // Search nodeNum in global map
-  last_seen_ssid_it = last_seen_ssid.find (mtId);
-
-  // Check to know what action the ForwardingStrategy for the node should do
-  if (last_seen_ssid_it != last_seen_ssid.end ())
-    {
-      // We know that we have connected somewhere before
-      if (last_seen_ssid[mtId] == ssid)
-	{
-	  NS_LOG_INFO ("Node " << mtId << " was already connected to AP with SSID " << ssid << ", no action taken");
-	  SsidDistance.clear ();
-	  return;
-	}
-      else
-	{
-	  NS_LOG_INFO ("Node " << mtId << " has changed AP to new " << ssid << " will disenroll");
-	  last_seen_ssid[mtId] = ssid;
-
-	  if (use3N)
-	    {
-	      // Force a disenroll procedure
-	      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Disenroll, nodeFW);
-	    }
-	}
+      NS_LOG_INFO ("First time Node " << node->GetId () << " sees an address, saving " << newSsid);
+      // Now continue to do the enroll procedure
+      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Enroll, nodeFW);
     }
   else
     {
-      NS_LOG_INFO ("First time Node " << mtId << " sees an address, saving " << ssid);
-      // Save the Address
-      last_seen_ssid[mtId] = ssid;
-
-      if (use3N)
-	{
-	  // Now continue to do the enroll procedure
-	  Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Enroll, nodeFW);
-	}
+      NS_LOG_INFO ("Node " << node->GetId () << " has changed AP to new " << newSsid << " will disenroll");
+      // Force a disenroll procedure
+      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Disenroll, nodeFW);
     }
-
-  // Because the map sorts by std:less, the first position has the lowest distance
-  Config::Set (configbuf, SsidValue (ssid));
-
-  // Empty the maps
-  SsidDistance.clear ();
 }
 
 // Function to force a change to a particular Ssid
@@ -888,22 +829,16 @@ int main (int argc, char *argv[])
 
   NS_LOG_INFO ("------Scheduling events - SSID changes------");
 
-  // Schedule AP Changes
-  double apsec = 0.0;
-  // How often should the AP check it's distance
-  double checkTime = 100.0 / speed;
-  double j = apsec;
+  // The helper checks each mobile terminal again only when its closest AP
+  // could have changed, and sets the SSID straight on the station MAC
+  Ptr<nnn::WifiAssociationHelper> apAssociation = CreateObject<nnn::WifiAssociationHelper> ();
 
-  while ( j < endTime)
-    {
-      for (int i = 0; i < mobile; i++)
-	{
-	  NS_LOG_INFO ("Scheduling SSID change for Node" << mobileNodeIds[i] << " at " << j);
-	  Simulator::Schedule (Seconds(j), &SetSSIDviaDistance, mobileNodeIds[i], 0, apTerminalMobility, use3N);
-	}
+  for (std::map<std::string, Ptr<MobilityModel> >::iterator it = apTerminalMobility.begin (); it != apTerminalMobility.end (); ++it)
+    apAssociation->AddAp (Ssid (it->first), it->second);
 
-      j += checkTime;
-    }
+  apAssociation->AddStations (wifiMTNetDevices);
+  apAssociation->TraceConnectWithoutContext ("Association", MakeBoundCallback (&APChange, use3N));
+  apAssociation->Start (Seconds (0));
 
   NS_LOG_INFO ("------Ready for execution!------");
 
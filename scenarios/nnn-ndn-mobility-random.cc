@@ -49,6 +49,7 @@
 #include <ns3-dev/ns3/csma-module.h>
 #include <ns3-dev/ns3/core-module.h>
 #include <ns3-dev/ns3/mobility-module.h>
+#include <ns3-dev/ns3/mpi-interface.h>
 #include <ns3-dev/ns3/network-module.h>
 #include <ns3-dev/ns3/point-to-point-module.h>
 #include <ns3-dev/ns3/wifi-module.h>
@@ -65,6 +66,7 @@
 #include "nnnSIM/utils/tracers/nnn-l3-rate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-l3-aggregate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-app-delay-tracer.h"
+#include "nnnSIM/utils/tracers/nnn-app-delay-histogram-tracer.h"
 
 using namespace ns3;
 using namespace boost;
@@ -84,8 +86,6 @@ NS_LOG_COMPONENT_DEFINE (scenario);
 // Global information to use in callbacks
 std::map<int, Address> last_seen_mac;
 std::map<int, Address>::iterator last_seen_mac_it;
-std::map<int, std::string> last_seen_ssid;
-std::map<int, std::string>::iterator last_seen_ssid_it;
 
 // Number generator
 br::mt19937_64 gen;
@@ -106,81 +106,40 @@ double obtain_Num(double min, double max)
   return dist(gen);
 }
 
-// Function to change the SSID of a Node, depending on distance
-void SetSSIDviaDistance(uint32_t mtId, uint32_t netId, std::map<std::string, Ptr<MobilityModel> > aps, bool use3N)
+// Nodes of c simulated by this rank, all of them when MPI is not enabled
+NodeContainer LocalNodes (const NodeContainer &c)
 {
-  NS_LOG_FUNCTION (mtId << netId);
-
-  char configbuf[250];
-  char buffer[250];
-
-  // Obtain the global list of Nodes in the simulation
-  NodeContainer global = NodeContainer::GetGlobal ();
-
-  Ptr<MobilityModel> nodeMM = global.Get (mtId)->GetObject<MobilityModel> ();
-  Ptr<nnn::ForwardingStrategy> nodeFW;
-
-  if (use3N)
-    nodeFW = global.Get (mtId)->GetObject<nnn::ForwardingStrategy> ();
-
-  // This causes the device in mtId to change the SSID, forcing AP change
-  sprintf(configbuf, "/NodeList/%d/DeviceList/%d/$ns3::WifiNetDevice/Mac/Ssid", mtId, netId);
-
-  std::map<double, std::string> SsidDistance;
-
-  // Iterate through the map of seen Ssids
-  for (std::map<std::string, Ptr<MobilityModel> >::iterator ii=aps.begin(); ii!=aps.end(); ++ii)
+  NodeContainer local;
+  for (uint32_t i = 0; i < c.GetN (); i++)
     {
-      // Calculate the distance from the AP to the node and save into the map
-      SsidDistance[nodeMM->GetDistanceFrom((*ii).second)] = (*ii).first;
+      if (c.Get (i)->GetSystemId () == MpiInterface::GetSystemId ())
+	local.Add (c.Get (i));
     }
+  return local;
+}
 
-  double distance = SsidDistance.begin()->first;
-  std::string ssid(SsidDistance.begin()->second);
-
-  sprintf(buffer, "Change to SSID %s at distance of %f", ssid.c_str(), distance);
+// Called by the WifiAssociationHelper whenever a mobile terminal changes AP
+void APChange (bool use3N, Ptr<Node> node, Ssid oldSsid, Ssid newSsid)
+{
+  NS_LOG_FUNCTION (node->GetId () << oldSsid << newSsid);
 
-  NS_LOG_INFO(buffer);
+  if (!use3N)
+    return;
 
-  // Search nodeNum in global map
-  last_seen_ssid_it = last_seen_ssid.find (mtId);
+  Ptr<nnn::ForwardingStrategy> nodeFW = node->GetObject<nnn::ForwardingStrategy> ();
 
-  // Check to know what action the ForwardingStrategy for the node should do
-  if (last_seen_ssid_it != last_seen_ssid.end ())
+  if (oldSsid.IsBroadcast ())
     {
-      // We know that we have connected somewhere before
-      if (last_seen_ssid[mtId] == ssid)
-	NS_LOG_INFO ("Node " << mtId << " was already connected to AP with SSID" << ssid);
-      else
-	{
-	  NS_LOG_INFO ("Node " << mtId << " has changed AP to new " << ssid << " will disenroll");
-	  last_seen_ssid[mtId] = ssid;
-
-	  if (use3N)
-	    {
-	      // Force a disenroll procedure
-	      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Disenroll, nodeFW);
-	    }
-	}
+      NS_LOG_INFO ("First time Node " << node->GetId () << " sees an address, saving " << newSsid);
+      // Now continue to do the enroll procedure
+      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Enroll, nodeFW);
     }
   else
     {
-      NS_LOG_INFO ("First time Node " << mtId << " sees an address, saving " << ssid);
-      // Save the Address
-      last_seen_ssid[mtId] = ssid;
-
-      if (use3N)
-	{
-	  // Now continue to do the enroll procedure
-	  Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Enroll, nodeFW);
-	}
+      NS_LOG_INFO ("Node " << node->GetId () << " has changed AP to new " << newSsid << " will disenroll");
+      // Force a disenroll procedure
+      Simulator::Schedule (Seconds (0), &nnn::ForwardingStrategy::Disenroll, nodeFW);
     }
-
-  // Because the map sorts by std:less, the first position has the lowest distance
-  Config::Set (configbuf, SsidValue (ssid));
-
-  // Empty the maps
-  SsidDistance.clear ();
 }
 
 // Function to force a change to a particular Ssid
@@ -299,6 +258,7 @@ int main (int argc, char *argv[])
   char nsTDir[250] = "./Waypoints";           // Directory for the waypoint files
   bool use3N = false;
   bool useNDN = false;
+  bool distributed = false;                     // Split the topology across MPI ranks
 
   // Variable for buffer
   char buffer[250];
@@ -322,8 +282,15 @@ int main (int argc, char *argv[])
   cmd.AddValue ("traceFile", "Directory containing Ns2 movement trace files (Usually created by Bonnmotion)", nsTDir);
   cmd.AddValue ("3n", "Uses 3N scenario", use3N);
   cmd.AddValue ("useNDN", "Uses NDN scenario", useNDN);
+  cmd.AddValue ("distributed", "Split the topology across the MPI ranks", distributed);
   cmd.Parse (argc,argv);
 
+  if (distributed)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+      MpiInterface::Enable (&argc, &argv);
+    }
+
   if (! (car || walk))
     {
       cerr << "ERROR: Must choose a speed for random walk!" << endl;
@@ -506,10 +473,63 @@ int main (int argc, char *argv[])
       }
   }
 
+  // Find out how many first level nodes we will have
+  // The +1 is for the server which will be attached to the first level nodes
+  int first = (sectors / 3) + 1;
+
   NS_LOG_INFO ("------Creating nodes------");
+  // Nodes are created in the order mobile terminals, central nodes,
+  // wireless access nodes, first level nodes and servers. The ns-2 trace
+  // relies on the mobile terminals being the first nodes
+  NodeContainer allNodes;
+
+  if (distributed)
+    {
+      // Describe the topology, so every node is created on its rank
+      nnn::PartitionHelper partition;
+      uint32_t mobileIdx = partition.AddNodes (mobile);
+      uint32_t centralIdx = partition.AddNodes (sectors);
+      uint32_t wirelessIdx = partition.AddNodes (wnodes);
+      uint32_t firstIdx = partition.AddNodes (first);
+      uint32_t serverIdx = partition.AddNodes (servers);
+
+      for (int i = 0; i < sectors; i++)
+	for (int j = 0; j < aps; j++)
+	  partition.AddLink (centralIdx + i, wirelessIdx + i*aps + j, MilliSeconds (1));
+
+      partition.AddLink (serverIdx, firstIdx + first - 1, MilliSeconds (1));
+
+      for (int i = 0; i < first-1; i++)
+	for (int j = i; j < sectors; j+=(first-1))
+	  partition.AddLink (firstIdx + i, centralIdx + j, MilliSeconds (2));
+
+      for (int i = 0; i < first; i++)
+	for (int j = i+1; j < first; j++)
+	  partition.AddLink (firstIdx + i, firstIdx + j, MilliSeconds (2));
+
+      // All the APs and mobile terminals share one Wifi channel, which
+      // can't be split across ranks
+      std::vector<uint32_t> wifiNodes;
+      for (int i = 0; i < mobile; i++)
+	wifiNodes.push_back (mobileIdx + i);
+      for (int i = 0; i < wnodes; i++)
+	wifiNodes.push_back (wirelessIdx + i);
+      partition.Group (wifiNodes);
+
+      partition.Partition ();
+      NS_LOG_INFO (partition);
+
+      allNodes = partition.Create ();
+    }
+  else
+    allNodes.Create (mobile + sectors + wnodes + first + servers);
+
+  uint32_t next = 0;
+
   // Node definitions for mobile terminals (consumers)
   NodeContainer mobileTerminalContainer;
-  mobileTerminalContainer.Create(mobile);
+  for (int i = 0; i < mobile; i++)
+    mobileTerminalContainer.Add (allNodes.Get (next++));
 
   std::vector<uint32_t> mobileNodeIds;
 
@@ -521,11 +541,13 @@ int main (int argc, char *argv[])
 
   // Central Nodes
   NodeContainer centralContainer;
-  centralContainer.Create (sectors);
+  for (int i = 0; i < sectors; i++)
+    centralContainer.Add (allNodes.Get (next++));
 
   // Wireless access Nodes
   NodeContainer wirelessContainer;
-  wirelessContainer.Create (wnodes);
+  for (int i = 0; i < wnodes; i++)
+    wirelessContainer.Add (allNodes.Get (next++));
 
   // Separate the wireless nodes into sector specific containers
   std::vector<NodeContainer> sectorNodes;
@@ -540,13 +562,10 @@ int main (int argc, char *argv[])
       sectorNodes.push_back(wireless);
     }
 
-  // Find out how many first level nodes we will have
-  // The +1 is for the server which will be attached to the first level nodes
-  int first = (sectors / 3) + 1;
-
   // First level Nodes
   NodeContainer firstLevel;
-  firstLevel.Create (first);
+  for (int i = 0; i < first; i++)
+    firstLevel.Add (allNodes.Get (next++));
 
   // Container for all NDN capable nodes
   NodeContainer allNdnNodes;
@@ -561,7 +580,8 @@ int main (int argc, char *argv[])
 
   // Container for server (producer) nodes
   NodeContainer serverNodes;
-  serverNodes.Create (servers);
+  for (int i = 0; i < servers; i++)
+    serverNodes.Add (allNodes.Get (next++));
 
   std::vector<uint32_t> serverNodeIds;
 
@@ -801,7 +821,7 @@ int main (int argc, char *argv[])
       producerHelper.SetAttribute ("StopTime", TimeValue (Seconds(endTime-1)));
       // Payload size is in bytes
       producerHelper.SetAttribute ("PayloadSize", UintegerValue(payLoadsize));
-      producerHelper.Install (serverNodes);
+      producerHelper.Install (LocalNodes (serverNodes));
 
       NS_LOG_INFO ("------Installing NDN Consumer Application------");
 
@@ -817,7 +837,7 @@ int main (int argc, char *argv[])
       if (maxSeq > 0)
 	consumerHelper.SetAttribute ("MaxSeq", IntegerValue(maxSeq));
 
-      consumerHelper.Install (mobileTerminalContainer);
+      consumerHelper.Install (LocalNodes (mobileTerminalContainer));
     }
 
   if (use3N)
@@ -884,7 +904,9 @@ int main (int argc, char *argv[])
 
       for (int i = 0; i < allNdnNodes.GetN () ; i++)
 	{
-	  Simulator::Schedule(Seconds (0), &nnn::ForwardingStrategy::Enroll, fwAPs[i]);
+	  // Each rank only enrolls the nodes it simulates
+	  if (allNdnNodes.Get (i)->GetSystemId () == MpiInterface::GetSystemId ())
+	    Simulator::Schedule(Seconds (0), &nnn::ForwardingStrategy::Enroll, fwAPs[i]);
 	}
 
       ///////////////////////////////////////////////////////
@@ -913,7 +935,7 @@ int main (int argc, char *argv[])
       producerHelper.SetAttribute("StartTime", TimeValue (Seconds(2)));
       producerHelper.SetAttribute("StopTime", TimeValue (Seconds(endTime -1)));
       // Install producer on AP
-      producerHelper.Install (serverNodes);
+      producerHelper.Install (LocalNodes (serverNodes));
 
       NS_LOG_INFO ("------ Installing 3N Consumer Application------ ");
       NS_LOG_INFO ("Consumer Interests/Second frequency: " << intFreq);
@@ -926,7 +948,7 @@ int main (int argc, char *argv[])
       consumerHelper.SetAttribute("StopTime", TimeValue (Seconds(endTime-1)));
       consumerHelper.SetAttribute ("RetxTimer", TimeValue (Seconds(retxtime)));
       consumerHelper.SetAttribute("IsMobile", BooleanValue(true));
-      consumerHelper.Install (mobileTerminalContainer);
+      consumerHelper.Install (LocalNodes (mobileTerminalContainer));
     }
 
   NS_LOG_INFO("Ending time! " <<  endTime);
@@ -999,6 +1021,10 @@ int main (int argc, char *argv[])
 	  sprintf (filename, "%s/%s-app-delays-%s", results, scenario, fileId);
 	  nnn::AppDelayTracer::InstallAll (filename);
 
+	  // 3N App delay percentiles
+	  sprintf (filename, "%s/%s-app-delay-summary-%s", results, scenario, fileId);
+	  nnn::AppDelayHistogramTracer::InstallAll (filename, Seconds (1.0));
+
 	  // 3N Aggregate tracer
 	  sprintf (filename, "%s/%s-aggregate-trace-%s", results, scenario, fileId);
 	  nnn::L3AggregateTracer::InstallAll(filename, Seconds (1.0));
@@ -1029,26 +1055,23 @@ int main (int argc, char *argv[])
 
   NS_LOG_INFO ("------Scheduling events - SSID changes------");
 
-  // Schedule AP Changes
-  double apsec = 0.0;
-  // How often should the AP check it's distance
-  double checkTime = 100.0 / finalspeed;
-  double j = apsec;
+  // The mobile terminals follow the ns-2 trace, so the helper works out
+  // every handoff up front and schedules exactly one event for each
+  Ptr<nnn::WifiAssociationHelper> apAssociation = CreateObject<nnn::WifiAssociationHelper> ();
 
-  while ( j < endTime)
-    {
-      for (int i = 0; i < mobile; i++)
-	{
-	  NS_LOG_INFO ("Scheduling SSID change for Node" << mobileNodeIds[i] << " at " << j);
-	  Simulator::Schedule (Seconds(j), &SetSSIDviaDistance, mobileNodeIds[i], 0, apTerminalMobility, use3N);
-	}
+  for (std::map<std::string, Ptr<MobilityModel> >::iterator it = apTerminalMobility.begin (); it != apTerminalMobility.end (); ++it)
+    apAssociation->AddAp (Ssid (it->first), it->second);
 
-      j += checkTime;
-    }
+  apAssociation->AddStations (wifiMTNetDevices);
+  apAssociation->TraceConnectWithoutContext ("Association", MakeBoundCallback (&APChange, use3N));
+  apAssociation->StartFromNs2Trace (nsTFile, Seconds (0), Seconds (endTime));
 
   NS_LOG_INFO ("------Ready for execution!------");
 
   Simulator::Stop (Seconds (endTime));
   Simulator::Run ();
   Simulator::Destroy ();
+
+  if (distributed)
+    MpiInterface::Disable ();
 }
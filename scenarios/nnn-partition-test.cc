@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-partition-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-partition-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-partition-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+
+#include <iostream>
+
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+#include <ns3-dev/ns3/mpi-interface.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t crossed = 0;
+
+// Receives the packets sent over the cut link
+bool ReceiveAcross (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  std::cout << "Rank " << MpiInterface::GetSystemId () << " node " << device->GetNode ()->GetId ()
+      << " received " << packet->GetSize () << " bytes over a cut link at "
+      << Simulator::Now ().GetSeconds () << "s" << std::endl;
+  crossed++;
+  return true;
+}
+
+void SendAcross (Ptr<NetDevice> device, Address to)
+{
+  device->Send (Create<Packet> (100), to, 0x0800);
+}
+
+// Partitions a grid of routers, with one row of long links and a Wi-Fi
+// sector hanging off the first router. With --ranks=N only the partition
+// is printed, under mpirun -np N with --distributed the topology is created
+// across the N ranks and both ends of a cut link send each other a packet
+int main (int argc, char *argv[])
+{
+  uint32_t width = 20;
+  uint32_t height = 20;
+  uint32_t mobile = 10;
+  uint32_t ranks = 1;
+  bool distributed = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("width", "Routers in each row of the grid", width);
+  cmd.AddValue ("height", "Routers in each column of the grid", height);
+  cmd.AddValue ("mobile", "Mobile terminals in the Wi-Fi sector", mobile);
+  cmd.AddValue ("ranks", "Ranks to partition for, when not distributed", ranks);
+  cmd.AddValue ("distributed", "Create the topology across the MPI ranks", distributed);
+  cmd.Parse (argc, argv);
+
+  if (distributed)
+    {
+      // Without the distributed simulator, packets leaving through remote
+      // channels are never received by the other rank
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+      MpiInterface::Enable (&argc, &argv);
+    }
+
+  PartitionHelper partition;
+  uint32_t first = partition.AddNodes (width * height);
+
+  for (uint32_t y = 0; y < height; y++)
+    {
+      for (uint32_t x = 0; x < width; x++)
+	{
+	  uint32_t node = first + y * width + x;
+	  if (x + 1 < width)
+	    partition.AddLink (node, node + 1, MilliSeconds (5));
+	  // The middle row is joined by slower links, the cheapest to cut
+	  if (y + 1 < height)
+	    partition.AddLink (node, node + width, MilliSeconds ((y == height / 2 - 1) ? 20 : 5));
+	}
+    }
+
+  std::vector<uint32_t> sector;
+  sector.push_back (first);
+  for (uint32_t i = 0; i < mobile; i++)
+    sector.push_back (partition.AddNode ());
+  partition.Group (sector);
+
+  if (distributed)
+    partition.Partition ();
+  else
+    partition.Partition (ranks);
+
+  std::cout << partition;
+
+  for (uint32_t i = 1; i < sector.size (); i++)
+    {
+      if (partition.GetSystemId (sector[i]) != partition.GetSystemId (first))
+	std::cout << "Mobile " << sector[i] << " is not on the rank of its AP!" << std::endl;
+    }
+
+  if (!distributed)
+    return 0;
+
+  NodeContainer nodes = partition.Create ();
+
+  FlexPointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  NetDeviceContainer devices = partition.InstallLinks (p2p, nodes);
+
+  uint32_t rank = MpiInterface::GetSystemId ();
+  std::cout << "Rank " << rank << " installed " << devices.GetN () << " devices" << std::endl;
+
+  // InstallLinks adds the two devices of each link in turn
+  for (uint32_t i = 0; i + 1 < devices.GetN (); i += 2)
+    {
+      Ptr<NetDevice> ends[2] = { devices.Get (i), devices.Get (i + 1) };
+      if (ends[0]->GetNode ()->GetSystemId () == ends[1]->GetNode ()->GetSystemId ())
+	continue;
+
+      for (uint32_t e = 0; e < 2; e++)
+	{
+	  Ptr<Node> node = ends[e]->GetNode ();
+	  if (node->GetSystemId () != rank)
+	    continue;
+
+	  ends[e]->SetReceiveCallback (MakeCallback (&ReceiveAcross));
+	  Simulator::ScheduleWithContext (node->GetId (), MilliSeconds (100), &SendAcross,
+	                                  ends[e], ends[1 - e]->GetAddress ());
+	}
+      break;
+    }
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::cout << "Rank " << rank << " received " << crossed << " packet(s) from other ranks" << std::endl;
+
+  MpiInterface::Disable ();
+}
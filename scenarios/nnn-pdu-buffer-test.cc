@@ -68,6 +68,50 @@ void dealQueue (Ptr<PDUBuffer> buf, NNNAddress &addr)
     }
 }
 
+std::map<std::string, uint32_t> drops;
+
+void countDrop (std::string policy, Ptr<const Packet> pdu, const NNNAddress &addr)
+{
+  std::cout << policy << " dropped PDU for " << addr << " at " << Simulator::Now () << std::endl;
+  drops[policy]++;
+}
+
+void reportPolicy (Ptr<PDUBuffer> buf, std::string policy, Ptr<NNNAddress> first, Ptr<NNNAddress> second)
+{
+  std::cout << policy << ": " << *first << " holds " << buf->QueueSize (first) << ", "
+      << *second << " holds " << buf->QueueSize (second) << ", "
+      << drops[policy] << " drop(s)" << std::endl;
+}
+
+void pushDU (Ptr<PDUBuffer> buf, Ptr<NNNAddress> addr, Ptr<nnn::DU> du)
+{
+  buf->PushDU (addr, du);
+}
+
+void pushDO (Ptr<PDUBuffer> buf, Ptr<NNNAddress> addr, Ptr<nnn::DO> do_p)
+{
+  buf->PushDO (addr, do_p);
+}
+
+// Fill a two PDU buffer with a DU for first, then two DOs for second
+void checkPolicy (Time start, PDUBuffer::DropPolicy policy, std::string name,
+                  Ptr<NNNAddress> first, Ptr<NNNAddress> second,
+                  Ptr<nnn::DU> du, Ptr<nnn::DO> do_p)
+{
+  Ptr<PDUBuffer> buf = Create<PDUBuffer> ();
+  buf->SetAttribute ("MaxTotalPackets", UintegerValue (2));
+  buf->SetAttribute ("DropPolicy", EnumValue (policy));
+  buf->TraceConnect ("Drop", name, MakeCallback (&countDrop));
+
+  buf->AddDestination (first);
+  buf->AddDestination (second);
+
+  Simulator::Schedule (start, &pushDU, buf, first, du);
+  Simulator::Schedule (start + MilliSeconds (1), &pushDO, buf, second, do_p);
+  Simulator::Schedule (start + MilliSeconds (2), &pushDO, buf, second, do_p);
+  Simulator::Schedule (start + MilliSeconds (3), &reportPolicy, buf, name, first, second);
+}
+
 int main (int argc, char *argv[])
 {
 
@@ -174,6 +218,12 @@ int main (int argc, char *argv[])
 
   Simulator::Schedule(MilliSeconds (60), &dealQueue, buf, *addr);
 
+  // Once full, DropTail keeps 1/1, DropHead keeps 1/1 with the newest DO
+  // and DropOldestExpired evicts the DU for 0/2, each with a single drop
+  checkPolicy (MilliSeconds (100), PDUBuffer::DROP_TAIL, "DropTail", addr, addr2, source8, source2);
+  checkPolicy (MilliSeconds (200), PDUBuffer::DROP_HEAD, "DropHead", addr, addr2, source8, source2);
+  checkPolicy (MilliSeconds (300), PDUBuffer::DROP_OLDEST_EXPIRED, "DropOldestExpired", addr, addr2, source8, source2);
+
   Simulator::Stop (Seconds (20));
   Simulator::Run ();
   Simulator::Destroy ();
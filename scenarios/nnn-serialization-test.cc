@@ -210,4 +210,45 @@ int main (int argc, char *argv[])
   Ptr<nnn::OEN> target9 = wire::nnnSIM::OEN::FromWire(packet);
 
   std::cout << std::endl << "After" << std::endl << *target9 << std::endl;
+
+  // Test lifetime patching of an already encoded DU
+  target8->SetLifetime(release);
+
+  std::cout << std::endl << "Before" << std::endl << *target8 << std::endl;
+
+  packet = wire::nnnSIM::DU::ToWire(target8);
+
+  Ptr<nnn::DU> target10 = wire::nnnSIM::DU::FromWire(packet);
+
+  std::cout << std::endl << "After lifetime patch" << std::endl << *target10 << std::endl;
+
+  // Test the compact format, sources keep their nnnSIM encoding as the
+  // cached wire, so these encode them again
+  Ptr<Packet> nnnsim = wire::nnnSIM::AEN::ToWire(source1);
+  packet = wire::compact::AEN::ToWire(source1);
+
+  std::cout << std::endl << "AEN nnnSIM " << nnnsim->GetSize () << " bytes, compact " << packet->GetSize () << " bytes" << std::endl;
+
+  // The format is detected from the first byte
+  WirePDU pdu = Wire::ToPDU(packet);
+
+  std::cout << "After compact (format " << static_cast<int> (HeaderHelper::GetWireFormat (packet)) << ")" << std::endl << *pdu.Get<nnn::AEN> () << std::endl;
+
+  nnnsim = wire::nnnSIM::OEN::ToWire(source9);
+  packet = wire::compact::OEN::ToWire(source9);
+
+  std::cout << std::endl << "OEN nnnSIM " << nnnsim->GetSize () << " bytes, compact " << packet->GetSize () << " bytes" << std::endl;
+
+  pdu = Wire::ToPDU(packet);
+
+  std::cout << "After compact" << std::endl << *pdu.Get<nnn::OEN> () << std::endl;
+
+  nnnsim = wire::nnnSIM::DU::ToWire(source8);
+  packet = wire::compact::DU::ToWire(source8);
+
+  std::cout << std::endl << "DU nnnSIM " << nnnsim->GetSize () << " bytes, compact " << packet->GetSize () << " bytes" << std::endl;
+
+  pdu = Wire::ToPDU(packet);
+
+  std::cout << "After compact" << std::endl << *pdu.Get<nnn::DU> () << std::endl;
 }
@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trace2tsv.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trace2tsv.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trace2tsv.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Converts a binary trace written by the 3N tracers into the tab separated
+ *  text they write by default, so the R scripts in graphs/ can read it.
+ *
+ *  Usage: nnn-trace2tsv <binary trace> [<output file, - for stdout>]
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "nnnSIM/utils/tracers/nnn-trace-reader.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  if (argc < 2 || argc > 3)
+    {
+      std::cerr << "Usage: " << argv[0] << " <binary trace> [<output file, - for stdout>]" << std::endl;
+      return 1;
+    }
+
+  std::ifstream in (argv[1], std::ios_base::in | std::ios_base::binary);
+  if (!in.is_open ())
+    {
+      std::cerr << "ERROR: Cannot open " << argv[1] << std::endl;
+      return 1;
+    }
+
+  nnn::TraceReader reader (in);
+  if (!reader.IsValid ())
+    {
+      std::cerr << "ERROR: " << argv[1] << " is not a binary 3N trace" << std::endl;
+      return 1;
+    }
+
+  std::ofstream file;
+  std::ostream *out = &std::cout;
+  if (argc == 3 && std::string (argv[2]) != "-")
+    {
+      file.open (argv[2], std::ios_base::out | std::ios_base::trunc);
+      if (!file.is_open ())
+	{
+	  std::cerr << "ERROR: Cannot open " << argv[2] << " for writing" << std::endl;
+	  return 1;
+	}
+      out = &file;
+    }
+
+  reader.PrintHeader (*out);
+  while (reader.Next ())
+    reader.PrintRow (*out);
+
+  return 0;
+}